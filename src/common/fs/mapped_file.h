@@ -0,0 +1,87 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <filesystem>
+#include <span>
+
+#include "common/common_types.h"
+
+namespace Common::FS {
+
+/**
+ * A read-only view of an entire file mapped into the address space of the process.
+ * The view is shared with the page cache: writes made to the file through other handles show up
+ * in it, and accessing pages past the end of a file truncated by someone else raises SIGBUS on
+ * POSIX systems. Only map files that are not modified while mapped, replacing a file by renaming
+ * another one over it is safe. Empty files and files that cannot be mapped produce a closed
+ * object.
+ */
+class MappedFile final {
+public:
+    MappedFile();
+
+    /**
+     * Maps the file at path for reading.
+     *
+     * @param path Filesystem path
+     */
+    explicit MappedFile(const std::filesystem::path& path);
+
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    /**
+     * Maps the file at path for reading, closing any previous mapping first.
+     *
+     * @param path Filesystem path
+     *
+     * @returns True if the file was successfully mapped, false otherwise.
+     */
+    bool Open(const std::filesystem::path& path);
+
+    /// Unmaps the file if it is mapped.
+    void Close();
+
+    /**
+     * Checks whether the file is mapped.
+     *
+     * @returns True if the file is mapped, false otherwise.
+     */
+    [[nodiscard]] bool IsOpen() const {
+        return base != nullptr;
+    }
+
+    /**
+     * Gets the contents of the mapped file.
+     *
+     * @returns A span over the mapped contents, empty when the file is not mapped.
+     */
+    [[nodiscard]] std::span<const u8> Data() const {
+        return {base, size};
+    }
+
+    /**
+     * Gets the size of the mapped file.
+     *
+     * @returns The size of the mapped file in bytes.
+     */
+    [[nodiscard]] size_t Size() const {
+        return size;
+    }
+
+private:
+    const u8* base{};
+    size_t size{};
+#ifdef _WIN32
+    void* mapping_handle{};
+#endif
+};
+
+} // namespace Common::FS
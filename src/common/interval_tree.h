@@ -0,0 +1,217 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <algorithm>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "common/common_types.h"
+
+namespace Common {
+
+/**
+ * Set of possibly overlapping half open intervals [begin, end), each tagged with a value.
+ * Implemented as a treap ordered by interval begin and augmented with the largest end of each
+ * subtree, so overlap queries cost O(log n + k) regardless of the size of the intervals.
+ * Intervals sharing the same begin are visited in insertion order.
+ * The tree must not be modified from the callback of ForEachOverlapping.
+ */
+template <typename AddressType, typename ValueType>
+class IntervalTree {
+public:
+    void Insert(AddressType begin, AddressType end, ValueType value) {
+        const u32 node = AllocateNode(begin, end, value);
+        auto [left, right] = Split(root, begin);
+        root = Merge(Merge(left, node), right);
+        ++num_intervals;
+    }
+
+    /// Removes the interval starting at begin tagged with value, returns false if not found.
+    bool Erase(AddressType begin, ValueType value) {
+        if (!EraseImpl(root, begin, value)) {
+            return false;
+        }
+        --num_intervals;
+        return true;
+    }
+
+    /**
+     * Invokes func(value) for every interval overlapping [begin, end) in order of their begin.
+     * When func returns bool, returning true stops the iteration.
+     */
+    template <typename Func>
+    void ForEachOverlapping(AddressType begin, AddressType end, Func&& func) const {
+        ForEachOverlappingImpl(root, begin, end, func);
+    }
+
+    void Clear() {
+        nodes.clear();
+        free_nodes.clear();
+        root = NULL_NODE;
+        num_intervals = 0;
+    }
+
+    [[nodiscard]] size_t Size() const noexcept {
+        return num_intervals;
+    }
+
+    [[nodiscard]] bool Empty() const noexcept {
+        return num_intervals == 0;
+    }
+
+private:
+    static constexpr u32 NULL_NODE = ~u32{};
+
+    struct Node {
+        AddressType begin;
+        AddressType end;
+        AddressType max_end;
+        ValueType value;
+        u32 priority;
+        u32 left;
+        u32 right;
+    };
+
+    u32 AllocateNode(AddressType begin, AddressType end, ValueType value) {
+        const Node node{
+            .begin = begin,
+            .end = end,
+            .max_end = end,
+            .value = value,
+            .priority = NextPriority(),
+            .left = NULL_NODE,
+            .right = NULL_NODE,
+        };
+        if (free_nodes.empty()) {
+            nodes.push_back(node);
+            return static_cast<u32>(nodes.size() - 1);
+        }
+        const u32 index = free_nodes.back();
+        free_nodes.pop_back();
+        nodes[index] = node;
+        return index;
+    }
+
+    u32 NextPriority() noexcept {
+        // Xorshift32, the priorities only have to be well distributed
+        random_state ^= random_state << 13;
+        random_state ^= random_state >> 17;
+        random_state ^= random_state << 5;
+        return random_state;
+    }
+
+    void Update(u32 index) noexcept {
+        Node& node = nodes[index];
+        node.max_end = node.end;
+        if (node.left != NULL_NODE) {
+            node.max_end = std::max(node.max_end, nodes[node.left].max_end);
+        }
+        if (node.right != NULL_NODE) {
+            node.max_end = std::max(node.max_end, nodes[node.right].max_end);
+        }
+    }
+
+    /// Splits the tree into the nodes beginning at or before begin and the ones after it.
+    std::pair<u32, u32> Split(u32 index, AddressType begin) {
+        if (index == NULL_NODE) {
+            return {NULL_NODE, NULL_NODE};
+        }
+        Node& node = nodes[index];
+        if (node.begin <= begin) {
+            const auto [left, right] = Split(node.right, begin);
+            nodes[index].right = left;
+            Update(index);
+            return {index, right};
+        }
+        const auto [left, right] = Split(node.left, begin);
+        nodes[index].left = right;
+        Update(index);
+        return {left, index};
+    }
+
+    /// Merges two trees, all the nodes of left must be ordered before the nodes of right.
+    u32 Merge(u32 left, u32 right) {
+        if (left == NULL_NODE) {
+            return right;
+        }
+        if (right == NULL_NODE) {
+            return left;
+        }
+        if (nodes[left].priority > nodes[right].priority) {
+            const u32 merged = Merge(nodes[left].right, right);
+            nodes[left].right = merged;
+            Update(left);
+            return left;
+        }
+        const u32 merged = Merge(left, nodes[right].left);
+        nodes[right].left = merged;
+        Update(right);
+        return right;
+    }
+
+    bool EraseImpl(u32& index, AddressType begin, const ValueType& value) {
+        if (index == NULL_NODE) {
+            return false;
+        }
+        Node& node = nodes[index];
+        bool is_erased = false;
+        if (begin < node.begin) {
+            is_erased = EraseImpl(node.left, begin, value);
+        } else if (begin > node.begin) {
+            is_erased = EraseImpl(node.right, begin, value);
+        } else if (node.value == value) {
+            free_nodes.push_back(index);
+            index = Merge(node.left, node.right);
+            return true;
+        } else {
+            // Intervals with the same begin may be on either side
+            is_erased = EraseImpl(node.left, begin, value) || EraseImpl(node.right, begin, value);
+        }
+        if (is_erased) {
+            Update(index);
+        }
+        return is_erased;
+    }
+
+    template <typename Func>
+    bool ForEachOverlappingImpl(u32 index, AddressType begin, AddressType end, Func& func) const {
+        using FuncReturn = std::invoke_result_t<Func, ValueType>;
+        static constexpr bool BOOL_BREAK = std::is_same_v<FuncReturn, bool>;
+        if (index == NULL_NODE) {
+            return false;
+        }
+        const Node& node = nodes[index];
+        if (node.max_end <= begin) {
+            // Nothing in this subtree reaches the queried range
+            return false;
+        }
+        if (ForEachOverlappingImpl(node.left, begin, end, func)) {
+            return true;
+        }
+        if (node.begin >= end) {
+            // This node and its right subtree begin after the queried range
+            return false;
+        }
+        if (node.end > begin) {
+            if constexpr (BOOL_BREAK) {
+                if (func(node.value)) {
+                    return true;
+                }
+            } else {
+                func(node.value);
+            }
+        }
+        return ForEachOverlappingImpl(node.right, begin, end, func);
+    }
+
+    std::vector<Node> nodes;
+    std::vector<u32> free_nodes;
+    u32 root = NULL_NODE;
+    u32 random_state = 0x9E3779B9;
+    size_t num_intervals = 0;
+};
+
+} // namespace Common
@@ -384,6 +384,8 @@ struct Values {
                                                                   AstcRecompression::Bc3,
                                                                   "astc_recompression",
                                                                   Category::RendererAdvanced};
+    Setting<bool> use_disk_texture_cache{linkage, false, "use_disk_texture_cache",
+                                         Category::RendererAdvanced};
     SwitchableSetting<VramUsageMode, true> vram_usage_mode{linkage,
                                                            VramUsageMode::Conservative,
                                                            VramUsageMode::Conservative,
@@ -570,6 +572,11 @@ struct Values {
                                         Category::DataStorage};
     Setting<std::string> gamecard_path{linkage, std::string(), "gamecard_path",
                                        Category::DataStorage};
+    Setting<bool> map_read_only_files{linkage, false, "map_read_only_files",
+                                      Category::DataStorage};
+    Setting<u32, true> decrypted_block_cache_size{linkage, 64, 0, 1024,
+                                                  "decrypted_block_cache_size",
+                                                  Category::DataStorage};
 
     // Debugging
     bool record_frame_times;
@@ -583,9 +590,13 @@ struct Values {
         false};
     Setting<bool> dump_macros{
         linkage, false, "dump_macros", Category::DebuggingGraphics, Specialization::Default, false};
+    Setting<bool> dump_gpu_commands{linkage, false, "dump_gpu_commands",
+                                    Category::DebuggingGraphics, Specialization::Default, false};
     Setting<bool> enable_fs_access_log{linkage, false, "enable_fs_access_log", Category::Debugging};
     Setting<bool> reporting_services{
         linkage, false, "reporting_services", Category::Debugging, Specialization::Default, false};
+    Setting<bool> record_service_latency{linkage, false, "record_service_latency",
+                                         Category::Debugging, Specialization::Default, false};
     Setting<bool> quest_flag{linkage, false, "quest_flag", Category::Debugging};
     Setting<bool> disable_macro_jit{linkage, false, "disable_macro_jit",
                                     Category::DebuggingGraphics};
@@ -42,4 +42,16 @@ namespace Common::Compression {
  */
 [[nodiscard]] std::vector<u8> DecompressDataZSTD(std::span<const u8> compressed);
 
+/**
+ * Decompresses a source memory region with Zstandard into a caller provided buffer.
+ *
+ * @param compressed the compressed source memory region.
+ * @param destination the buffer receiving the decompressed data.
+ *
+ * @return the number of decompressed bytes, or 0 if decompression failed or the data does not
+ *         fit in destination.
+ */
+[[nodiscard]] std::size_t DecompressDataZSTD(std::span<const u8> compressed,
+                                             std::span<u8> destination);
+
 } // namespace Common::Compression
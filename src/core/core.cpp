@@ -20,6 +20,7 @@
 #include "core/debugger/debugger.h"
 #include "core/device_memory.h"
 #include "core/file_sys/fs_filesystem.h"
+#include "core/file_sys/fssystem/fssystem_decrypted_block_cache.h"
 #include "core/file_sys/patch_manager.h"
 #include "core/file_sys/registered_cache.h"
 #include "core/file_sys/romfs_factory.h"
@@ -398,6 +399,26 @@ struct System::Impl {
         return status;
     }
 
+    SystemResultStatus LoadGPUOnly(System& system, Frontend::EmuWindow& emu_window) {
+        InitializeKernel(system);
+        telemetry_session = std::make_unique<Core::TelemetrySession>();
+
+        host1x_core = std::make_unique<Tegra::Host1x::Host1x>(system);
+        gpu_core = VideoCore::CreateGPU(emu_window, system);
+        if (!gpu_core) {
+            LOG_CRITICAL(Core, "Failed to initialize VideoCore!");
+            ShutdownMainProcess();
+            return SystemResultStatus::ErrorVideoCore;
+        }
+
+        is_powered_on = true;
+        exit_locked = false;
+        exit_requested = false;
+
+        status = SystemResultStatus::Success;
+        return status;
+    }
+
     void ShutdownMainProcess() {
         SetShuttingDown(true);
 
@@ -433,6 +454,16 @@ struct System::Impl {
         services.reset();
         service_manager.reset();
         fs_controller.Reset();
+        {
+            auto& block_cache = FileSys::DecryptedBlockCache::GetInstance();
+            const auto cache_stats = block_cache.GetStats();
+            if (const u64 lookups = cache_stats.hits + cache_stats.misses; lookups != 0) {
+                LOG_INFO(Core, "Decrypted block cache: {} hits, {} misses ({:.1f}% hit rate)",
+                         cache_stats.hits, cache_stats.misses,
+                         100.0 * static_cast<double>(cache_stats.hits) / lookups);
+            }
+            block_cache.Clear();
+        }
         cheat_engine.reset();
         telemetry_session.reset();
         core_timing.ClearPendingEvents();
@@ -637,6 +668,10 @@ SystemResultStatus System::Load(Frontend::EmuWindow& emu_window, const std::stri
     return impl->Load(*this, emu_window, filepath, params);
 }
 
+SystemResultStatus System::LoadGPUOnly(Frontend::EmuWindow& emu_window) {
+    return impl->LoadGPUOnly(*this, emu_window);
+}
+
 bool System::IsPoweredOn() const {
     return impl->is_powered_on.load(std::memory_order::relaxed);
 }
@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include <algorithm>
+#include <bit>
 #include <mutex>
 #include <string>
 #include <tuple>
@@ -26,28 +27,50 @@ std::shared_ptr<EventType> CreateEvent(std::string name, TimedCallback&& callbac
     return std::make_shared<EventType>(std::move(callback), std::move(name));
 }
 
+constexpr u32 NOT_IN_WHEEL = ~0U;
+constexpr u32 IN_READY_HEAP = ~0U - 1;
+
 struct CoreTiming::Event {
     s64 time;
     u64 fifo_order;
     std::weak_ptr<EventType> type;
+    const EventType* type_key;
     s64 reschedule_time;
-    heap_t::handle_type handle{};
+    size_t sequence_number;
+
+    /// Set on submissions that unschedule every event of type_key.
+    bool is_unschedule{};
+    /// Set on ready events that were unscheduled, they are freed once they reach the top.
+    bool is_removed{};
+
+    /// Next request in the submission list.
+    Event* next_submission{};
+    /// Neighbours in the wheel slot this event is linked into.
+    Event* prev{};
+    Event* next{};
+    /// Neighbours in the list of pending events with the same type.
+    Event* prev_of_type{};
+    Event* next_of_type{};
+    /// Wheel slot index (level * WheelSlots + slot), IN_READY_HEAP or NOT_IN_WHEEL.
+    u32 wheel_slot{NOT_IN_WHEEL};
+};
 
-    // Sort by time, unless the times are the same, in which case sort by
-    // the order added to the queue
-    friend bool operator>(const Event& left, const Event& right) {
-        return std::tie(left.time, left.fifo_order) > std::tie(right.time, right.fifo_order);
-    }
+namespace {
 
-    friend bool operator<(const Event& left, const Event& right) {
-        return std::tie(left.time, left.fifo_order) < std::tie(right.time, right.fifo_order);
-    }
-};
+// Sort by time, unless the times are the same, in which case sort by
+// the order added to the queue. The comparison is inverted to make the heap a min heap.
+template <typename T>
+bool ReadyEventCompare(const T* left, const T* right) {
+    return std::tie(left->time, left->fifo_order) > std::tie(right->time, right->fifo_order);
+}
+
+} // Anonymous namespace
 
 CoreTiming::CoreTiming() : clock{Common::CreateOptimalClock()} {}
 
 CoreTiming::~CoreTiming() {
     Reset();
+    FreeAllEvents();
 }
 
 void CoreTiming::ThreadEntry(CoreTiming& instance) {
@@ -72,8 +95,9 @@ void CoreTiming::Initialize(std::function<void()>&& on_thread_init_) {
 }
 
 void CoreTiming::ClearPendingEvents() {
-    std::scoped_lock lock{advance_lock, basic_lock};
-    event_queue.clear();
+    std::scoped_lock lock{advance_lock};
+    FreeAllEvents();
+    wheel_tick = 0;
     event.Set();
 }
 
@@ -111,62 +135,47 @@ bool CoreTiming::IsRunning() const {
 }
 
 bool CoreTiming::HasPendingEvents() const {
-    std::scoped_lock lock{basic_lock};
-    return !(wait_set && event_queue.empty());
+    return !(wait_set && num_events == 0);
 }
 
 void CoreTiming::ScheduleEvent(std::chrono::nanoseconds ns_into_future,
                                const std::shared_ptr<EventType>& event_type, bool absolute_time) {
-    {
-        std::scoped_lock scope{basic_lock};
-        const auto next_time{absolute_time ? ns_into_future : GetGlobalTimeNs() + ns_into_future};
-
-        auto h{event_queue.emplace(Event{next_time.count(), event_fifo_id++, event_type, 0})};
-        (*h).handle = h;
-    }
-
-    event.Set();
+    ScheduleLoopingEvent(ns_into_future, std::chrono::nanoseconds{0}, event_type, absolute_time);
 }
 
 void CoreTiming::ScheduleLoopingEvent(std::chrono::nanoseconds start_time,
                                       std::chrono::nanoseconds resched_time,
                                       const std::shared_ptr<EventType>& event_type,
                                       bool absolute_time) {
-    {
-        std::scoped_lock scope{basic_lock};
-        const auto next_time{absolute_time ? start_time : GetGlobalTimeNs() + start_time};
-
-        auto h{event_queue.emplace(
-            Event{next_time.count(), event_fifo_id++, event_type, resched_time.count()})};
-        (*h).handle = h;
-    }
+    const auto next_time{absolute_time ? start_time : GetGlobalTimeNs() + start_time};
+
+    ++num_events;
+    Submit(new Event{
+        .time = next_time.count(),
+        .fifo_order = event_fifo_id++,
+        .type = event_type,
+        .type_key = event_type.get(),
+        .reschedule_time = resched_time.count(),
+        .sequence_number = event_type->sequence_number,
+    });
 
     event.Set();
 }
 
 void CoreTiming::UnscheduleEvent(const std::shared_ptr<EventType>& event_type,
                                  UnscheduleEventType type) {
-    {
-        std::scoped_lock lk{basic_lock};
-
-        std::vector<heap_t::handle_type> to_remove;
-        for (auto itr = event_queue.begin(); itr != event_queue.end(); itr++) {
-            const Event& e = *itr;
-            if (e.type.lock().get() == event_type.get()) {
-                to_remove.push_back(itr->handle);
-            }
-        }
-
-        for (auto& h : to_remove) {
-            event_queue.erase(h);
-        }
-
-        event_type->sequence_number++;
-    }
+    // Bumping the sequence number invalidates all pending events of this type right away, the
+    // submission only releases their memory.
+    event_type->sequence_number++;
+    Submit(new Event{
+        .type_key = event_type.get(),
+        .is_unschedule = true,
+    });
 
     // Force any in-progress events to finish
     if (type == UnscheduleEventType::Wait) {
         std::scoped_lock lk{advance_lock};
+        DrainSubmissions();
     }
 }
 
@@ -198,62 +207,290 @@ u64 CoreTiming::GetGPUTicks() const {
 }
 
 std::optional<s64> CoreTiming::Advance() {
-    std::scoped_lock lock{advance_lock, basic_lock};
+    std::scoped_lock lock{advance_lock};
+    DrainSubmissions();
     global_timer = GetGlobalTimeNs().count();
+    AdvanceWheel(static_cast<u64>(std::max<s64>(global_timer, 0)) >> WheelTickShift);
 
-    while (!event_queue.empty() && event_queue.top().time <= global_timer) {
-        const Event& evt = event_queue.top();
+    while (!ready_events.empty() && ready_events.front()->time <= global_timer) {
+        std::pop_heap(ready_events.begin(), ready_events.end(), ReadyEventCompare<Event>);
+        Event* const evt = ready_events.back();
+        ready_events.pop_back();
+        evt->wheel_slot = NOT_IN_WHEEL;
 
-        if (const auto event_type{evt.type.lock()}) {
-            const auto evt_time = evt.time;
-            const auto evt_sequence_num = event_type->sequence_number;
+        if (evt->is_removed) {
+            FreeEvent(evt);
+            continue;
+        }
 
-            if (evt.reschedule_time == 0) {
-                event_queue.pop();
+        const auto event_type{evt->type.lock()};
+        if (!event_type || evt->sequence_number != event_type->sequence_number) {
+            RemoveEvent(evt);
+            continue;
+        }
 
-                basic_lock.unlock();
+        const auto evt_time = evt->time;
+        const auto new_schedule_time{event_type->callback(
+            evt_time, std::chrono::nanoseconds{GetGlobalTimeNs().count() - evt_time})};
+
+        if (evt->reschedule_time == 0 || evt->sequence_number != event_type->sequence_number) {
+            RemoveEvent(evt);
+        } else {
+            const auto next_schedule_time{new_schedule_time.has_value()
+                                              ? new_schedule_time.value().count()
+                                              : evt->reschedule_time};
+
+            // If this event was scheduled into a pause, its time now is going to be way
+            // behind. Re-set this event to continue from the end of the pause.
+            auto next_time{evt_time + next_schedule_time};
+            if (evt_time < pause_end_time) {
+                next_time = pause_end_time + next_schedule_time;
+            }
 
-                event_type->callback(
-                    evt_time, std::chrono::nanoseconds{GetGlobalTimeNs().count() - evt_time});
+            evt->time = next_time;
+            evt->fifo_order = event_fifo_id++;
+            evt->reschedule_time = next_schedule_time;
+            PlaceEvent(evt);
+        }
 
-                basic_lock.lock();
-            } else {
-                basic_lock.unlock();
+        // Pick up anything the callback scheduled before deciding what runs next.
+        DrainSubmissions();
+        global_timer = GetGlobalTimeNs().count();
+        AdvanceWheel(static_cast<u64>(std::max<s64>(global_timer, 0)) >> WheelTickShift);
+    }
 
-                const auto new_schedule_time{event_type->callback(
-                    evt_time, std::chrono::nanoseconds{GetGlobalTimeNs().count() - evt_time})};
+    return NextEventTime();
+}
 
-                basic_lock.lock();
+void CoreTiming::Submit(Event* submission) {
+    Event* head = submissions.load(std::memory_order_relaxed);
+    do {
+        submission->next_submission = head;
+    } while (!submissions.compare_exchange_weak(head, submission, std::memory_order_release,
+                                                std::memory_order_relaxed));
+}
 
-                if (evt_sequence_num != event_type->sequence_number) {
-                    // Heap handle is invalidated after external modification.
-                    continue;
+void CoreTiming::DrainSubmissions() {
+    // Submissions are pushed to the front of the list, reverse it to apply them in order.
+    Event* list = submissions.exchange(nullptr, std::memory_order_acquire);
+    Event* ordered = nullptr;
+    while (list != nullptr) {
+        Event* const next = list->next_submission;
+        list->next_submission = ordered;
+        ordered = list;
+        list = next;
+    }
+
+    while (ordered != nullptr) {
+        Event* const submission = ordered;
+        ordered = ordered->next_submission;
+
+        if (submission->is_unschedule) {
+            if (const auto it = events_by_type.find(submission->type_key);
+                it != events_by_type.end()) {
+                Event* evt = it->second;
+                while (evt != nullptr) {
+                    Event* const next = evt->next_of_type;
+                    RemoveEvent(evt);
+                    evt = next;
                 }
+            }
+            delete submission;
+            continue;
+        }
 
-                const auto next_schedule_time{new_schedule_time.has_value()
-                                                  ? new_schedule_time.value().count()
-                                                  : evt.reschedule_time};
+        const auto event_type{submission->type.lock()};
+        if (!event_type || submission->sequence_number != event_type->sequence_number) {
+            // Unscheduled before it was ever inserted.
+            FreeEvent(submission);
+            continue;
+        }
+        InsertEvent(submission);
+    }
+}
 
-                // If this event was scheduled into a pause, its time now is going to be way
-                // behind. Re-set this event to continue from the end of the pause.
-                auto next_time{evt.time + next_schedule_time};
-                if (evt.time < pause_end_time) {
-                    next_time = pause_end_time + next_schedule_time;
-                }
+void CoreTiming::InsertEvent(Event* evt) {
+    Event*& head = events_by_type[evt->type_key];
+    evt->prev_of_type = nullptr;
+    evt->next_of_type = head;
+    if (head != nullptr) {
+        head->prev_of_type = evt;
+    }
+    head = evt;
 
-                event_queue.update(evt.handle, Event{next_time, event_fifo_id++, evt.type,
-                                                     next_schedule_time, evt.handle});
-            }
+    PlaceEvent(evt);
+}
+
+void CoreTiming::PlaceEvent(Event* evt) {
+    const u64 tick = static_cast<u64>(std::max<s64>(evt->time, 0)) >> WheelTickShift;
+    if (tick <= wheel_tick) {
+        PushReadyEvent(evt);
+        return;
+    }
+
+    // Events live on the level of the highest digit in which they differ from the current tick.
+    const size_t level =
+        static_cast<size_t>(63 - std::countl_zero(tick ^ wheel_tick)) / WheelLevelBits;
+    const size_t slot = (tick >> (level * WheelLevelBits)) & (WheelSlots - 1);
+
+    Event*& head = wheel[level][slot];
+    evt->prev = nullptr;
+    evt->next = head;
+    if (head != nullptr) {
+        head->prev = evt;
+    }
+    head = evt;
+    evt->wheel_slot = static_cast<u32>(level * WheelSlots + slot);
+    wheel_occupancy[level] |= u64{1} << slot;
+}
+
+void CoreTiming::RemoveEvent(Event* evt) {
+    if (evt->prev_of_type != nullptr) {
+        evt->prev_of_type->next_of_type = evt->next_of_type;
+    } else if (const auto it = events_by_type.find(evt->type_key); it != events_by_type.end()) {
+        if (evt->next_of_type != nullptr) {
+            it->second = evt->next_of_type;
+        } else {
+            events_by_type.erase(it);
         }
+    }
+    if (evt->next_of_type != nullptr) {
+        evt->next_of_type->prev_of_type = evt->prev_of_type;
+    }
 
-        global_timer = GetGlobalTimeNs().count();
+    if (evt->wheel_slot == IN_READY_HEAP) {
+        // Ready events are dropped once they reach the top of the heap.
+        evt->is_removed = true;
+    } else if (evt->wheel_slot != NOT_IN_WHEEL) {
+        UnlinkFromWheel(evt);
+        FreeEvent(evt);
+    } else {
+        // The event is firing right now, or was just discarded by Advance.
+        FreeEvent(evt);
     }
+}
 
-    if (!event_queue.empty()) {
-        return event_queue.top().time;
+void CoreTiming::UnlinkFromWheel(Event* evt) {
+    const size_t level = evt->wheel_slot / WheelSlots;
+    const size_t slot = evt->wheel_slot % WheelSlots;
+    if (evt->prev != nullptr) {
+        evt->prev->next = evt->next;
     } else {
-        return std::nullopt;
+        wheel[level][slot] = evt->next;
+        if (evt->next == nullptr) {
+            wheel_occupancy[level] &= ~(u64{1} << slot);
+        }
+    }
+    if (evt->next != nullptr) {
+        evt->next->prev = evt->prev;
+    }
+    evt->wheel_slot = NOT_IN_WHEEL;
+}
+
+void CoreTiming::PushReadyEvent(Event* evt) {
+    evt->wheel_slot = IN_READY_HEAP;
+    ready_events.push_back(evt);
+    std::push_heap(ready_events.begin(), ready_events.end(), ReadyEventCompare<Event>);
+}
+
+void CoreTiming::FreeEvent(Event* evt) {
+    --num_events;
+    delete evt;
+}
+
+void CoreTiming::FreeAllEvents() {
+    for (size_t level = 0; level < WheelLevels; ++level) {
+        for (Event*& head : wheel[level]) {
+            while (head != nullptr) {
+                Event* const next = head->next;
+                delete head;
+                head = next;
+            }
+        }
+        wheel_occupancy[level] = 0;
+    }
+    for (Event* const evt : ready_events) {
+        delete evt;
+    }
+    ready_events.clear();
+    events_by_type.clear();
+
+    Event* submission = submissions.exchange(nullptr, std::memory_order_acquire);
+    while (submission != nullptr) {
+        Event* const next = submission->next_submission;
+        delete submission;
+        submission = next;
+    }
+    num_events = 0;
+}
+
+void CoreTiming::AdvanceWheel(u64 target_tick) {
+    if (target_tick <= wheel_tick) {
+        return;
+    }
+
+    // Every level below the highest digit that changes is fully due, and so is every slot of
+    // that level before the new digit. The slot of the new digit is spread over the lower levels.
+    const size_t top_level =
+        static_cast<size_t>(63 - std::countl_zero(target_tick ^ wheel_tick)) / WheelLevelBits;
+    const size_t top_slot = (target_tick >> (top_level * WheelLevelBits)) & (WheelSlots - 1);
+
+    const auto make_slot_ready = [this](size_t level, size_t slot) {
+        Event* evt = wheel[level][slot];
+        wheel[level][slot] = nullptr;
+        while (evt != nullptr) {
+            Event* const next = evt->next;
+            PushReadyEvent(evt);
+            evt = next;
+        }
+    };
+
+    for (size_t level = 0; level < top_level; ++level) {
+        for (u64 occupied = wheel_occupancy[level]; occupied != 0; occupied &= occupied - 1) {
+            make_slot_ready(level, static_cast<size_t>(std::countr_zero(occupied)));
+        }
+        wheel_occupancy[level] = 0;
+    }
+
+    const u64 due_mask = (u64{1} << top_slot) - 1;
+    for (u64 occupied = wheel_occupancy[top_level] & due_mask; occupied != 0;
+         occupied &= occupied - 1) {
+        make_slot_ready(top_level, static_cast<size_t>(std::countr_zero(occupied)));
+    }
+    wheel_occupancy[top_level] &= ~due_mask;
+
+    Event* cascade = nullptr;
+    if (wheel_occupancy[top_level] & (u64{1} << top_slot)) {
+        cascade = wheel[top_level][top_slot];
+        wheel[top_level][top_slot] = nullptr;
+        wheel_occupancy[top_level] &= ~(u64{1} << top_slot);
+    }
+
+    wheel_tick = target_tick;
+    while (cascade != nullptr) {
+        Event* const next = cascade->next;
+        PlaceEvent(cascade);
+        cascade = next;
+    }
+}
+
+std::optional<s64> CoreTiming::NextEventTime() const {
+    if (!ready_events.empty()) {
+        return ready_events.front()->time;
+    }
+
+    // Lower levels always hold earlier events, and the slots of a level are ordered by time.
+    for (size_t level = 0; level < WheelLevels; ++level) {
+        if (wheel_occupancy[level] == 0) {
+            continue;
+        }
+        const size_t shift = level * WheelLevelBits;
+        const u64 slot = static_cast<u64>(std::countr_zero(wheel_occupancy[level]));
+        const u64 upper_mask = ~((u64{1} << (shift + WheelLevelBits)) - 1);
+        const u64 tick = (wheel_tick & upper_mask) | (slot << shift);
+        return static_cast<s64>(tick << WheelTickShift);
     }
+    return std::nullopt;
 }
 
 void CoreTiming::ThreadLoop() {
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <array>
 #include <atomic>
 #include <chrono>
 #include <functional>
@@ -11,8 +12,8 @@
 #include <optional>
 #include <string>
 #include <thread>
-
-#include <boost/heap/fibonacci_heap.hpp>
+#include <unordered_map>
+#include <vector>
 
 #include "common/common_types.h"
 #include "common/thread.h"
@@ -34,8 +35,9 @@ struct EventType {
     /// A pointer to the name of the event.
     const std::string name;
     /// A monotonic sequence number, incremented when this event is
-    /// changed externally.
-    size_t sequence_number;
+    /// changed externally. Scheduled events that were created with an older
+    /// sequence number are discarded instead of being fired.
+    std::atomic<size_t> sequence_number;
 };
 
 enum class UnscheduleEventType {
@@ -54,6 +56,10 @@ enum class UnscheduleEventType {
  * So to schedule a new event on a regular basis:
  * inside callback:
  *   ScheduleEvent(period_in_ns - ns_late, callback, "whatever")
+ *
+ * Scheduling and unscheduling never block: requests are pushed to a lock-free submission list
+ * which is drained by whoever advances the timer. Pending events are kept in a hierarchical
+ * timing wheel, so inserting and removing an event takes constant time.
  */
 class CoreTiming {
 public:
@@ -141,11 +147,38 @@ public:
 private:
     struct Event;
 
+    /// Each wheel level splits the range of the level above it into this many slots.
+    static constexpr size_t WheelLevelBits = 6;
+    static constexpr size_t WheelSlots = size_t{1} << WheelLevelBits;
+    /// Enough levels to cover every non-negative nanosecond timestamp.
+    static constexpr size_t WheelLevels = 9;
+    /// Wheel ticks are 1024 nanoseconds long.
+    static constexpr size_t WheelTickShift = 10;
+
     static void ThreadEntry(CoreTiming& instance);
     void ThreadLoop();
 
     void Reset();
 
+    /// Pushes a schedule or unschedule request to the submission list.
+    void Submit(Event* submission);
+    /// Applies all submitted requests. Requires advance_lock to be held.
+    void DrainSubmissions();
+
+    void InsertEvent(Event* evt);
+    void PlaceEvent(Event* evt);
+    void RemoveEvent(Event* evt);
+    void UnlinkFromWheel(Event* evt);
+    void PushReadyEvent(Event* evt);
+    void FreeEvent(Event* evt);
+    void FreeAllEvents();
+
+    /// Moves the wheel to target_tick, making every event up to it ready.
+    void AdvanceWheel(u64 target_tick);
+
+    /// Returns a lower bound of the time of the earliest pending event.
+    std::optional<s64> NextEventTime() const;
+
     std::unique_ptr<Common::WallClock> clock;
 
     s64 global_timer = 0;
@@ -154,15 +187,18 @@ private:
     s64 timer_resolution_ns;
 #endif
 
-    using heap_t =
-        boost::heap::fibonacci_heap<CoreTiming::Event, boost::heap::compare<std::greater<>>>;
+    std::array<std::array<Event*, WheelSlots>, WheelLevels> wheel{};
+    std::array<u64, WheelLevels> wheel_occupancy{};
+    u64 wheel_tick = 0;
+    std::vector<Event*> ready_events;
+    std::unordered_map<const EventType*, Event*> events_by_type;
 
-    heap_t event_queue;
-    u64 event_fifo_id = 0;
+    std::atomic<Event*> submissions{};
+    std::atomic<size_t> num_events{};
+    std::atomic<u64> event_fifo_id = 0;
 
     Common::Event event{};
     Common::Event pause_event{};
-    mutable std::mutex basic_lock;
     std::mutex advance_lock;
     std::unique_ptr<std::jthread> timer_thread;
     std::atomic<bool> paused{};
@@ -6,6 +6,7 @@
 #include <array>
 #include <filesystem>
 #include <map>
+#include <mutex>
 #include <optional>
 #include <span>
 #include <string>
@@ -298,6 +299,10 @@ public:
 private:
     KeyManager();
 
+    /// Guards the key maps and tickets, the game list parses containers from several threads.
+    /// Recursive because the accessors call each other.
+    mutable std::recursive_mutex keys_mutex;
+
     std::map<KeyIndex<S128KeyType>, Key128> s128_keys;
     std::map<KeyIndex<S256KeyType>, Key256> s256_keys;
 
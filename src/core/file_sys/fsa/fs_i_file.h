@@ -42,6 +42,26 @@ public:
         R_RETURN(this->Read(out, offset, buffer, size, ReadOption::None));
     }
 
+    // Gets the requested range straight from host memory when the backend is memory mapped. The
+    // output is empty when the range has to be read through Read instead.
+    Result GetMappedRange(std::span<const u8>* out, s64 offset, size_t size) {
+        // Check that we have an output pointer
+        R_UNLESS(out != nullptr, ResultNullptrArgument);
+
+        // Check that the range is valid
+        R_UNLESS(offset >= 0, ResultOutOfRange);
+        R_UNLESS(Common::CanAddWithoutOverflow<s64>(offset, size), ResultOutOfRange);
+
+        const auto view = backend->GetMappedView();
+        if (static_cast<size_t>(offset) >= view.size()) {
+            *out = {};
+            R_SUCCEED();
+        }
+
+        *out = view.subspan(offset, std::min(size, view.size() - offset));
+        R_SUCCEED();
+    }
+
     Result GetSize(s64* out) {
         R_UNLESS(out != nullptr, ResultNullptrArgument);
         R_RETURN(this->DoGetSize(out));
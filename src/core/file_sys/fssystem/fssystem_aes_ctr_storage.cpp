@@ -1,14 +1,39 @@
 // SPDX-FileCopyrightText: Copyright 2023 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
+#include <thread>
+#include <vector>
+
 #include "common/alignment.h"
+#include "common/div_ceil.h"
 #include "common/swap.h"
+#include "common/thread.h"
+#include "common/thread_worker.h"
 #include "core/file_sys/fssystem/fssystem_aes_ctr_storage.h"
+#include "core/file_sys/fssystem/fssystem_decrypted_block_cache.h"
 #include "core/file_sys/fssystem/fssystem_pooled_buffer.h"
 #include "core/file_sys/fssystem/fssystem_utility.h"
 
 namespace FileSys {
 
+namespace {
+
+// Decryption is split across worker threads once a read reaches this size.
+constexpr size_t ParallelDecryptionThreshold = 512_KiB;
+constexpr size_t MinimumParallelChunkSize = 256_KiB;
+
+size_t GetDecryptionWorkerCount() {
+    return std::max(std::thread::hardware_concurrency() / 2, 1U);
+}
+
+Common::ThreadWorker& GetDecryptionWorkers() {
+    static Common::ThreadWorker s_workers(GetDecryptionWorkerCount(), "AesCtrDecryption");
+    return s_workers;
+}
+
+} // namespace
+
 void AesCtrStorage::MakeIv(void* dst, size_t dst_size, u64 upper, s64 offset) {
     ASSERT(dst != nullptr);
     ASSERT(dst_size == IvSize);
@@ -32,9 +57,15 @@ AesCtrStorage::AesCtrStorage(VirtualFile base, const void* key, size_t key_size,
     std::memcpy(m_key.data(), key, KeySize);
     std::memcpy(m_iv.data(), iv, IvSize);
 
+    m_cache_id = DecryptedBlockCache::AllocateStorageId();
     m_cipher.emplace(m_key, Core::Crypto::Mode::CTR);
 }
 
+AesCtrStorage::~AesCtrStorage() {
+    // Identifiers are never reused, so the blocks of this storage could only be evicted.
+    DecryptedBlockCache::GetInstance().Purge(m_cache_id);
+}
+
 size_t AesCtrStorage::Read(u8* buffer, size_t size, size_t offset) const {
     // Allow zero-size reads.
     if (size == 0) {
@@ -48,21 +79,125 @@ size_t AesCtrStorage::Read(u8* buffer, size_t size, size_t offset) const {
     ASSERT(Common::IsAligned(offset, BlockSize));
     ASSERT(Common::IsAligned(size, BlockSize));
 
-    // Read the data.
-    m_base_storage->Read(buffer, size, offset);
+    // Reads this large bypass the block cache so that streaming does not evict everything else,
+    // every read does when the cache is disabled.
+    if (size >= DecryptedBlockCache::GetCapacity() / 8) {
+        this->ReadUncached(buffer, size, offset);
+        return size;
+    }
 
-    // Setup the counter.
-    std::array<u8, IvSize> ctr;
-    std::memcpy(ctr.data(), m_iv.data(), IvSize);
-    AddCounter(ctr.data(), IvSize, offset / BlockSize);
+    constexpr size_t CacheBlockSize = DecryptedBlockCache::BlockSize;
+    auto& cache = DecryptedBlockCache::GetInstance();
+    const size_t storage_size = this->GetSize();
+    const size_t end_offset = offset + size;
 
-    // Decrypt.
-    m_cipher->SetIV(ctr);
-    m_cipher->Transcode(buffer, size, buffer, Core::Crypto::Op::Decrypt);
+    std::vector<u8> work_buffer;
+    size_t cur_offset = offset;
+    while (cur_offset < end_offset) {
+        const u64 block_index = cur_offset / CacheBlockSize;
+        const size_t offset_in_block = cur_offset - block_index * CacheBlockSize;
+        const size_t copy_size = std::min(CacheBlockSize - offset_in_block, end_offset - cur_offset);
+        u8* const dst = buffer + (cur_offset - offset);
+
+        // Copy the block from the cache when it is present.
+        if (cache.Read(m_cache_id, block_index, dst, offset_in_block, copy_size)) {
+            cur_offset += copy_size;
+            continue;
+        }
+
+        // Gather the run of missing blocks covered by the read.
+        const u64 last_block_index = (end_offset - 1) / CacheBlockSize;
+        u64 run_end_index = block_index + 1;
+        while (run_end_index <= last_block_index && !cache.Contains(m_cache_id, run_end_index)) {
+            ++run_end_index;
+        }
+
+        // Read and decrypt the whole blocks at once.
+        const size_t run_offset = block_index * CacheBlockSize;
+        const size_t run_end = std::min<size_t>(run_end_index * CacheBlockSize, storage_size);
+        const size_t run_size = run_end > cur_offset ? run_end - run_offset : 0;
+        work_buffer.resize(run_size);
+        if (run_size == 0 ||
+            this->ReadUncached(work_buffer.data(), run_size, run_offset) < run_size) {
+            // The read goes past the end of the base storage, don't cache partial data.
+            this->ReadUncached(dst, end_offset - cur_offset, cur_offset);
+            break;
+        }
+
+        for (size_t block_offset = 0; block_offset < run_size; block_offset += CacheBlockSize) {
+            const size_t block_size = std::min(CacheBlockSize, run_size - block_offset);
+            cache.Insert(m_cache_id, block_index + block_offset / CacheBlockSize,
+                         std::span(work_buffer.data() + block_offset, block_size));
+        }
+
+        // Copy out the requested part of the run.
+        const size_t run_copy_size = std::min(run_offset + run_size, end_offset) - cur_offset;
+        std::memcpy(dst, work_buffer.data() + offset_in_block, run_copy_size);
+        cur_offset += run_copy_size;
+    }
 
     return size;
 }
 
+size_t AesCtrStorage::ReadUncached(u8* buffer, size_t size, size_t offset) const {
+    // Read the data.
+    const size_t read_size = m_base_storage->Read(buffer, size, offset);
+
+    // Decrypt.
+    this->Decrypt(buffer, size, offset);
+
+    return read_size;
+}
+
+void AesCtrStorage::Decrypt(u8* buffer, size_t size, size_t offset) const {
+    const auto decrypt_chunk = [this](Core::Crypto::AESCipher<Core::Crypto::Key128>& cipher,
+                                      u8* data, size_t data_size, size_t data_offset) {
+        // Setup the counter.
+        std::array<u8, IvSize> ctr;
+        std::memcpy(ctr.data(), m_iv.data(), IvSize);
+        AddCounter(ctr.data(), IvSize, data_offset / BlockSize);
+
+        // Decrypt.
+        cipher.SetIV(ctr);
+        cipher.Transcode(data, data_size, data, Core::Crypto::Op::Decrypt);
+    };
+
+    const size_t num_workers = GetDecryptionWorkerCount();
+    if (size < ParallelDecryptionThreshold || num_workers == 1) {
+        std::scoped_lock lk{m_cipher_mutex};
+        decrypt_chunk(*m_cipher, buffer, size, offset);
+        return;
+    }
+
+    // Each chunk starts on its own counter, so chunks can be decrypted independently.
+    const size_t chunk_size = Common::AlignUp(
+        std::max(Common::DivCeil(size, num_workers + 1), MinimumParallelChunkSize), BlockSize);
+    const size_t num_chunks = Common::DivCeil(size, chunk_size);
+
+    std::atomic<size_t> remaining_chunks{num_chunks - 1};
+    Common::Event chunks_done;
+    for (size_t i = 1; i < num_chunks; ++i) {
+        const size_t chunk_offset = i * chunk_size;
+        const size_t cur_chunk_size = std::min(chunk_size, size - chunk_offset);
+        GetDecryptionWorkers().QueueWork([&, chunk_offset, cur_chunk_size] {
+            Core::Crypto::AESCipher<Core::Crypto::Key128> cipher(m_key, Core::Crypto::Mode::CTR);
+            decrypt_chunk(cipher, buffer + chunk_offset, cur_chunk_size, offset + chunk_offset);
+            if (--remaining_chunks == 0) {
+                chunks_done.Set();
+            }
+        });
+    }
+
+    // Decrypt the first chunk on the calling thread while the workers handle the rest.
+    {
+        std::scoped_lock lk{m_cipher_mutex};
+        decrypt_chunk(*m_cipher, buffer, std::min(chunk_size, size), offset);
+    }
+    if (num_chunks > 1) {
+        chunks_done.Wait();
+    }
+}
+
 size_t AesCtrStorage::Write(const u8* buffer, size_t size, size_t offset) {
     // Allow zero-size writes.
     if (size == 0) {
@@ -76,6 +211,9 @@ size_t AesCtrStorage::Write(const u8* buffer, size_t size, size_t offset) {
     ASSERT(Common::IsAligned(offset, BlockSize));
     ASSERT(Common::IsAligned(size, BlockSize));
 
+    // Drop any decrypted copies of the blocks being overwritten.
+    DecryptedBlockCache::GetInstance().Invalidate(m_cache_id, offset, size);
+
     // Get a pooled buffer.
     PooledBuffer pooled_buffer;
     const bool use_work_buffer = true;
@@ -104,9 +242,12 @@ size_t AesCtrStorage::Write(const u8* buffer, size_t size, size_t offset) {
         }
 
         // Encrypt the data.
-        m_cipher->SetIV(ctr);
-        m_cipher->Transcode(buffer, write_size, reinterpret_cast<u8*>(write_buf),
-                            Core::Crypto::Op::Encrypt);
+        {
+            std::scoped_lock lk{m_cipher_mutex};
+            m_cipher->SetIV(ctr);
+            m_cipher->Transcode(buffer, write_size, reinterpret_cast<u8*>(write_buf),
+                                Core::Crypto::Op::Encrypt);
+        }
 
         // Write the encrypted data.
         m_base_storage->Write(reinterpret_cast<u8*>(write_buf), write_size, offset + cur_offset);
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <mutex>
 #include <optional>
 
 #include "core/crypto/aes_util.h"
@@ -28,15 +29,22 @@ public:
 public:
     AesCtrStorage(VirtualFile base, const void* key, size_t key_size, const void* iv,
                   size_t iv_size);
+    ~AesCtrStorage() override;
 
     virtual size_t Read(u8* buffer, size_t size, size_t offset) const override;
     virtual size_t Write(const u8* buffer, size_t size, size_t offset) override;
     virtual size_t GetSize() const override;
 
+private:
+    size_t ReadUncached(u8* buffer, size_t size, size_t offset) const;
+    void Decrypt(u8* buffer, size_t size, size_t offset) const;
+
 private:
     VirtualFile m_base_storage;
     std::array<u8, KeySize> m_key;
     std::array<u8, IvSize> m_iv;
+    u64 m_cache_id;
+    mutable std::mutex m_cipher_mutex;
     mutable std::optional<Core::Crypto::AESCipher<Core::Crypto::Key128>> m_cipher;
 };
 
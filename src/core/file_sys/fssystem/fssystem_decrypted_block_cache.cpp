@@ -0,0 +1,151 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cstring>
+
+#include "common/assert.h"
+#include "common/settings.h"
+#include "core/file_sys/fssystem/fssystem_decrypted_block_cache.h"
+
+namespace FileSys {
+
+namespace {
+
+std::atomic<u64> g_next_storage_id{1};
+
+} // namespace
+
+DecryptedBlockCache& DecryptedBlockCache::GetInstance() {
+    static DecryptedBlockCache s_instance;
+    return s_instance;
+}
+
+size_t DecryptedBlockCache::GetCapacity() {
+    return static_cast<size_t>(Settings::values.decrypted_block_cache_size.GetValue()) * 1_MiB;
+}
+
+u64 DecryptedBlockCache::AllocateStorageId() {
+    return g_next_storage_id.fetch_add(1, std::memory_order_relaxed);
+}
+
+DecryptedBlockCache::DecryptedBlockCache() = default;
+
+DecryptedBlockCache::~DecryptedBlockCache() = default;
+
+bool DecryptedBlockCache::Read(u64 storage_id, u64 block_index, u8* dst, size_t offset,
+                               size_t size) {
+    const Key key{storage_id, block_index};
+    Shard& shard = this->GetShard(key);
+
+    std::scoped_lock lk{shard.mutex};
+    const auto it = shard.map.find(key);
+    if (it == shard.map.end() || offset + size > it->second->size) {
+        m_misses.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    // Move the entry to the most recently used position.
+    shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+    std::memcpy(dst, it->second->data.get() + offset, size);
+
+    m_hits.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+bool DecryptedBlockCache::Contains(u64 storage_id, u64 block_index) {
+    const Key key{storage_id, block_index};
+    Shard& shard = this->GetShard(key);
+
+    std::scoped_lock lk{shard.mutex};
+    return shard.map.contains(key);
+}
+
+void DecryptedBlockCache::Insert(u64 storage_id, u64 block_index, std::span<const u8> data) {
+    ASSERT(data.size() <= BlockSize);
+
+    const Key key{storage_id, block_index};
+    Shard& shard = this->GetShard(key);
+    const size_t shard_capacity = GetCapacity() / ShardCount;
+
+    // Copy outside of the lock, the shard is only held to link the entry.
+    auto copy = std::make_unique_for_overwrite<u8[]>(data.size());
+    std::memcpy(copy.get(), data.data(), data.size());
+
+    std::scoped_lock lk{shard.mutex};
+    if (const auto it = shard.map.find(key); it != shard.map.end()) {
+        shard.bytes_used -= it->second->size;
+        shard.lru.erase(it->second);
+        shard.map.erase(it);
+    }
+
+    // Evict the least recently used blocks until the new one fits.
+    while (!shard.lru.empty() && shard.bytes_used + data.size() > shard_capacity) {
+        Entry& victim = shard.lru.back();
+        shard.bytes_used -= victim.size;
+        shard.map.erase(victim.key);
+        shard.lru.pop_back();
+        m_evictions.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    shard.lru.push_front(Entry{key, std::move(copy), data.size()});
+    shard.map.emplace(key, shard.lru.begin());
+    shard.bytes_used += data.size();
+}
+
+void DecryptedBlockCache::Invalidate(u64 storage_id, size_t offset, size_t size) {
+    if (size == 0) {
+        return;
+    }
+
+    const u64 first_block = offset / BlockSize;
+    const u64 last_block = (offset + size - 1) / BlockSize;
+    for (u64 block_index = first_block; block_index <= last_block; ++block_index) {
+        const Key key{storage_id, block_index};
+        Shard& shard = this->GetShard(key);
+
+        std::scoped_lock lk{shard.mutex};
+        if (const auto it = shard.map.find(key); it != shard.map.end()) {
+            shard.bytes_used -= it->second->size;
+            shard.lru.erase(it->second);
+            shard.map.erase(it);
+        }
+    }
+}
+
+void DecryptedBlockCache::Purge(u64 storage_id) {
+    // Blocks of a storage are spread over every shard.
+    for (Shard& shard : m_shards) {
+        std::scoped_lock lk{shard.mutex};
+        for (auto it = shard.lru.begin(); it != shard.lru.end();) {
+            if (it->key.storage_id != storage_id) {
+                ++it;
+                continue;
+            }
+            shard.bytes_used -= it->size;
+            shard.map.erase(it->key);
+            it = shard.lru.erase(it);
+        }
+    }
+}
+
+void DecryptedBlockCache::Clear() {
+    for (Shard& shard : m_shards) {
+        std::scoped_lock lk{shard.mutex};
+        shard.map.clear();
+        shard.lru.clear();
+        shard.bytes_used = 0;
+    }
+    m_hits = 0;
+    m_misses = 0;
+    m_evictions = 0;
+}
+
+DecryptedBlockCacheStats DecryptedBlockCache::GetStats() const {
+    return {
+        .hits = m_hits.load(std::memory_order_relaxed),
+        .misses = m_misses.load(std::memory_order_relaxed),
+        .evictions = m_evictions.load(std::memory_order_relaxed),
+    };
+}
+
+} // namespace FileSys
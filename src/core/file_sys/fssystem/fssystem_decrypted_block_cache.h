@@ -0,0 +1,109 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <unordered_map>
+
+#include "common/common_funcs.h"
+#include "common/common_types.h"
+#include "common/literals.h"
+
+namespace FileSys {
+
+using namespace Common::Literals;
+
+struct DecryptedBlockCacheStats {
+    u64 hits;
+    u64 misses;
+    u64 evictions;
+};
+
+// Process wide LRU cache of decrypted storage blocks, split into independently locked shards so
+// that reads from different threads rarely contend. Its size is set by the
+// decrypted_block_cache_size setting, a size of zero disables it.
+class DecryptedBlockCache {
+    YUZU_NON_COPYABLE(DecryptedBlockCache);
+    YUZU_NON_MOVEABLE(DecryptedBlockCache);
+
+public:
+    static constexpr size_t BlockSize = 16_KiB;
+    static constexpr size_t ShardCount = 16;
+
+public:
+    static DecryptedBlockCache& GetInstance();
+
+    // Returns the configured size of the cache in bytes.
+    static size_t GetCapacity();
+
+    // Returns a new identifier for a storage, identifiers are never reused.
+    static u64 AllocateStorageId();
+
+    DecryptedBlockCache();
+    ~DecryptedBlockCache();
+
+    // Copies size bytes at offset within a cached block to dst, returns false on a miss.
+    bool Read(u64 storage_id, u64 block_index, u8* dst, size_t offset, size_t size);
+
+    // Returns true when the block is currently cached.
+    bool Contains(u64 storage_id, u64 block_index);
+
+    // Inserts a decrypted block, replacing any previous contents.
+    void Insert(u64 storage_id, u64 block_index, std::span<const u8> data);
+
+    // Drops the blocks of a storage that overlap [offset, offset + size).
+    void Invalidate(u64 storage_id, size_t offset, size_t size);
+
+    // Drops every block of a storage, used when the storage is destroyed.
+    void Purge(u64 storage_id);
+
+    // Drops every cached block and resets the statistics.
+    void Clear();
+
+    DecryptedBlockCacheStats GetStats() const;
+
+private:
+    struct Key {
+        u64 storage_id;
+        u64 block_index;
+
+        bool operator==(const Key&) const = default;
+    };
+
+    struct KeyHash {
+        size_t operator()(const Key& key) const noexcept {
+            return static_cast<size_t>(key.storage_id * 0x9E3779B97F4A7C15ULL ^ key.block_index);
+        }
+    };
+
+    struct Entry {
+        Key key;
+        std::unique_ptr<u8[]> data;
+        size_t size;
+    };
+
+    struct Shard {
+        std::mutex mutex;
+        std::list<Entry> lru;
+        std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> map;
+        size_t bytes_used{};
+    };
+
+    Shard& GetShard(const Key& key) {
+        return m_shards[KeyHash{}(key) % ShardCount];
+    }
+
+private:
+    std::array<Shard, ShardCount> m_shards;
+    std::atomic<u64> m_hits{};
+    std::atomic<u64> m_misses{};
+    std::atomic<u64> m_evictions{};
+};
+
+} // namespace FileSys
@@ -2,14 +2,22 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
 #include <random>
 #include <regex>
+#include <thread>
 #include <mbedtls/sha256.h>
 #include "common/assert.h"
+#include "common/div_ceil.h"
 #include "common/fs/path_util.h"
 #include "common/hex_util.h"
+#include "common/literals.h"
 #include "common/logging/log.h"
 #include "common/scope_exit.h"
+#include "common/thread.h"
 #include "core/crypto/key_manager.h"
 #include "core/file_sys/card_image.h"
 #include "core/file_sys/common_funcs.h"
@@ -25,6 +33,133 @@ namespace FileSys {
 // The size of blocks to use when vfs raw copying into nand.
 constexpr size_t VFS_RC_LARGE_COPY_BLOCK = 0x400000;
 
+// The number of blocks the pipelined installer keeps in flight per NCA.
+constexpr size_t INSTALL_PIPELINE_DEPTH = 4;
+
+// The maximum number of NCAs the pipelined installer copies at once.
+constexpr size_t INSTALL_MAX_CONCURRENT_NCAS = 4;
+
+namespace {
+
+// Copies src to dest block by block. The calling thread reads into a ring of buffers while a
+// hashing thread and a writing thread consume the same buffers in order, so reading, hashing and
+// writing of consecutive blocks overlap.
+bool PipelinedCopy(const VirtualFile& src, const VirtualFile& dest, bool compute_hash,
+                   Core::Crypto::SHA256Hash& out_hash, std::atomic<size_t>& progress,
+                   const std::atomic<bool>& cancel) {
+    if (src == nullptr || dest == nullptr || !dest->Resize(src->GetSize())) {
+        return false;
+    }
+
+    const size_t size = src->GetSize();
+    const size_t num_blocks = Common::DivCeil(size, VFS_RC_LARGE_COPY_BLOCK);
+    std::array<std::vector<u8>, INSTALL_PIPELINE_DEPTH> buffers;
+    for (auto& buffer : buffers) {
+        buffer.resize(std::min(size, VFS_RC_LARGE_COPY_BLOCK));
+    }
+    const auto block_size = [&](size_t block) {
+        return std::min(VFS_RC_LARGE_COPY_BLOCK, size - block * VFS_RC_LARGE_COPY_BLOCK);
+    };
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    size_t num_read = 0;
+    size_t num_hashed = compute_hash ? 0 : num_blocks;
+    size_t num_written = 0;
+    bool failed = false;
+
+    // Waits until block has been read, returns false if the copy was aborted.
+    const auto wait_for_block = [&](size_t block) {
+        std::unique_lock lk{mutex};
+        cv.wait(lk, [&] { return failed || num_read > block; });
+        return !failed;
+    };
+    const auto fail = [&] {
+        {
+            std::scoped_lock lk{mutex};
+            failed = true;
+        }
+        cv.notify_all();
+    };
+
+    std::jthread hash_thread;
+    if (compute_hash) {
+        hash_thread = std::jthread([&] {
+            mbedtls_sha256_context ctx;
+            mbedtls_sha256_init(&ctx);
+            mbedtls_sha256_starts_ret(&ctx, 0);
+            SCOPE_EXIT {
+                mbedtls_sha256_free(&ctx);
+            };
+            for (size_t block = 0; block < num_blocks; ++block) {
+                if (!wait_for_block(block)) {
+                    return;
+                }
+                const auto& buffer = buffers[block % INSTALL_PIPELINE_DEPTH];
+                mbedtls_sha256_update_ret(&ctx, buffer.data(), block_size(block));
+                {
+                    std::scoped_lock lk{mutex};
+                    ++num_hashed;
+                }
+                cv.notify_all();
+            }
+            mbedtls_sha256_finish_ret(&ctx, out_hash.data());
+        });
+    }
+
+    std::jthread write_thread([&] {
+        for (size_t block = 0; block < num_blocks; ++block) {
+            if (!wait_for_block(block)) {
+                return;
+            }
+            const auto& buffer = buffers[block % INSTALL_PIPELINE_DEPTH];
+            const size_t length = block_size(block);
+            if (dest->Write(buffer.data(), length, block * VFS_RC_LARGE_COPY_BLOCK) != length) {
+                fail();
+                return;
+            }
+            progress += length;
+            {
+                std::scoped_lock lk{mutex};
+                ++num_written;
+            }
+            cv.notify_all();
+        }
+    });
+
+    for (size_t block = 0; block < num_blocks; ++block) {
+        {
+            // Wait for both consumers to release the buffer this block reuses.
+            std::unique_lock lk{mutex};
+            cv.wait(lk, [&] {
+                return failed || block - std::min(num_hashed, num_written) < INSTALL_PIPELINE_DEPTH;
+            });
+            if (failed) {
+                break;
+            }
+        }
+        const size_t length = block_size(block);
+        auto& buffer = buffers[block % INSTALL_PIPELINE_DEPTH];
+        if (cancel || src->Read(buffer.data(), length, block * VFS_RC_LARGE_COPY_BLOCK) != length) {
+            fail();
+            break;
+        }
+        {
+            std::scoped_lock lk{mutex};
+            ++num_read;
+        }
+        cv.notify_all();
+    }
+
+    write_thread.join();
+    if (hash_thread.joinable()) {
+        hash_thread.join();
+    }
+    return !failed;
+}
+
+} // Anonymous namespace
+
 std::string ContentProviderEntry::DebugInfo() const {
     return fmt::format("title_id={:016X}, content_type={:02X}", title_id, static_cast<u8>(type));
 }
@@ -563,8 +698,90 @@ InstallResult RegisteredCache::InstallEntry(const XCI& xci, bool overwrite_if_ex
     return InstallEntry(*xci.GetSecurePartitionNSP(), overwrite_if_exists, copy);
 }
 
+InstallResult RegisteredCache::InstallEntry(const XCI& xci, bool overwrite_if_exists,
+                                            const InstallProgressCallback& callback) {
+    return InstallEntry(*xci.GetSecurePartitionNSP(), overwrite_if_exists, callback);
+}
+
 InstallResult RegisteredCache::InstallEntry(const NSP& nsp, bool overwrite_if_exists,
                                             const VfsCopyFunction& copy) {
+    std::vector<InstallJob> jobs;
+    bool removed_existing = false;
+    const auto prepare_result = PrepareInstall(nsp, jobs, removed_existing);
+    if (prepare_result != InstallResult::Success) {
+        return prepare_result;
+    }
+
+    for (const auto& job : jobs) {
+        VirtualFile out;
+        const auto open_result = OpenInstallTarget(job.id, overwrite_if_exists, out);
+        if (open_result != InstallResult::Success) {
+            return open_result;
+        }
+        if (!copy(job.file, out, VFS_RC_LARGE_COPY_BLOCK)) {
+            return InstallResult::ErrorCopyFailed;
+        }
+    }
+
+    Refresh();
+    if (removed_existing) {
+        return InstallResult::OverwriteExisting;
+    }
+    return InstallResult::Success;
+}
+
+InstallResult RegisteredCache::InstallEntry(const NSP& nsp, bool overwrite_if_exists,
+                                            const InstallProgressCallback& callback) {
+    std::vector<InstallJob> jobs;
+    bool removed_existing = false;
+    const auto prepare_result = PrepareInstall(nsp, jobs, removed_existing);
+    if (prepare_result != InstallResult::Success) {
+        return prepare_result;
+    }
+
+    const auto install_result = RawInstallNCAs(jobs, overwrite_if_exists, callback);
+    if (install_result != InstallResult::Success) {
+        return install_result;
+    }
+
+    Refresh();
+    if (removed_existing) {
+        return InstallResult::OverwriteExisting;
+    }
+    return InstallResult::Success;
+}
+
+InstallResult RegisteredCache::InstallEntry(const NCA& nca, TitleType type,
+                                            bool overwrite_if_exists, const VfsCopyFunction& copy) {
+    NcaID id{};
+    if (!RawInstallStandaloneMeta(nca, type, id)) {
+        return InstallResult::ErrorMetaFailed;
+    }
+    return RawInstallNCA(nca, copy, overwrite_if_exists, id);
+}
+
+InstallResult RegisteredCache::InstallEntry(const NCA& nca, TitleType type,
+                                            bool overwrite_if_exists,
+                                            const InstallProgressCallback& callback) {
+    NcaID id{};
+    if (!RawInstallStandaloneMeta(nca, type, id)) {
+        return InstallResult::ErrorMetaFailed;
+    }
+    const std::array jobs{InstallJob{nca.GetBaseFile(), id, std::nullopt}};
+    return RawInstallNCAs(jobs, overwrite_if_exists, callback);
+}
+
+InstallResult RegisteredCache::InstallEntry(const NCA& nca, const CNMTHeader& base_header,
+                                            const ContentRecord& base_record,
+                                            bool overwrite_if_exists, const VfsCopyFunction& copy) {
+    if (!RawInstallMultiProgramMeta(nca, base_header, base_record)) {
+        return InstallResult::ErrorMetaFailed;
+    }
+    return RawInstallNCA(nca, copy, overwrite_if_exists, base_record.nca_id);
+}
+
+InstallResult RegisteredCache::PrepareInstall(const NSP& nsp, std::vector<InstallJob>& out_jobs,
+                                              bool& out_removed_existing) {
     const auto ncas = nsp.GetNCAsCollapsed();
     const auto meta_iter = std::find_if(ncas.begin(), ncas.end(), [](const auto& nca) {
         return nca->GetType() == NCAContentType::Meta;
@@ -605,13 +822,10 @@ InstallResult RegisteredCache::InstallEntry(const NSP& nsp, bool overwrite_if_ex
         return InstallResult::ErrorBaseInstall;
     }
 
-    const auto result = RemoveExistingEntry(title_id);
+    out_removed_existing = RemoveExistingEntry(title_id);
 
     // Install Metadata File
-    const auto meta_result = RawInstallNCA(**meta_iter, copy, overwrite_if_exists, meta_id_data);
-    if (meta_result != InstallResult::Success) {
-        return meta_result;
-    }
+    out_jobs.push_back({(*meta_iter)->GetBaseFile(), meta_id_data, std::nullopt});
 
     // Install all the other NCAs
     for (const auto& record : cnmt.GetContentRecords()) {
@@ -626,28 +840,17 @@ InstallResult RegisteredCache::InstallEntry(const NSP& nsp, bool overwrite_if_ex
         if (nca->GetStatus() == Loader::ResultStatus::ErrorMissingBKTRBaseRomFS &&
             nca->GetTitleId() != title_id) {
             // Create fake cnmt for patch to multiprogram application
-            const auto sub_nca_result =
-                InstallEntry(*nca, cnmt.GetHeader(), record, overwrite_if_exists, copy);
-            if (sub_nca_result != InstallResult::Success) {
-                return sub_nca_result;
+            if (!RawInstallMultiProgramMeta(*nca, cnmt.GetHeader(), record)) {
+                return InstallResult::ErrorMetaFailed;
             }
-            continue;
-        }
-        const auto nca_result = RawInstallNCA(*nca, copy, overwrite_if_exists, record.nca_id);
-        if (nca_result != InstallResult::Success) {
-            return nca_result;
         }
+        out_jobs.push_back({nca->GetBaseFile(), record.nca_id, record.hash});
     }
 
-    Refresh();
-    if (result) {
-        return InstallResult::OverwriteExisting;
-    }
     return InstallResult::Success;
 }
 
-InstallResult RegisteredCache::InstallEntry(const NCA& nca, TitleType type,
-                                            bool overwrite_if_exists, const VfsCopyFunction& copy) {
+bool RegisteredCache::RawInstallStandaloneMeta(const NCA& nca, TitleType type, NcaID& out_id) {
     const CNMTHeader header{
         .title_id = nca.GetTitleId(),
         .title_version = 0,
@@ -668,15 +871,12 @@ InstallResult RegisteredCache::InstallEntry(const NCA& nca, TitleType type,
     mbedtls_sha256_ret(data.data(), data.size(), c_rec.hash.data(), 0);
     std::memcpy(&c_rec.nca_id, &c_rec.hash, 16);
     const CNMT new_cnmt(header, opt_header, {c_rec}, {});
-    if (!RawInstallYuzuMeta(new_cnmt)) {
-        return InstallResult::ErrorMetaFailed;
-    }
-    return RawInstallNCA(nca, copy, overwrite_if_exists, c_rec.nca_id);
+    out_id = c_rec.nca_id;
+    return RawInstallYuzuMeta(new_cnmt);
 }
 
-InstallResult RegisteredCache::InstallEntry(const NCA& nca, const CNMTHeader& base_header,
-                                            const ContentRecord& base_record,
-                                            bool overwrite_if_exists, const VfsCopyFunction& copy) {
+bool RegisteredCache::RawInstallMultiProgramMeta(const NCA& nca, const CNMTHeader& base_header,
+                                                 const ContentRecord& base_record) {
     const CNMTHeader header{
         .title_id = nca.GetTitleId(),
         .title_version = base_header.title_version,
@@ -693,10 +893,7 @@ InstallResult RegisteredCache::InstallEntry(const NCA& nca, const CNMTHeader& ba
     };
     const OptionalHeader opt_header{0, 0};
     const CNMT new_cnmt(header, opt_header, {base_record}, {});
-    if (!RawInstallYuzuMeta(new_cnmt)) {
-        return InstallResult::ErrorMetaFailed;
-    }
-    return RawInstallNCA(nca, copy, overwrite_if_exists, base_record.nca_id);
+    return RawInstallYuzuMeta(new_cnmt);
 }
 
 bool RegisteredCache::RemoveExistingEntry(u64 title_id) const {
@@ -780,6 +977,17 @@ InstallResult RegisteredCache::RawInstallNCA(const NCA& nca, const VfsCopyFuncti
         memcpy(id.data(), hash.data(), 16);
     }
 
+    VirtualFile out;
+    const auto open_result = OpenInstallTarget(id, overwrite_if_exists, out);
+    if (open_result != InstallResult::Success) {
+        return open_result;
+    }
+    return copy(in, out, VFS_RC_LARGE_COPY_BLOCK) ? InstallResult::Success
+                                                  : InstallResult::ErrorCopyFailed;
+}
+
+InstallResult RegisteredCache::OpenInstallTarget(const NcaID& id, bool overwrite_if_exists,
+                                                 VirtualFile& out) {
     std::string path = GetRelativePathFromNcaID(id, false, true, false);
 
     if (GetFileAtID(id) != nullptr && !overwrite_if_exists) {
@@ -794,12 +1002,105 @@ InstallResult RegisteredCache::RawInstallNCA(const NCA& nca, const VfsCopyFuncti
         c_dir->DeleteFile(Common::FS::GetFilename(path));
     }
 
-    auto out = dir->CreateFileRelative(path);
+    out = dir->CreateFileRelative(path);
     if (out == nullptr) {
         return InstallResult::ErrorCopyFailed;
     }
-    return copy(in, out, VFS_RC_LARGE_COPY_BLOCK) ? InstallResult::Success
-                                                  : InstallResult::ErrorCopyFailed;
+    return InstallResult::Success;
+}
+
+InstallResult RegisteredCache::RawInstallNCAs(std::span<const InstallJob> jobs,
+                                              bool overwrite_if_exists,
+                                              const InstallProgressCallback& callback) {
+    using namespace Common::Literals;
+    using namespace std::chrono_literals;
+
+    std::vector<VirtualFile> outs(jobs.size());
+    size_t total_size = 0;
+    for (size_t i = 0; i < jobs.size(); ++i) {
+        const auto open_result = OpenInstallTarget(jobs[i].id, overwrite_if_exists, outs[i]);
+        if (open_result != InstallResult::Success) {
+            return open_result;
+        }
+        total_size += jobs[i].file->GetSize();
+    }
+
+    std::atomic<size_t> progress{0};
+    std::atomic<bool> cancel{false};
+    std::atomic<size_t> next_job{0};
+    std::vector<u8> succeeded(jobs.size());
+    Common::Event finished_event;
+
+    const size_t num_workers = std::min(jobs.size(), INSTALL_MAX_CONCURRENT_NCAS);
+    std::atomic<size_t> num_running{num_workers};
+    const auto start_time = std::chrono::steady_clock::now();
+
+    std::vector<std::jthread> workers;
+    workers.reserve(num_workers);
+    for (size_t worker = 0; worker < num_workers; ++worker) {
+        workers.emplace_back([&] {
+            Common::SetCurrentThreadName("NCAInstall");
+            for (size_t i = next_job++; i < jobs.size() && !cancel; i = next_job++) {
+                const auto& job = jobs[i];
+                Core::Crypto::SHA256Hash hash{};
+                if (!PipelinedCopy(job.file, outs[i], job.hash.has_value(), hash, progress,
+                                   cancel)) {
+                    // A single failed NCA aborts the whole install.
+                    cancel = true;
+                    break;
+                }
+                succeeded[i] = 1;
+                if (job.hash && hash != *job.hash) {
+                    LOG_WARNING(Loader, "NCA {} does not match the hash in its content record",
+                                Common::HexToString(job.id, false));
+                }
+            }
+            if (--num_running == 0) {
+                finished_event.Set();
+            }
+        });
+    }
+
+    // Report progress from this thread only, frontends may not be able to receive callbacks from
+    // the worker threads.
+    size_t reported = 0;
+    auto last_log_time = start_time;
+    bool is_finished = num_workers == 0;
+    while (!is_finished) {
+        is_finished = finished_event.WaitFor(10ms);
+
+        const size_t installed = progress.load();
+        while (!cancel && reported < installed) {
+            if (callback && callback(total_size, reported)) {
+                cancel = true;
+            }
+            reported += 1_MiB;
+        }
+
+        const auto now = std::chrono::steady_clock::now();
+        if (now - last_log_time >= 1s) {
+            const double seconds = std::chrono::duration<double>(now - start_time).count();
+            LOG_DEBUG(Loader, "Installed {} of {} bytes, {:.0f} bytes/s", installed, total_size,
+                      static_cast<double>(installed) / seconds);
+            last_log_time = now;
+        }
+    }
+    workers.clear();
+
+    if (cancel) {
+        for (size_t i = 0; i < jobs.size(); ++i) {
+            if (!succeeded[i]) {
+                outs[i]->Resize(0);
+            }
+        }
+        return InstallResult::ErrorCopyFailed;
+    }
+
+    const double seconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+    LOG_INFO(Loader, "Installed {} NCAs ({} bytes) in {:.2f}s, {:.0f} bytes/s", jobs.size(),
+             total_size, seconds, seconds > 0 ? static_cast<double>(total_size) / seconds : 0.0);
+    return InstallResult::Success;
 }
 
 bool RegisteredCache::RawInstallYuzuMeta(const CNMT& cnmt) {
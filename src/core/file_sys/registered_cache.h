@@ -6,6 +6,8 @@
 #include <array>
 #include <functional>
 #include <memory>
+#include <optional>
+#include <span>
 #include <string>
 #include <vector>
 #include <boost/container/flat_map.hpp>
@@ -31,6 +33,9 @@ class RegisteredCache;
 using NcaID = std::array<u8, 0x10>;
 using ContentProviderParsingFunction = std::function<VirtualFile(const VirtualFile&, const NcaID&)>;
 using VfsCopyFunction = std::function<bool(const VirtualFile&, const VirtualFile&, size_t)>;
+// Receives the total and installed byte counts of an install, once for every installed MiB.
+// Returning true cancels the install.
+using InstallProgressCallback = std::function<bool(size_t, size_t)>;
 
 enum class InstallResult {
     Success,
@@ -163,12 +168,23 @@ public:
     InstallResult InstallEntry(const NSP& nsp, bool overwrite_if_exists = false,
                                const VfsCopyFunction& copy = &VfsRawCopy);
 
+    // Same as above, but the NCAs are copied by the pipelined installer: independent NCAs are
+    // installed concurrently, reading, hashing and writing of each NCA overlap, and every NCA is
+    // checked against the SHA-256 in its content record while it is being copied. The callback
+    // is only ever invoked from the calling thread.
+    InstallResult InstallEntry(const XCI& xci, bool overwrite_if_exists,
+                               const InstallProgressCallback& callback);
+    InstallResult InstallEntry(const NSP& nsp, bool overwrite_if_exists,
+                               const InstallProgressCallback& callback);
+
     // Due to the fact that we must use Meta-type NCAs to determine the existence of files, this
     // poses quite a challenge. Instead of creating a new meta NCA for this file, yuzu will create a
     // dir inside the NAND called 'yuzu_meta' and store the raw CNMT there.
     // TODO(DarkLordZach): Author real meta-type NCAs and install those.
     InstallResult InstallEntry(const NCA& nca, TitleType type, bool overwrite_if_exists = false,
                                const VfsCopyFunction& copy = &VfsRawCopy);
+    InstallResult InstallEntry(const NCA& nca, TitleType type, bool overwrite_if_exists,
+                               const InstallProgressCallback& callback);
 
     InstallResult InstallEntry(const NCA& nca, const CNMTHeader& base_header,
                                const ContentRecord& base_record, bool overwrite_if_exists = false,
@@ -178,6 +194,12 @@ public:
     bool RemoveExistingEntry(u64 title_id) const;
 
 private:
+    struct InstallJob {
+        VirtualFile file;
+        NcaID id;
+        std::optional<Core::Crypto::SHA256Hash> hash;
+    };
+
     template <typename T>
     void IterateAllMetadata(std::vector<T>& out,
                             std::function<T(const CNMT&, const ContentRecord&)> proc,
@@ -188,8 +210,16 @@ private:
     std::optional<NcaID> GetNcaIDFromMetadata(u64 title_id, ContentRecordType type) const;
     VirtualFile GetFileAtID(NcaID id) const;
     VirtualFile OpenFileOrDirectoryConcat(const VirtualDir& open_dir, std::string_view path) const;
+    InstallResult PrepareInstall(const NSP& nsp, std::vector<InstallJob>& out_jobs,
+                                 bool& out_removed_existing);
+    bool RawInstallStandaloneMeta(const NCA& nca, TitleType type, NcaID& out_id);
+    bool RawInstallMultiProgramMeta(const NCA& nca, const CNMTHeader& base_header,
+                                    const ContentRecord& base_record);
+    InstallResult OpenInstallTarget(const NcaID& id, bool overwrite_if_exists, VirtualFile& out);
     InstallResult RawInstallNCA(const NCA& nca, const VfsCopyFunction& copy,
                                 bool overwrite_if_exists, std::optional<NcaID> override_id = {});
+    InstallResult RawInstallNCAs(std::span<const InstallJob> jobs, bool overwrite_if_exists,
+                                 const InstallProgressCallback& callback);
     bool RawInstallYuzuMeta(const CNMT& cnmt);
 
     VirtualDir dir;
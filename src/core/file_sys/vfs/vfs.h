@@ -7,6 +7,7 @@
 #include <map>
 #include <memory>
 #include <optional>
+#include <span>
 #include <string>
 #include <type_traits>
 #include <vector>
@@ -117,6 +118,10 @@ public:
     // Reads all the bytes from the file into a vector. Equivalent to 'file->Read(file->GetSize(),
     // 0)'
     virtual std::vector<u8> ReadAllBytes() const;
+    // Returns the contents of the file when they already reside in host memory that stays valid
+    // for the lifetime of the file, allowing callers to copy from it without an intermediate
+    // buffer. Returns an empty span otherwise.
+    virtual std::span<const u8> GetMappedView() const;
 
     // Reads an array of type T, size number_elements starting at offset.
     // Returns the number of bytes (sizeof(T)*number_elements) read successfully.
@@ -0,0 +1,63 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+#include "core/file_sys/vfs/vfs_mapped.h"
+
+namespace FileSys {
+
+MappedVfsFile::MappedVfsFile(Common::FS::MappedFile file_, std::string name_, VirtualDir parent_)
+    : file(std::move(file_)), name(std::move(name_)), parent(std::move(parent_)) {}
+
+MappedVfsFile::~MappedVfsFile() = default;
+
+std::string MappedVfsFile::GetName() const {
+    return name;
+}
+
+std::size_t MappedVfsFile::GetSize() const {
+    return file.Size();
+}
+
+bool MappedVfsFile::Resize(std::size_t new_size) {
+    return false;
+}
+
+VirtualDir MappedVfsFile::GetContainingDirectory() const {
+    return parent;
+}
+
+bool MappedVfsFile::IsWritable() const {
+    return false;
+}
+
+bool MappedVfsFile::IsReadable() const {
+    return true;
+}
+
+std::size_t MappedVfsFile::Read(u8* data, std::size_t length, std::size_t offset) const {
+    const auto view = file.Data();
+    if (offset >= view.size()) {
+        return 0;
+    }
+    const auto read = std::min(length, view.size() - offset);
+    std::memcpy(data, view.data() + offset, read);
+    return read;
+}
+
+std::size_t MappedVfsFile::Write(const u8* data, std::size_t length, std::size_t offset) {
+    return 0;
+}
+
+bool MappedVfsFile::Rename(std::string_view new_name) {
+    return false;
+}
+
+std::span<const u8> MappedVfsFile::GetMappedView() const {
+    return file.Data();
+}
+
+} // namespace FileSys
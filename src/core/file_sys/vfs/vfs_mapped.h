@@ -0,0 +1,39 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <string>
+
+#include "common/fs/mapped_file.h"
+#include "core/file_sys/vfs/vfs.h"
+
+namespace FileSys {
+
+// An implementation of VfsFile that serves reads from a read-only memory mapping of a file on the
+// user's computer. Reads are plain copies out of the mapping and GetMappedView exposes it
+// directly.
+class MappedVfsFile : public VfsFile {
+public:
+    explicit MappedVfsFile(Common::FS::MappedFile file_, std::string name_,
+                           VirtualDir parent_ = nullptr);
+    ~MappedVfsFile() override;
+
+    std::string GetName() const override;
+    std::size_t GetSize() const override;
+    bool Resize(std::size_t new_size) override;
+    VirtualDir GetContainingDirectory() const override;
+    bool IsWritable() const override;
+    bool IsReadable() const override;
+    std::size_t Read(u8* data, std::size_t length, std::size_t offset) const override;
+    std::size_t Write(const u8* data, std::size_t length, std::size_t offset) override;
+    bool Rename(std::string_view name) override;
+    std::span<const u8> GetMappedView() const override;
+
+private:
+    Common::FS::MappedFile file;
+    std::string name;
+    VirtualDir parent;
+};
+
+} // namespace FileSys
@@ -71,6 +71,14 @@ std::vector<u8> OffsetVfsFile::ReadAllBytes() const {
     return file->ReadBytes(size, offset);
 }
 
+std::span<const u8> OffsetVfsFile::GetMappedView() const {
+    const auto view = file->GetMappedView();
+    if (view.size() < offset + size) {
+        return {};
+    }
+    return view.subspan(offset, size);
+}
+
 bool OffsetVfsFile::WriteByte(u8 data, std::size_t r_offset) {
     if (r_offset < size)
         return file->WriteByte(data, offset + r_offset);
@@ -2,15 +2,23 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include <algorithm>
+#include <condition_variable>
 #include <cstddef>
+#include <cstring>
+#include <filesystem>
 #include <iterator>
 #include <utility>
 #include "common/assert.h"
 #include "common/fs/file.h"
 #include "common/fs/fs.h"
+#include "common/fs/mapped_file.h"
 #include "common/fs/path_util.h"
 #include "common/logging/log.h"
+#include "common/settings.h"
+#include "common/thread_worker.h"
+#include "core/file_sys/fssystem/fssystem_pooled_buffer.h"
 #include "core/file_sys/vfs/vfs.h"
+#include "core/file_sys/vfs/vfs_mapped.h"
 #include "core/file_sys/vfs/vfs_real.h"
 
 // For FileTimeStampRaw
@@ -32,6 +40,28 @@ namespace {
 
 constexpr size_t MaxOpenFiles = 512;
 
+// Read-only files at least this large may be memory mapped instead of read through IOFile, see
+// Settings::values.map_read_only_files. Otherwise large files are served by read-ahead.
+constexpr u64 MinimumMappedFileSize = 1_MiB;
+
+// A mapping faults when the file is truncated by another process, so only files nobody is
+// allowed to write to are mapped. Windows refuses to truncate a file that has a mapped view.
+bool CanMapFile(const std::string& path) {
+#ifdef _WIN32
+    return true;
+#else
+    namespace fs = std::filesystem;
+    std::error_code ec;
+    const auto status = fs::status(path, ec);
+    if (ec) {
+        return false;
+    }
+    constexpr auto write_perms = fs::perms::owner_write | fs::perms::group_write |
+                                 fs::perms::others_write;
+    return (status.permissions() & write_perms) == fs::perms::none;
+#endif
+}
+
 constexpr FS::FileAccessMode ModeFlagsToFileAccessMode(OpenMode mode) {
     switch (mode) {
     case OpenMode::Read:
@@ -91,6 +121,13 @@ VirtualFile RealVfsFilesystem::OpenFileFromEntry(std::string_view path_, std::op
         return nullptr;
     }
 
+    if (perms == OpenMode::Read && Settings::values.map_read_only_files.GetValue()) {
+        if (auto file = this->OpenMappedFileLocked(path, size, parent_path); file) {
+            cache[path] = file;
+            return file;
+        }
+    }
+
     auto reference = std::make_unique<FileReference>();
     this->InsertReferenceIntoListLocked(*reference);
 
@@ -101,6 +138,34 @@ VirtualFile RealVfsFilesystem::OpenFileFromEntry(std::string_view path_, std::op
     return file;
 }
 
+VirtualFile RealVfsFilesystem::OpenMappedFileLocked(const std::string& path,
+                                                    std::optional<u64> size,
+                                                    const std::optional<std::string>& parent_path) {
+#ifdef ANDROID
+    // Content URIs can't be mapped by path.
+    if (path[0] != '/') {
+        return nullptr;
+    }
+#endif
+    if (size.value_or(0) == 0) {
+        size = FS::GetSize(path);
+    }
+    if (*size < MinimumMappedFileSize || !CanMapFile(path)) {
+        return nullptr;
+    }
+
+    FS::MappedFile mapped_file{path};
+    if (!mapped_file.IsOpen()) {
+        return nullptr;
+    }
+
+    auto parent = std::shared_ptr<RealVfsDirectory>(
+        new RealVfsDirectory(*this, parent_path ? *parent_path : FS::GetParentPath(path),
+                             OpenMode::Read));
+    return std::make_shared<MappedVfsFile>(std::move(mapped_file),
+                                           std::string(FS::GetFilename(path)), std::move(parent));
+}
+
 VirtualFile RealVfsFilesystem::OpenFile(std::string_view path_, OpenMode perms) {
     return OpenFileFromEntry(path_, {}, {}, perms);
 }
@@ -268,14 +333,63 @@ void RealVfsFilesystem::RemoveReferenceFromListLocked(FileReference& reference)
     }
 }
 
+namespace {
+// Size of a read-ahead window, the largest regular pooled buffer.
+constexpr std::size_t ReadAheadSize = 512_KiB;
+
+// Number of back to back sequential reads before read-ahead kicks in.
+constexpr u32 SequentialReadsForReadAhead = 2;
+
+Common::ThreadWorker& GetReadAheadWorkers() {
+    static Common::ThreadWorker workers(2, "VfsReadAhead");
+    return workers;
+}
+} // Anonymous namespace
+
+struct RealVfsFile::ReadAheadState {
+    std::mutex mutex;
+    std::condition_variable prefetch_done;
+    PooledBuffer buffer;
+    std::size_t buffer_offset{};
+    std::size_t buffer_size{};
+    std::size_t next_offset{};
+    u32 sequential_reads{};
+    bool prefetch_pending{};
+
+    u64 num_reads{};
+    u64 num_prefetches{};
+    u64 num_prefetch_hits{};
+    u64 requested_bytes{};
+    u64 disk_bytes{};
+};
+
 RealVfsFile::RealVfsFile(RealVfsFilesystem& base_, std::unique_ptr<FileReference> reference_,
                          const std::string& path_, OpenMode perms_, std::optional<u64> size_,
                          std::optional<std::string> parent_path_)
     : base(base_), reference(std::move(reference_)), path(path_),
       parent_path(parent_path_ ? std::move(*parent_path_) : FS::GetParentPath(path_)),
-      path_components(FS::SplitPathComponentsCopy(path_)), size(size_), perms(perms_) {}
+      path_components(FS::SplitPathComponentsCopy(path_)), size(size_), perms(perms_) {
+    if (!IsWritable()) {
+        read_ahead = std::make_unique<ReadAheadState>();
+    }
+}
 
 RealVfsFile::~RealVfsFile() {
+    if (read_ahead) {
+        std::unique_lock lk{read_ahead->mutex};
+        read_ahead->prefetch_done.wait(lk, [this] { return !read_ahead->prefetch_pending; });
+
+        const auto& state = *read_ahead;
+        if (state.num_prefetches != 0) {
+            LOG_DEBUG(Service_FS,
+                      "{}: {} reads, {:.2f}x read amplification, {:.1f}% prefetch hit rate",
+                      GetName(), state.num_reads,
+                      static_cast<double>(state.disk_bytes) /
+                          static_cast<double>(std::max<u64>(state.requested_bytes, 1)),
+                      100.0 * static_cast<double>(state.num_prefetch_hits) /
+                          static_cast<double>(state.num_reads));
+        }
+    }
     base.DropReference(std::move(reference));
 }
 
@@ -315,6 +429,48 @@ bool RealVfsFile::IsReadable() const {
 }
 
 std::size_t RealVfsFile::Read(u8* data, std::size_t length, std::size_t offset) const {
+    if (!read_ahead) {
+        return ReadFromDisk(data, length, offset);
+    }
+
+    auto& state = *read_ahead;
+    std::scoped_lock lk{state.mutex};
+    ++state.num_reads;
+    state.requested_bytes += length;
+
+    if (offset == state.next_offset) {
+        ++state.sequential_reads;
+    } else {
+        state.sequential_reads = 0;
+    }
+    state.next_offset = offset + length;
+
+    // Serve as much as possible from the read-ahead buffer.
+    std::size_t copied = 0;
+    const std::size_t buffer_end = state.buffer_offset + state.buffer_size;
+    if (offset >= state.buffer_offset && offset < buffer_end) {
+        copied = std::min(length, buffer_end - offset);
+        std::memcpy(data, state.buffer.GetBuffer() + (offset - state.buffer_offset), copied);
+        ++state.num_prefetch_hits;
+    }
+
+    // Keep at least half a window buffered ahead of sequential readers.
+    const std::size_t end_offset = offset + length;
+    const bool runs_low = end_offset >= buffer_end || buffer_end - end_offset < ReadAheadSize / 2;
+    if (state.sequential_reads >= SequentialReadsForReadAhead && runs_low &&
+        !state.prefetch_pending) {
+        QueueReadAhead(end_offset);
+    }
+
+    if (copied == length) {
+        return copied;
+    }
+    const std::size_t read_size = ReadFromDisk(data + copied, length - copied, offset + copied);
+    state.disk_bytes += read_size;
+    return copied + read_size;
+}
+
+std::size_t RealVfsFile::ReadFromDisk(u8* data, std::size_t length, std::size_t offset) const {
     auto lk = base.RefreshReference(path, perms, *reference);
     if (!reference->file || !reference->file->Seek(static_cast<s64>(offset))) {
         return 0;
@@ -322,6 +478,32 @@ std::size_t RealVfsFile::Read(u8* data, std::size_t length, std::size_t offset)
     return reference->file->ReadSpan(std::span{data, length});
 }
 
+void RealVfsFile::QueueReadAhead(std::size_t offset) const {
+    const std::size_t file_size = GetSize();
+    if (offset >= file_size) {
+        return;
+    }
+    const std::size_t prefetch_size = std::min(ReadAheadSize, file_size - offset);
+
+    // The destructor waits for pending prefetches, so the file outlives the task.
+    read_ahead->prefetch_pending = true;
+    ++read_ahead->num_prefetches;
+    GetReadAheadWorkers().QueueWork([this, offset, prefetch_size] {
+        PooledBuffer buffer(prefetch_size, prefetch_size);
+        const std::size_t read_size =
+            ReadFromDisk(reinterpret_cast<u8*>(buffer.GetBuffer()), prefetch_size, offset);
+
+        auto& state = *read_ahead;
+        std::scoped_lock lk{state.mutex};
+        state.buffer = std::move(buffer);
+        state.buffer_offset = offset;
+        state.buffer_size = read_size;
+        state.disk_bytes += read_size;
+        state.prefetch_pending = false;
+        state.prefetch_done.notify_all();
+    });
+}
+
 std::size_t RealVfsFile::Write(const u8* data, std::size_t length, std::size_t offset) {
     size.reset();
     auto lk = base.RefreshReference(path, perms, *reference);
@@ -64,6 +64,9 @@ private:
     VirtualFile OpenFileFromEntry(std::string_view path, std::optional<u64> size,
                                   std::optional<std::string> parent_path,
                                   OpenMode perms = OpenMode::Read);
+    /// Maps large read-only files that can't change underneath, read-ahead is skipped for them.
+    VirtualFile OpenMappedFileLocked(const std::string& path, std::optional<u64> size,
+                                     const std::optional<std::string>& parent_path);
 
 private:
     void EvictSingleReferenceLocked();
@@ -94,8 +97,15 @@ private:
                 const std::string& path, OpenMode perms = OpenMode::Read,
                 std::optional<u64> size = {}, std::optional<std::string> parent_path = {});
 
+    std::size_t ReadFromDisk(u8* data, std::size_t length, std::size_t offset) const;
+    void QueueReadAhead(std::size_t offset) const;
+
+    // Sequential access detection and the background read-ahead buffer, read-only files only.
+    struct ReadAheadState;
+
     RealVfsFilesystem& base;
     std::unique_ptr<FileReference> reference;
+    std::unique_ptr<ReadAheadState> read_ahead;
     std::string path;
     std::string parent_path;
     std::vector<std::string> path_components;
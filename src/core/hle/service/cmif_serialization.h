@@ -239,7 +239,12 @@ constexpr RequestLayout GetReplyOutLayout(bool is_domain) {
     return is_domain ? GetDomainReplyOutLayout<MethodArguments>() : GetNonDomainReplyOutLayout<MethodArguments>();
 }
 
-using OutTemporaryBuffers = std::array<Common::ScratchBuffer<u8>, 3>;
+// Output buffers that can be written directly in guest memory are passed to the handler as they
+// are. The others are staged in scratch buffers and written back after the handler returns.
+struct OutTemporaryBuffers {
+    std::array<Common::ScratchBuffer<u8>, 3> staging{};
+    std::array<bool, 3> is_direct{};
+};
 
 template <typename MethodArguments, typename CallArguments, size_t PrevAlign = 1, size_t DataOffset = 0, size_t HandleIndex = 0, size_t InBufferIndex = 0, size_t OutBufferIndex = 0, bool RawDataFinished = false, size_t ArgIndex = 0>
 void ReadInArgument(bool is_domain, CallArguments& args, const u8* raw_data, HLERequestContext& ctx, OutTemporaryBuffers& temp) {
@@ -338,16 +343,32 @@ void ReadInArgument(bool is_domain, CallArguments& args, const u8* raw_data, HLE
         } else if constexpr (ArgumentTraits<ArgType>::Type == ArgumentType::OutBuffer) {
             using ElementType = typename ArgType::Type;
 
-            // Set up scratch buffer.
-            auto& buffer = temp[OutBufferIndex];
+            std::span<u8> direct{};
             if (ctx.CanWriteBuffer(OutBufferIndex)) {
+                if constexpr (ArgType::Attr & BufferAttr_HipcAutoSelect) {
+                    direct = ctx.GetWriteBufferSpan(OutBufferIndex);
+                } else if constexpr (ArgType::Attr & BufferAttr_HipcMapAlias) {
+                    direct = ctx.GetWriteBufferSpanB(OutBufferIndex);
+                } else /* if (ArgType::Attr & BufferAttr_HipcPointer) */ {
+                    direct = ctx.GetWriteBufferSpanC(OutBufferIndex);
+                }
+            }
+            if (reinterpret_cast<uintptr_t>(direct.data()) % alignof(ElementType) != 0) {
+                // Handlers access the buffer as ElementType, stage guest buffers not aligned for it
+                direct = {};
+            }
+            temp.is_direct[OutBufferIndex] = !direct.empty();
+
+            // Set up scratch buffer if the guest buffer cannot be written directly.
+            auto& buffer = temp.staging[OutBufferIndex];
+            if (direct.empty() && ctx.CanWriteBuffer(OutBufferIndex)) {
                 buffer.resize_destructive(ctx.GetWriteBufferSize(OutBufferIndex));
             } else {
                 buffer.resize_destructive(0);
             }
 
-            ElementType* ptr = (ElementType*) buffer.data();
-            size_t size = buffer.size() / sizeof(ElementType);
+            ElementType* ptr = (ElementType*) (direct.empty() ? buffer.data() : direct.data());
+            size_t size = (direct.empty() ? buffer.size() : direct.size()) / sizeof(ElementType);
 
             std::get<ArgIndex>(args) = std::span(ptr, size);
 
@@ -412,10 +433,10 @@ void WriteOutArgument(bool is_domain, CallArguments& args, u8* raw_data, HLERequ
 
             return WriteOutArgument<MethodArguments, CallArguments, PrevAlign, DataOffset, OutBufferIndex + 1, RawDataFinished, ArgIndex + 1>(is_domain, args, raw_data, ctx, temp);
         } else if constexpr (ArgumentTraits<ArgType>::Type == ArgumentType::OutBuffer) {
-            auto& buffer = temp[OutBufferIndex];
+            auto& buffer = temp.staging[OutBufferIndex];
             const size_t size = buffer.size();
 
-            if (size > 0 && ctx.CanWriteBuffer(OutBufferIndex)) {
+            if (!temp.is_direct[OutBufferIndex] && size > 0 && ctx.CanWriteBuffer(OutBufferIndex)) {
                 if constexpr (ArgType::Attr & BufferAttr_HipcAutoSelect) {
                     ctx.WriteBuffer(buffer.data(), size, OutBufferIndex);
                 } else if constexpr (ArgType::Attr & BufferAttr_HipcMapAlias) {
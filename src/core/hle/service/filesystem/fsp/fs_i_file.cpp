@@ -1,6 +1,9 @@
 // SPDX-FileCopyrightText: Copyright 2023 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
+#include <cstring>
+
 #include "core/file_sys/errors.h"
 #include "core/hle/service/cmif_serialization.h"
 #include "core/hle/service/filesystem/fsp/fs_i_file.h"
@@ -30,6 +33,16 @@ Result IFile::Read(
     LOG_DEBUG(Service_FS, "called, option={}, offset=0x{:X}, length={}", option.value, offset,
               size);
 
+    // Memory mapped files are copied straight from the mapping into the guest buffer
+    const size_t length = std::min(static_cast<size_t>(std::max<s64>(size, 0)), out_buffer.size());
+    std::span<const u8> mapped_range;
+    if (R_SUCCEEDED(backend->GetMappedRange(&mapped_range, offset, length)) &&
+        !mapped_range.empty()) {
+        std::memcpy(out_buffer.data(), mapped_range.data(), mapped_range.size());
+        *out_size = static_cast<s64>(mapped_range.size());
+        R_SUCCEED();
+    }
+
     // Read the data from the Storage backend
     R_RETURN(
         backend->Read(reinterpret_cast<size_t*>(out_size.Get()), offset, out_buffer.data(), size));
@@ -152,9 +152,6 @@ void HLERequestContext::ParseCommandBuffer(u32_le* src_cmdbuf, bool incoming) {
         }
         if (incoming) {
             // Populate the object lists with the data in the IPC request.
-            incoming_copy_handles.reserve(handle_descriptor_header->num_handles_to_copy);
-            incoming_move_handles.reserve(handle_descriptor_header->num_handles_to_move);
-
             for (u32 handle = 0; handle < handle_descriptor_header->num_handles_to_copy; ++handle) {
                 incoming_copy_handles.push_back(rp.Pop<Handle>());
             }
@@ -169,11 +166,6 @@ void HLERequestContext::ParseCommandBuffer(u32_le* src_cmdbuf, bool incoming) {
         }
     }
 
-    buffer_x_descriptors.reserve(command_header->num_buf_x_descriptors);
-    buffer_a_descriptors.reserve(command_header->num_buf_a_descriptors);
-    buffer_b_descriptors.reserve(command_header->num_buf_b_descriptors);
-    buffer_w_descriptors.reserve(command_header->num_buf_w_descriptors);
-
     for (u32 i = 0; i < command_header->num_buf_x_descriptors; ++i) {
         buffer_x_descriptors.push_back(rp.PopRaw<IPC::BufferDescriptorX>());
     }
@@ -450,6 +442,64 @@ std::size_t HLERequestContext::WriteBufferC(const void* buffer, std::size_t size
     return size;
 }
 
+std::span<u8> HLERequestContext::GetWriteBufferSpan(std::size_t buffer_index) const {
+    const bool is_buffer_b{BufferDescriptorB().size() > buffer_index &&
+                           BufferDescriptorB()[buffer_index].Size()};
+    if (is_buffer_b) {
+        return GetWriteBufferSpanB(buffer_index);
+    } else {
+        return GetWriteBufferSpanC(buffer_index);
+    }
+}
+
+std::span<u8> HLERequestContext::GetWriteBufferSpanB(std::size_t buffer_index) const {
+    if (buffer_index >= BufferDescriptorB().size()) {
+        return {};
+    }
+
+    const auto& descriptor{BufferDescriptorB()[buffer_index]};
+    if (IsWriteBufferAliased(descriptor.Address(), descriptor.Size())) {
+        // In place handlers would overwrite input they still have to read
+        return {};
+    }
+    u8* const pointer{memory.GetDirectSpan(descriptor.Address(), descriptor.Size())};
+    if (pointer == nullptr) {
+        return {};
+    }
+    return {pointer, descriptor.Size()};
+}
+
+std::span<u8> HLERequestContext::GetWriteBufferSpanC(std::size_t buffer_index) const {
+    if (buffer_index >= BufferDescriptorC().size()) {
+        return {};
+    }
+
+    const auto& descriptor{BufferDescriptorC()[buffer_index]};
+    if (IsWriteBufferAliased(descriptor.Address(), descriptor.Size())) {
+        // In place handlers would overwrite input they still have to read
+        return {};
+    }
+    u8* const pointer{memory.GetDirectSpan(descriptor.Address(), descriptor.Size())};
+    if (pointer == nullptr) {
+        return {};
+    }
+    return {pointer, descriptor.Size()};
+}
+
+bool HLERequestContext::IsWriteBufferAliased(VAddr address, u64 size) const {
+    const auto count = [address, size]<typename Descriptor>(
+                           const IpcDescriptorList<Descriptor>& descriptors) {
+        return CountOverlappingDescriptors<Descriptor>(address, size,
+                                                       {descriptors.data(), descriptors.size()});
+    };
+    if (count(buffer_x_descriptors) != 0 || count(buffer_a_descriptors) != 0 ||
+        count(buffer_w_descriptors) != 0) {
+        return true;
+    }
+    // The output buffer itself is one of the overlapping B or C descriptors
+    return count(buffer_b_descriptors) + count(buffer_c_descriptors) > 1;
+}
+
 std::size_t HLERequestContext::GetReadBufferSize(std::size_t buffer_index) const {
     const bool is_buffer_a{BufferDescriptorA().size() > buffer_index &&
                            BufferDescriptorA()[buffer_index].Size()};
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <array>
 #include <functional>
 #include <memory>
@@ -12,6 +13,9 @@
 #include <type_traits>
 #include <vector>
 
+#include <boost/container/small_vector.hpp>
+#include <boost/container/static_vector.hpp>
+
 #include "common/assert.h"
 #include "common/common_types.h"
 #include "common/concepts.h"
@@ -52,6 +56,24 @@ using Handle = Kernel::Handle;
 
 class HLERequestContext;
 
+/// The 4-bit counts of the command header bound the number of handles and buffer descriptors of a
+/// request, so they are stored inline instead of being allocated for every request.
+constexpr std::size_t MaxIpcDescriptors = 16;
+
+template <typename T>
+using IpcDescriptorList = boost::container::static_vector<T, MaxIpcDescriptors>;
+
+/// Returns the number of non-empty descriptors overlapping the guest range [address, address + size)
+template <typename Descriptor>
+[[nodiscard]] std::size_t CountOverlappingDescriptors(VAddr address, u64 size,
+                                                      std::span<const Descriptor> descriptors) {
+    return static_cast<std::size_t>(
+        std::ranges::count_if(descriptors, [address, size](const Descriptor& descriptor) {
+            return descriptor.Size() != 0 && address < descriptor.Address() + descriptor.Size() &&
+                   descriptor.Address() < address + size;
+        }));
+}
+
 /**
  * Interface implemented by HLE Session handlers.
  * This can be provided to a ServerSession in order to hook into several relevant events
@@ -233,19 +255,19 @@ public:
         return data_payload_offset;
     }
 
-    [[nodiscard]] const std::vector<IPC::BufferDescriptorX>& BufferDescriptorX() const {
+    [[nodiscard]] const IpcDescriptorList<IPC::BufferDescriptorX>& BufferDescriptorX() const {
         return buffer_x_descriptors;
     }
 
-    [[nodiscard]] const std::vector<IPC::BufferDescriptorABW>& BufferDescriptorA() const {
+    [[nodiscard]] const IpcDescriptorList<IPC::BufferDescriptorABW>& BufferDescriptorA() const {
         return buffer_a_descriptors;
     }
 
-    [[nodiscard]] const std::vector<IPC::BufferDescriptorABW>& BufferDescriptorB() const {
+    [[nodiscard]] const IpcDescriptorList<IPC::BufferDescriptorABW>& BufferDescriptorB() const {
         return buffer_b_descriptors;
     }
 
-    [[nodiscard]] const std::vector<IPC::BufferDescriptorC>& BufferDescriptorC() const {
+    [[nodiscard]] const IpcDescriptorList<IPC::BufferDescriptorC>& BufferDescriptorC() const {
         return buffer_c_descriptors;
     }
 
@@ -303,6 +325,20 @@ public:
         }
     }
 
+    /**
+     * Helper function to get a writable view of the output buffer directly in guest memory, using
+     * the appropriate buffer descriptor. Returns an empty span if the buffer is empty, overlaps
+     * another buffer of the request or is not backed by contiguous memory that can be written
+     * without notifying the rasterizer, in which case it must be written with WriteBuffer instead.
+     */
+    [[nodiscard]] std::span<u8> GetWriteBufferSpan(std::size_t buffer_index = 0) const;
+
+    /// Helper function to get a writable view of buffer B, see GetWriteBufferSpan
+    [[nodiscard]] std::span<u8> GetWriteBufferSpanB(std::size_t buffer_index = 0) const;
+
+    /// Helper function to get a writable view of buffer C, see GetWriteBufferSpan
+    [[nodiscard]] std::span<u8> GetWriteBufferSpanC(std::size_t buffer_index = 0) const;
+
     /// Helper function to get the size of the input buffer
     [[nodiscard]] std::size_t GetReadBufferSize(std::size_t buffer_index = 0) const;
 
@@ -394,27 +430,30 @@ private:
 
     void ParseCommandBuffer(u32_le* src_cmdbuf, bool incoming);
 
+    /// Returns true if the output range overlaps an input buffer or another output buffer
+    [[nodiscard]] bool IsWriteBufferAliased(VAddr address, u64 size) const;
+
     std::array<u32, IPC::COMMAND_BUFFER_LENGTH> cmd_buf;
     Kernel::KServerSession* server_session{};
     Kernel::KHandleTable* client_handle_table{};
     Kernel::KThread* thread{};
 
-    std::vector<Handle> incoming_move_handles;
-    std::vector<Handle> incoming_copy_handles;
+    IpcDescriptorList<Handle> incoming_move_handles;
+    IpcDescriptorList<Handle> incoming_copy_handles;
 
-    std::vector<Kernel::KAutoObject*> outgoing_move_objects;
-    std::vector<Kernel::KAutoObject*> outgoing_copy_objects;
-    std::vector<SessionRequestHandlerPtr> outgoing_domain_objects;
+    boost::container::small_vector<Kernel::KAutoObject*, 4> outgoing_move_objects;
+    boost::container::small_vector<Kernel::KAutoObject*, 4> outgoing_copy_objects;
+    boost::container::small_vector<SessionRequestHandlerPtr, 4> outgoing_domain_objects;
 
     std::optional<IPC::CommandHeader> command_header;
     std::optional<IPC::HandleDescriptorHeader> handle_descriptor_header;
     std::optional<IPC::DataPayloadHeader> data_payload_header;
     std::optional<IPC::DomainMessageHeader> domain_message_header;
-    std::vector<IPC::BufferDescriptorX> buffer_x_descriptors;
-    std::vector<IPC::BufferDescriptorABW> buffer_a_descriptors;
-    std::vector<IPC::BufferDescriptorABW> buffer_b_descriptors;
-    std::vector<IPC::BufferDescriptorABW> buffer_w_descriptors;
-    std::vector<IPC::BufferDescriptorC> buffer_c_descriptors;
+    IpcDescriptorList<IPC::BufferDescriptorX> buffer_x_descriptors;
+    IpcDescriptorList<IPC::BufferDescriptorABW> buffer_a_descriptors;
+    IpcDescriptorList<IPC::BufferDescriptorABW> buffer_b_descriptors;
+    IpcDescriptorList<IPC::BufferDescriptorABW> buffer_w_descriptors;
+    IpcDescriptorList<IPC::BufferDescriptorC> buffer_c_descriptors;
 
     u32_le command{};
     u64 pid{};
@@ -1,7 +1,11 @@
 // SPDX-FileCopyrightText: Copyright 2018 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
+#include <bit>
+#include <chrono>
 #include <fmt/format.h>
+#include <fmt/ranges.h>
 #include "common/assert.h"
 #include "common/logging/log.h"
 #include "common/settings.h"
@@ -15,6 +19,10 @@
 
 namespace Service {
 
+/// Command ids below this limit are dispatched by direct indexing. Most services only use those,
+/// the few larger ids fall back to a binary search.
+constexpr u32 DirectDispatchLimit = 512;
+
 /**
  * Creates a function string for logging, complete with the name (or header code, depending
  * on what's passed in) the port name, and all the cmd_buff arguments.
@@ -40,6 +48,7 @@ ServiceFrameworkBase::ServiceFrameworkBase(Core::System& system_, const char* se
 ServiceFrameworkBase::~ServiceFrameworkBase() {
     // Wait for other threads to release access before destroying
     const auto guard = LockService();
+    LogCommandLatencies();
 }
 
 void ServiceFrameworkBase::RegisterHandlersBase(const FunctionInfoBase* functions, std::size_t n) {
@@ -48,6 +57,7 @@ void ServiceFrameworkBase::RegisterHandlersBase(const FunctionInfoBase* function
         // Usually this array is sorted by id already, so hint to insert at the end
         handlers.emplace_hint(handlers.cend(), functions[i].expected_header, functions[i]);
     }
+    BuildDispatchTable(handlers, dispatch_table);
 }
 
 void ServiceFrameworkBase::RegisterHandlersBaseTipc(const FunctionInfoBase* functions,
@@ -58,6 +68,28 @@ void ServiceFrameworkBase::RegisterHandlersBaseTipc(const FunctionInfoBase* func
         handlers_tipc.emplace_hint(handlers_tipc.cend(), functions[i].expected_header,
                                    functions[i]);
     }
+    BuildDispatchTable(handlers_tipc, dispatch_table_tipc);
+}
+
+void ServiceFrameworkBase::BuildDispatchTable(const HandlerMap& map, DispatchTable& table) {
+    // Registering may have moved the handlers, so the table is rebuilt from scratch.
+    table.clear();
+    for (const auto& [command, info] : map) {
+        if (command >= DirectDispatchLimit) {
+            break;
+        }
+        table.resize(command + 1);
+        table[command] = &info;
+    }
+}
+
+const ServiceFrameworkBase::FunctionInfoBase* ServiceFrameworkBase::FindHandler(
+    const HandlerMap& map, const DispatchTable& table, u32 command) {
+    if (command < table.size()) {
+        return table[command];
+    }
+    const auto itr = map.find(command);
+    return itr == map.end() ? nullptr : &itr->second;
 }
 
 void ServiceFrameworkBase::ReportUnimplementedFunction(HLERequestContext& ctx,
@@ -84,28 +116,49 @@ void ServiceFrameworkBase::ReportUnimplementedFunction(HLERequestContext& ctx,
 }
 
 void ServiceFrameworkBase::InvokeRequest(HLERequestContext& ctx) {
-    auto itr = handlers.find(ctx.GetCommand());
-    const FunctionInfoBase* info = itr == handlers.end() ? nullptr : &itr->second;
-    if (info == nullptr || info->handler_callback == nullptr) {
-        return ReportUnimplementedFunction(ctx, info);
-    }
-
-    LOG_TRACE(Service, "{}", MakeFunctionString(info->name, GetServiceName(), ctx.CommandBuffer()));
-    handler_invoker(this, info->handler_callback, ctx);
+    InvokeHandler(ctx, FindHandler(handlers, dispatch_table, ctx.GetCommand()));
 }
 
 void ServiceFrameworkBase::InvokeRequestTipc(HLERequestContext& ctx) {
-    boost::container::flat_map<u32, FunctionInfoBase>::iterator itr;
-
-    itr = handlers_tipc.find(ctx.GetCommand());
+    InvokeHandler(ctx, FindHandler(handlers_tipc, dispatch_table_tipc, ctx.GetCommand()));
+}
 
-    const FunctionInfoBase* info = itr == handlers_tipc.end() ? nullptr : &itr->second;
+void ServiceFrameworkBase::InvokeHandler(HLERequestContext& ctx, const FunctionInfoBase* info) {
     if (info == nullptr || info->handler_callback == nullptr) {
         return ReportUnimplementedFunction(ctx, info);
     }
 
     LOG_TRACE(Service, "{}", MakeFunctionString(info->name, GetServiceName(), ctx.CommandBuffer()));
+    if (!Settings::values.record_service_latency) [[likely]] {
+        handler_invoker(this, info->handler_callback, ctx);
+        return;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
     handler_invoker(this, info->handler_callback, ctx);
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+
+    const u64 elapsed_ns = static_cast<u64>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+    std::scoped_lock lk{latency_mutex};
+    CommandLatency& latency = command_latencies[info];
+    const size_t bucket = std::min<size_t>(std::bit_width(elapsed_ns / 1000),
+                                           latency.histogram.size() - 1);
+    ++latency.histogram[bucket];
+    ++latency.count;
+    latency.total_ns += elapsed_ns;
+    latency.max_ns = std::max(latency.max_ns, elapsed_ns);
+}
+
+void ServiceFrameworkBase::LogCommandLatencies() {
+    std::scoped_lock lk{latency_mutex};
+    for (const auto& [info, latency] : command_latencies) {
+        LOG_INFO(Service, "{}::{} ({}): {} calls, mean {} ns, max {} ns, histogram [{}]",
+                 service_name, info->name, info->expected_header, latency.count,
+                 latency.total_ns / latency.count, latency.max_ns,
+                 fmt::join(latency.histogram, ", "));
+    }
+    command_latencies.clear();
 }
 
 Result ServiceFrameworkBase::HandleSyncRequest(Kernel::KServerSession& session,
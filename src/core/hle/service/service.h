@@ -3,9 +3,11 @@
 
 #pragma once
 
+#include <array>
 #include <cstddef>
 #include <mutex>
 #include <string>
+#include <vector>
 #include <boost/container/flat_map.hpp>
 #include "common/common_types.h"
 #include "core/hle/service/hle_ipc.h"
@@ -97,6 +99,21 @@ private:
     using InvokerFn = void(ServiceFrameworkBase* object, HandlerFnP<ServiceFrameworkBase> member,
                            HLERequestContext& ctx);
 
+    using HandlerMap = boost::container::flat_map<u32, FunctionInfoBase>;
+
+    /// Direct lookup table of the handlers with small command ids, indexed by command id.
+    using DispatchTable = std::vector<const FunctionInfoBase*>;
+
+    /// Latency statistics of a command, recorded when Settings::values.record_service_latency
+    /// is enabled.
+    struct CommandLatency {
+        /// Bucket i counts the calls that took less than 2^i microseconds, the last one the rest.
+        std::array<u64, 16> histogram{};
+        u64 count{};
+        u64 total_ns{};
+        u64 max_ns{};
+    };
+
     explicit ServiceFrameworkBase(Core::System& system_, const char* service_name_,
                                   u32 max_sessions_, InvokerFn* handler_invoker_);
     ~ServiceFrameworkBase() override;
@@ -104,6 +121,13 @@ private:
     void RegisterHandlersBase(const FunctionInfoBase* functions, std::size_t n);
     void RegisterHandlersBaseTipc(const FunctionInfoBase* functions, std::size_t n);
     void ReportUnimplementedFunction(HLERequestContext& ctx, const FunctionInfoBase* info);
+    void InvokeHandler(HLERequestContext& ctx, const FunctionInfoBase* info);
+    void LogCommandLatencies();
+
+    static void BuildDispatchTable(const HandlerMap& map, DispatchTable& table);
+    [[nodiscard]] static const FunctionInfoBase* FindHandler(const HandlerMap& map,
+                                                             const DispatchTable& table,
+                                                             u32 command);
 
     /// Maximum number of concurrent sessions that this service can handle.
     u32 max_sessions;
@@ -114,8 +138,13 @@ private:
 
     /// Function used to safely up-cast pointers to the derived class before invoking a handler.
     InvokerFn* handler_invoker;
-    boost::container::flat_map<u32, FunctionInfoBase> handlers;
-    boost::container::flat_map<u32, FunctionInfoBase> handlers_tipc;
+    HandlerMap handlers;
+    HandlerMap handlers_tipc;
+    DispatchTable dispatch_table;
+    DispatchTable dispatch_table_tipc;
+
+    std::mutex latency_mutex;
+    boost::container::flat_map<const FunctionInfoBase*, CommandLatency> command_latencies;
 
     /// Used to gain exclusive access to the service members, e.g. from CoreTiming thread.
     std::mutex lock_service;
@@ -298,9 +298,32 @@ struct Memory::Impl {
         return user_accessible;
     }
 
+    /**
+     * Returns a host pointer to the given range if it lies within a single page of regular memory,
+     * which is the case for most of the small copies made by HLE services. Returns nullptr if the
+     * range has to be accessed through WalkBlock.
+     */
+    [[nodiscard]] u8* GetSinglePagePointer(u64 vaddr, std::size_t size) const {
+        if ((vaddr & YUZU_PAGEMASK) + size > YUZU_PAGESIZE ||
+            !AddressSpaceContains(*current_page_table, vaddr, size)) {
+            return nullptr;
+        }
+        const uintptr_t pointer = current_page_table->pointers[vaddr >> YUZU_PAGEBITS].Pointer();
+        if (pointer == 0) {
+            return nullptr;
+        }
+        return reinterpret_cast<u8*>(pointer + vaddr);
+    }
+
     template <bool UNSAFE>
     bool ReadBlockImpl(const Common::ProcessAddress src_addr, void* dest_buffer,
                        const std::size_t size) {
+        // The copies of WalkBlock are bounded by the page size, which makes some compilers expand
+        // them into string instructions that are slow for small sizes. Copy directly instead.
+        if (const u8* const src_ptr = GetSinglePagePointer(GetInteger(src_addr), size)) {
+            std::memcpy(dest_buffer, src_ptr, size);
+            return true;
+        }
         return WalkBlock(
             src_addr, size,
             [src_addr, size, &dest_buffer](const std::size_t copy_amount,
@@ -351,9 +374,33 @@ struct Memory::Impl {
         return nullptr;
     }
 
+    u8* GetDirectSpan(const VAddr vaddr, const std::size_t size) {
+        if (size == 0 || !AddressSpaceContains(*current_page_table, vaddr, size)) {
+            return nullptr;
+        }
+
+        // Only regular memory pages store a pointer, and contiguous pages store the same one.
+        const u64 first_page = vaddr >> YUZU_PAGEBITS;
+        const u64 last_page = (vaddr + size - 1) >> YUZU_PAGEBITS;
+        const uintptr_t pointer = current_page_table->pointers[first_page].Pointer();
+        if (pointer == 0) {
+            return nullptr;
+        }
+        for (u64 page = first_page + 1; page <= last_page; ++page) {
+            if (current_page_table->pointers[page].Pointer() != pointer) {
+                return nullptr;
+            }
+        }
+        return reinterpret_cast<u8*>(pointer + vaddr);
+    }
+
     template <bool UNSAFE>
     bool WriteBlockImpl(const Common::ProcessAddress dest_addr, const void* src_buffer,
                         const std::size_t size) {
+        if (u8* const dest_ptr = GetSinglePagePointer(GetInteger(dest_addr), size)) {
+            std::memcpy(dest_ptr, src_buffer, size);
+            return true;
+        }
         return WalkBlock(
             dest_addr, size,
             [dest_addr, size](const std::size_t copy_amount,
@@ -1033,6 +1080,10 @@ u8* Memory::GetSpan(const VAddr src_addr, const std::size_t size) {
     return impl->GetSpan(src_addr, size);
 }
 
+u8* Memory::GetDirectSpan(const VAddr vaddr, const std::size_t size) {
+    return impl->GetDirectSpan(vaddr, size);
+}
+
 bool Memory::WriteBlock(const Common::ProcessAddress dest_addr, const void* src_buffer,
                         const std::size_t size) {
     return impl->WriteBlock(dest_addr, src_buffer, size);
@@ -371,6 +371,19 @@ public:
     const u8* GetSpan(const VAddr src_addr, const std::size_t size) const;
     u8* GetSpan(const VAddr src_addr, const std::size_t size);
 
+    /**
+     * Gets a host pointer to a range of the current process' address space that can be written
+     * directly. Unlike GetSpan, this rejects ranges containing pages that are tracked by the
+     * rasterizer or the debugger, as writes to those have to go through WriteBlock.
+     *
+     * @param vaddr The virtual address of the beginning of the range.
+     * @param size  The size of the range in bytes.
+     *
+     * @returns A pointer to the whole range if it is backed by contiguous regular memory,
+     *          otherwise nullptr.
+     */
+    u8* GetDirectSpan(VAddr vaddr, std::size_t size);
+
     /**
      * Writes a range of bytes into the current process' address space at the specified
      * virtual address.
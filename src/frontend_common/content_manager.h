@@ -5,7 +5,6 @@
 
 #include <boost/algorithm/string.hpp>
 #include "common/common_types.h"
-#include "common/literals.h"
 #include "core/core.h"
 #include "core/file_sys/common_funcs.h"
 #include "core/file_sys/content_archive.h"
@@ -128,36 +127,14 @@ inline bool RemoveMod(const Service::FileSystem::FileSystemController& fs_contro
  * \param vfs Reference to the VfsFilesystem instance in Core::System
  * \param filename Path to the NSP file
  * \param callback Callback to report the progress of the installation. The first size_t
- * parameter is the total size of the virtual file and the second is the current progress. If you
- * return true to the callback, it will cancel the installation as soon as possible.
+ * parameter is the total size of the installed NCAs and the second is the current progress. It is
+ * invoked once per installed MiB. If you return true to the callback, it will cancel the
+ * installation as soon as possible.
  * \return [InstallResult] representing how the installation finished
  */
 inline InstallResult InstallNSP(Core::System& system, FileSys::VfsFilesystem& vfs,
                                 const std::string& filename,
                                 const std::function<bool(size_t, size_t)>& callback) {
-    const auto copy = [callback](const FileSys::VirtualFile& src, const FileSys::VirtualFile& dest,
-                                 std::size_t block_size) {
-        if (src == nullptr || dest == nullptr) {
-            return false;
-        }
-        if (!dest->Resize(src->GetSize())) {
-            return false;
-        }
-
-        using namespace Common::Literals;
-        std::vector<u8> buffer(1_MiB);
-
-        for (std::size_t i = 0; i < src->GetSize(); i += buffer.size()) {
-            if (callback(src->GetSize(), i)) {
-                dest->Resize(0);
-                return false;
-            }
-            const auto read = src->Read(buffer.data(), buffer.size(), i);
-            dest->Write(buffer.data(), read, i);
-        }
-        return true;
-    };
-
     std::shared_ptr<FileSys::NSP> nsp;
     FileSys::VirtualFile file = vfs.OpenFile(filename, FileSys::OpenMode::Read);
     if (boost::to_lower_copy(file->GetName()).ends_with(std::string("nsp"))) {
@@ -173,7 +150,7 @@ inline InstallResult InstallNSP(Core::System& system, FileSys::VfsFilesystem& vf
         return InstallResult::Failure;
     }
     const auto res =
-        system.GetFileSystemController().GetUserNANDContents()->InstallEntry(*nsp, true, copy);
+        system.GetFileSystemController().GetUserNANDContents()->InstallEntry(*nsp, true, callback);
     switch (res) {
     case FileSys::InstallResult::Success:
         return InstallResult::Success;
@@ -201,29 +178,6 @@ inline InstallResult InstallNCA(FileSys::VfsFilesystem& vfs, const std::string&
                                 FileSys::RegisteredCache& registered_cache,
                                 const FileSys::TitleType title_type,
                                 const std::function<bool(size_t, size_t)>& callback) {
-    const auto copy = [callback](const FileSys::VirtualFile& src, const FileSys::VirtualFile& dest,
-                                 std::size_t block_size) {
-        if (src == nullptr || dest == nullptr) {
-            return false;
-        }
-        if (!dest->Resize(src->GetSize())) {
-            return false;
-        }
-
-        using namespace Common::Literals;
-        std::vector<u8> buffer(1_MiB);
-
-        for (std::size_t i = 0; i < src->GetSize(); i += buffer.size()) {
-            if (callback(src->GetSize(), i)) {
-                dest->Resize(0);
-                return false;
-            }
-            const auto read = src->Read(buffer.data(), buffer.size(), i);
-            dest->Write(buffer.data(), read, i);
-        }
-        return true;
-    };
-
     const auto nca =
         std::make_shared<FileSys::NCA>(vfs.OpenFile(filename, FileSys::OpenMode::Read));
     const auto id = nca->GetStatus();
@@ -234,7 +188,7 @@ inline InstallResult InstallNCA(FileSys::VfsFilesystem& vfs, const std::string&
         return InstallResult::Failure;
     }
 
-    const auto res = registered_cache.InstallEntry(*nca, title_type, true, copy);
+    const auto res = registered_cache.InstallEntry(*nca, title_type, true, callback);
     if (res == FileSys::InstallResult::Success) {
         return InstallResult::Success;
     } else if (res == FileSys::InstallResult::OverwriteExisting) {
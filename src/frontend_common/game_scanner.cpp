@@ -0,0 +1,375 @@
+// SPDX-FileCopyrightText: 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <string_view>
+#include <system_error>
+#include <thread>
+
+#include "common/fs/file.h"
+#include "common/fs/fs.h"
+#include "common/fs/path_util.h"
+#include "common/logging/log.h"
+#include "common/string_util.h"
+#include "common/thread_worker.h"
+#include "core/core.h"
+#include "core/file_sys/vfs/vfs.h"
+#include "frontend_common/game_scanner.h"
+
+namespace {
+
+constexpr u32 IndexMagic = 0x49534759; // "YGSI"
+constexpr u32 IndexVersion = 2;
+
+constexpr std::array SupportedExtensions{
+    std::string_view{"nso"}, std::string_view{"nro"}, std::string_view{"nca"},
+    std::string_view{"xci"}, std::string_view{"nsp"}, std::string_view{"kip"},
+};
+
+std::filesystem::path GetIndexPath() {
+    return Common::FS::GetYuzuPath(Common::FS::YuzuPath::CacheDir) / "game_list" /
+           "scan_index.bin";
+}
+
+s64 GetModificationTime(const std::string& path) {
+    std::error_code ec;
+    const auto time =
+        std::filesystem::last_write_time(std::filesystem::path{Common::FS::ToU8String(path)}, ec);
+    if (ec) {
+        return 0;
+    }
+    return static_cast<s64>(time.time_since_epoch().count());
+}
+
+template <typename T>
+bool WriteValue(const Common::FS::IOFile& file, const T& value) {
+    return file.WriteObject(value);
+}
+
+template <typename Container>
+bool WriteArray(const Common::FS::IOFile& file, const Container& container) {
+    const u32 size = static_cast<u32>(container.size());
+    return file.WriteObject(size) &&
+           file.WriteSpan(std::span{container.data(), container.size()}) == container.size();
+}
+
+template <typename T>
+bool ReadValue(const Common::FS::IOFile& file, T& value) {
+    return file.ReadObject(value);
+}
+
+template <typename Container>
+bool ReadArray(const Common::FS::IOFile& file, Container& container) {
+    u32 size{};
+    if (!file.ReadObject(size) || size > file.GetSize()) {
+        return false;
+    }
+    container.resize(size);
+    return file.ReadSpan(std::span{container.data(), container.size()}) == container.size();
+}
+
+bool WriteScannedFile(const Common::FS::IOFile& file, const ScannedFile& scanned) {
+    if (!WriteArray(file, scanned.path) || !WriteValue(file, scanned.size) ||
+        !WriteValue(file, scanned.file_type) ||
+        !WriteValue(file, static_cast<u32>(scanned.titles.size()))) {
+        return false;
+    }
+    return std::ranges::all_of(scanned.titles, [&file](const ScannedTitle& title) {
+        return WriteValue(file, title.program_id) && WriteArray(file, title.name) &&
+               WriteArray(file, title.icon) && WriteValue(file, title.is_romfs_updatable) &&
+               WriteValue(file, title.has_packed_update);
+    });
+}
+
+bool ReadScannedFile(const Common::FS::IOFile& file, ScannedFile& scanned) {
+    u32 num_titles{};
+    if (!ReadArray(file, scanned.path) || !ReadValue(file, scanned.size) ||
+        !ReadValue(file, scanned.file_type) || !ReadValue(file, num_titles)) {
+        return false;
+    }
+    for (u32 i = 0; i < num_titles; ++i) {
+        ScannedTitle title;
+        if (!ReadValue(file, title.program_id) || !ReadArray(file, title.name) ||
+            !ReadArray(file, title.icon) || !ReadValue(file, title.is_romfs_updatable) ||
+            !ReadValue(file, title.has_packed_update)) {
+            return false;
+        }
+        scanned.titles.push_back(std::move(title));
+    }
+    return true;
+}
+
+/**
+ * Whether a parsed file can be served from the index on later scans. Files that could not be
+ * parsed, for example because the keys to decrypt them are missing, are parsed again instead.
+ */
+bool IsIndexable(const ScannedFile& scanned) {
+    return scanned.file_type != Loader::FileType::Unknown &&
+           scanned.file_type != Loader::FileType::Error && !scanned.titles.empty() &&
+           std::ranges::none_of(scanned.titles,
+                                [](const ScannedTitle& title) { return title.program_id == 0; });
+}
+
+} // Anonymous namespace
+
+GameScanner::GameScanner(Core::System& system_, FileSys::VirtualFilesystem vfs_, bool use_index_)
+    : system{system_}, vfs{std::move(vfs_)}, use_index{use_index_} {}
+
+GameScanner::~GameScanner() = default;
+
+bool GameScanner::IsSupportedFile(const std::filesystem::path& path) {
+    const auto file_name = Common::FS::PathToUTF8String(path.filename());
+    if (file_name == "main") {
+        // Extracted NCAs are loaded through their main executable.
+        return true;
+    }
+    const auto extension = Common::ToLower(Common::FS::PathToUTF8String(path.extension()));
+    if (extension.empty()) {
+        return false;
+    }
+    return std::ranges::find(SupportedExtensions, std::string_view{extension}.substr(1)) !=
+           SupportedExtensions.end();
+}
+
+std::vector<std::string> GameScanner::CollectFiles(const std::string& dir_path, bool deep_scan,
+                                                   std::vector<std::string>* out_dirs) {
+    std::vector<std::string> files;
+    const auto callback = [&](const std::filesystem::path& path) -> bool {
+        if (stop_requested) {
+            // Breaks the callback loop.
+            return false;
+        }
+        if (Common::FS::IsDir(path)) {
+            if (out_dirs != nullptr) {
+                out_dirs->push_back(Common::FS::PathToUTF8String(path));
+            }
+        } else if (IsSupportedFile(path)) {
+            files.push_back(Common::FS::PathToUTF8String(path));
+        }
+        return true;
+    };
+
+    if (deep_scan) {
+        Common::FS::IterateDirEntriesRecursively(dir_path, callback,
+                                                 Common::FS::DirEntryFilter::All);
+    } else {
+        Common::FS::IterateDirEntries(dir_path, callback, Common::FS::DirEntryFilter::File);
+    }
+    return files;
+}
+
+void GameScanner::ForEachFile(std::span<const std::string> files,
+                              const std::function<void(const std::string&)>& func) {
+    if (files.empty()) {
+        return;
+    }
+
+    const size_t num_workers =
+        std::min<size_t>(files.size(), std::max(1U, std::thread::hardware_concurrency()));
+    Common::ThreadWorker workers(num_workers, "GameScanner");
+    for (const auto& file : files) {
+        workers.QueueWork([this, &func, &file] {
+            if (!stop_requested) {
+                func(file);
+            }
+        });
+    }
+    workers.WaitForRequests();
+}
+
+void GameScanner::ScanFiles(std::span<const std::string> files,
+                            const std::function<void(const ScannedFile&)>& callback) {
+    std::mutex callback_mutex;
+    std::atomic<size_t> num_indexed{};
+
+    ForEachFile(files, [&](const std::string& path) {
+        const u64 size = Common::FS::GetSize(path);
+        const s64 modification_time = GetModificationTime(path);
+
+        if (use_index) {
+            if (const auto indexed = FindInIndex(path, size, modification_time)) {
+                ++num_indexed;
+                std::scoped_lock lk{callback_mutex};
+                callback(*indexed);
+                return;
+            }
+        }
+
+        const auto scanned = ParseFile(path);
+        if (use_index && IsIndexable(scanned)) {
+            std::scoped_lock lk{index_mutex};
+            index.insert_or_assign(path, IndexEntry{
+                                             .size = size,
+                                             .modification_time = modification_time,
+                                             .file = scanned,
+                                             .is_used = true,
+                                         });
+        }
+
+        std::scoped_lock lk{callback_mutex};
+        callback(scanned);
+    });
+
+    LOG_INFO(Frontend, "Scanned {} files, {} of them unchanged since the last scan", files.size(),
+             num_indexed.load());
+}
+
+void GameScanner::SaveIndex() {
+    if (!use_index || stop_requested) {
+        return;
+    }
+
+    std::scoped_lock lk{index_mutex};
+    if (!is_index_loaded) {
+        // Nothing was scanned, keep the index on disk as it is.
+        return;
+    }
+
+    const auto path = GetIndexPath();
+    void(Common::FS::CreateParentDirs(path));
+
+    Common::FS::IOFile file{path, Common::FS::FileAccessMode::Write,
+                            Common::FS::FileType::BinaryFile};
+    if (!file.IsOpen()) {
+        LOG_ERROR(Frontend, "Failed to open game scan index {}",
+                  Common::FS::PathToUTF8String(path));
+        return;
+    }
+
+    const auto num_used = std::ranges::count_if(
+        index, [](const auto& pair) { return pair.second.is_used; });
+    bool is_ok = WriteValue(file, IndexMagic) && WriteValue(file, IndexVersion) &&
+                 WriteValue(file, static_cast<u32>(num_used));
+    for (const auto& [entry_path, entry] : index) {
+        if (!is_ok) {
+            break;
+        }
+        // Files that were not seen by this scan were moved, deleted or are no longer listed.
+        if (!entry.is_used) {
+            continue;
+        }
+        is_ok = WriteValue(file, entry.size) && WriteValue(file, entry.modification_time) &&
+                WriteScannedFile(file, entry.file);
+    }
+
+    if (!is_ok) {
+        LOG_ERROR(Frontend, "Failed to write game scan index {}",
+                  Common::FS::PathToUTF8String(path));
+        file.Close();
+        void(Common::FS::RemoveFile(path));
+    }
+}
+
+void GameScanner::RequestStop() {
+    stop_requested = true;
+}
+
+ScannedFile GameScanner::ParseFile(const std::string& path) const {
+    ScannedFile scanned{
+        .path = path,
+        .size = Common::FS::GetSize(path),
+    };
+
+    const auto file = vfs->OpenFile(path, FileSys::OpenMode::Read);
+    if (!file) {
+        return scanned;
+    }
+
+    auto loader = Loader::GetLoader(system, file);
+    if (!loader) {
+        return scanned;
+    }
+
+    scanned.file_type = loader->GetFileType();
+    if (scanned.file_type == Loader::FileType::Unknown ||
+        scanned.file_type == Loader::FileType::Error) {
+        return scanned;
+    }
+
+    const auto read_title = [&scanned](Loader::AppLoader& title_loader, u64 program_id) {
+        ScannedTitle title{
+            .program_id = program_id,
+            .name = " ",
+        };
+        [[maybe_unused]] const auto icon_result = title_loader.ReadIcon(title.icon);
+        [[maybe_unused]] const auto title_result = title_loader.ReadTitle(title.name);
+
+        FileSys::VirtualFile update_raw;
+        title_loader.ReadUpdateRaw(update_raw);
+        title.is_romfs_updatable = title_loader.IsRomFSUpdatable();
+        title.has_packed_update = update_raw != nullptr;
+
+        scanned.titles.push_back(std::move(title));
+    };
+
+    u64 program_id = 0;
+    const auto program_id_result = loader->ReadProgramId(program_id);
+
+    std::vector<u64> program_ids;
+    loader->ReadProgramIds(program_ids);
+
+    const bool is_container = scanned.file_type == Loader::FileType::XCI ||
+                              scanned.file_type == Loader::FileType::NSP;
+    if (program_id_result == Loader::ResultStatus::Success && program_ids.size() > 1 &&
+        is_container) {
+        for (const auto id : program_ids) {
+            const auto title_loader = Loader::GetLoader(system, file, id);
+            if (title_loader) {
+                read_title(*title_loader, id);
+            }
+        }
+    } else {
+        read_title(*loader, program_id);
+    }
+
+    return scanned;
+}
+
+std::optional<ScannedFile> GameScanner::FindInIndex(const std::string& path, u64 size,
+                                                    s64 modification_time) {
+    std::scoped_lock lk{index_mutex};
+    LoadIndexLocked();
+
+    const auto it = index.find(path);
+    if (it == index.end() || it->second.size != size ||
+        it->second.modification_time != modification_time) {
+        return std::nullopt;
+    }
+    it->second.is_used = true;
+    return it->second.file;
+}
+
+void GameScanner::LoadIndexLocked() {
+    if (is_index_loaded) {
+        return;
+    }
+    is_index_loaded = true;
+
+    const auto path = GetIndexPath();
+    Common::FS::IOFile file{path, Common::FS::FileAccessMode::Read,
+                            Common::FS::FileType::BinaryFile};
+    if (!file.IsOpen()) {
+        return;
+    }
+
+    u32 magic{};
+    u32 version{};
+    u32 num_entries{};
+    if (!ReadValue(file, magic) || !ReadValue(file, version) || !ReadValue(file, num_entries) ||
+        magic != IndexMagic || version != IndexVersion) {
+        LOG_WARNING(Frontend, "Ignoring outdated game scan index");
+        return;
+    }
+
+    for (u32 i = 0; i < num_entries; ++i) {
+        IndexEntry entry{};
+        if (!ReadValue(file, entry.size) || !ReadValue(file, entry.modification_time) ||
+            !ReadScannedFile(file, entry.file)) {
+            LOG_WARNING(Frontend, "Game scan index is corrupted, rescanning all files");
+            index.clear();
+            return;
+        }
+        index.insert_or_assign(entry.file.path, std::move(entry));
+    }
+}
@@ -0,0 +1,100 @@
+// SPDX-FileCopyrightText: 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <atomic>
+#include <filesystem>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "common/common_types.h"
+#include "core/file_sys/vfs/vfs_types.h"
+#include "core/loader/loader.h"
+
+namespace Core {
+class System;
+}
+
+/// A program found by the game scanner.
+struct ScannedTitle {
+    u64 program_id{};
+    std::string name;
+    std::vector<u8> icon;
+    bool is_romfs_updatable{};
+    bool has_packed_update{};
+};
+
+/// A file found by the game scanner. Files without any titles are not games.
+struct ScannedFile {
+    std::string path;
+    u64 size{};
+    Loader::FileType file_type{Loader::FileType::Unknown};
+    std::vector<ScannedTitle> titles;
+};
+
+/**
+ * Frontend independent scanner for game directories.
+ * Files are parsed concurrently on a thread pool and the results are kept in a persistent index
+ * keyed by path, size and modification time, so unchanged files are not opened on later scans.
+ */
+class GameScanner {
+public:
+    explicit GameScanner(Core::System& system_, FileSys::VirtualFilesystem vfs_, bool use_index_);
+    ~GameScanner();
+
+    /// Returns true if the file may be accepted by one of the loaders.
+    [[nodiscard]] static bool IsSupportedFile(const std::filesystem::path& path);
+
+    /**
+     * Lists the files in dir_path that may contain games.
+     * \param deep_scan Also list the files of all subdirectories
+     * \param out_dirs If not null, receives the subdirectories visited by a deep scan
+     */
+    [[nodiscard]] std::vector<std::string> CollectFiles(const std::string& dir_path, bool deep_scan,
+                                                        std::vector<std::string>* out_dirs = nullptr);
+
+    /// Runs func on the thread pool for every file and waits for all of them to finish.
+    void ForEachFile(std::span<const std::string> files,
+                     const std::function<void(const std::string&)>& func);
+
+    /**
+     * Parses every file on the thread pool, serving unchanged files from the index.
+     * The callback is invoked from the pool threads, but never concurrently.
+     */
+    void ScanFiles(std::span<const std::string> files,
+                   const std::function<void(const ScannedFile&)>& callback);
+
+    /// Writes the index entries used by the scans of this scanner back to disk.
+    void SaveIndex();
+
+    /// Makes the running and any later scans return as soon as possible.
+    void RequestStop();
+
+private:
+    struct IndexEntry {
+        u64 size;
+        s64 modification_time;
+        ScannedFile file;
+        bool is_used;
+    };
+
+    [[nodiscard]] ScannedFile ParseFile(const std::string& path) const;
+    [[nodiscard]] std::optional<ScannedFile> FindInIndex(const std::string& path, u64 size,
+                                                         s64 modification_time);
+    void LoadIndexLocked();
+
+    Core::System& system;
+    FileSys::VirtualFilesystem vfs;
+    bool use_index;
+    std::atomic_bool stop_requested{};
+
+    std::mutex index_mutex;
+    std::unordered_map<std::string, IndexEntry> index;
+    bool is_index_loaded{};
+};
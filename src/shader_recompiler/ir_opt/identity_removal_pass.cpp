@@ -6,11 +6,13 @@
 #include "shader_recompiler/frontend/ir/basic_block.h"
 #include "shader_recompiler/frontend/ir/value.h"
 #include "shader_recompiler/ir_opt/passes.h"
+#include "shader_recompiler/scratch_arena.h"
 
 namespace Shader::Optimization {
 
 void IdentityRemovalPass(IR::Program& program) {
-    std::vector<IR::Inst*> to_invalidate;
+    const ScratchScope scratch_scope;
+    std::vector<IR::Inst*, ScratchAllocator<IR::Inst*>> to_invalidate;
     for (IR::Block* const block : program.blocks) {
         for (auto inst = block->begin(); inst != block->end();) {
             const size_t num_args{inst->NumArgs()};
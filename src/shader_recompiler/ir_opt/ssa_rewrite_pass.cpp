@@ -26,6 +26,7 @@
 #include "shader_recompiler/frontend/ir/reg.h"
 #include "shader_recompiler/frontend/ir/value.h"
 #include "shader_recompiler/ir_opt/passes.h"
+#include "shader_recompiler/scratch_arena.h"
 
 namespace Shader::Optimization {
 namespace {
@@ -52,7 +53,14 @@ struct IndirectBranchVariable {
 
 using Variant = std::variant<IR::Reg, IR::Pred, ZeroFlagTag, SignFlagTag, CarryFlagTag,
                              OverflowFlagTag, GotoVariable, IndirectBranchVariable>;
-using ValueMap = std::unordered_map<IR::Block*, IR::Value>;
+template <typename Key, typename Value>
+using ScratchUnorderedMap = std::unordered_map<Key, Value, std::hash<Key>, std::equal_to<Key>,
+                                               ScratchAllocator<std::pair<const Key, Value>>>;
+template <typename Key, typename Value>
+using ScratchMap =
+    std::map<Key, Value, std::less<Key>, ScratchAllocator<std::pair<const Key, Value>>>;
+
+using ValueMap = ScratchUnorderedMap<IR::Block*, IR::Value>;
 
 struct DefTable {
     const IR::Value& Def(IR::Block* block, IR::Reg variable) {
@@ -112,7 +120,7 @@ struct DefTable {
     }
 
     std::array<ValueMap, IR::NUM_USER_PREDS> preds;
-    std::unordered_map<u32, ValueMap> goto_vars;
+    ScratchUnorderedMap<u32, ValueMap> goto_vars;
     ValueMap indirect_branch_var;
     ValueMap zero_flag;
     ValueMap sign_flag;
@@ -295,7 +303,7 @@ private:
         return same;
     }
 
-    std::unordered_map<IR::Block*, std::map<Variant, IR::Inst*>> incomplete_phis;
+    ScratchUnorderedMap<IR::Block*, ScratchMap<Variant, IR::Inst*>> incomplete_phis;
     DefTable current_def;
 };
 
@@ -370,7 +378,7 @@ void VisitBlock(Pass& pass, IR::Block* block) {
 }
 
 IR::Type GetConcreteType(IR::Inst* inst) {
-    std::deque<IR::Inst*> queue;
+    std::deque<IR::Inst*, ScratchAllocator<IR::Inst*>> queue;
     queue.push_back(inst);
     while (!queue.empty()) {
         IR::Inst* current = queue.front();
@@ -391,6 +399,8 @@ IR::Type GetConcreteType(IR::Inst* inst) {
 } // Anonymous namespace
 
 void SsaRewritePass(IR::Program& program) {
+    // Pass-local containers are released wholesale when the scope ends
+    const ScratchScope scratch_scope;
     Pass pass;
     const auto end{program.post_order_blocks.rend()};
     for (auto block = program.post_order_blocks.rbegin(); block != end; ++block) {
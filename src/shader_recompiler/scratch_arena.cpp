@@ -0,0 +1,106 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <atomic>
+
+#include "shader_recompiler/scratch_arena.h"
+
+namespace Shader {
+namespace {
+std::atomic<u64> global_allocations{};
+std::atomic<u64> global_bytes_reserved{};
+std::atomic<u64> global_bytes_peak{};
+
+size_t AlignUp(size_t value, size_t alignment) noexcept {
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+} // Anonymous namespace
+
+ScratchArena::ScratchArena(size_t chunk_size_) : chunk_size{chunk_size_} {}
+
+ScratchArena::~ScratchArena() {
+    global_bytes_reserved -= bytes_reserved;
+}
+
+ScratchArena& ScratchArena::ThreadLocal() {
+    thread_local ScratchArena arena;
+    return arena;
+}
+
+ScratchArenaStats ScratchArena::GlobalStats() {
+    return {
+        .allocations = global_allocations.load(std::memory_order_relaxed),
+        .bytes_reserved = global_bytes_reserved.load(std::memory_order_relaxed),
+        .bytes_peak = global_bytes_peak.load(std::memory_order_relaxed),
+    };
+}
+
+void* ScratchArena::Allocate(size_t size, size_t alignment) {
+    ++allocations;
+    global_allocations.fetch_add(1, std::memory_order_relaxed);
+
+    void* result{TryBump(size, alignment)};
+    if (!result) {
+        NextChunk(size + alignment);
+        result = TryBump(size, alignment);
+    }
+    if (bytes_used > bytes_peak) {
+        bytes_peak = bytes_used;
+        u64 peak{global_bytes_peak.load(std::memory_order_relaxed)};
+        while (peak < bytes_peak && !global_bytes_peak.compare_exchange_weak(
+                                        peak, bytes_peak, std::memory_order_relaxed)) {
+        }
+    }
+    return result;
+}
+
+void* ScratchArena::TryBump(size_t size, size_t alignment) noexcept {
+    if (chunk_index >= chunks.size()) {
+        return nullptr;
+    }
+    Chunk& chunk{chunks[chunk_index]};
+    const size_t begin{AlignUp(offset, alignment)};
+    if (begin + size > chunk.size) {
+        return nullptr;
+    }
+    bytes_used += begin + size - offset;
+    offset = begin + size;
+    return chunk.data.get() + begin;
+}
+
+void ScratchArena::NextChunk(size_t required) {
+    // Reuse a chunk kept from a previous program when it is large enough
+    const size_t first{std::min(chunk_index + 1, chunks.size())};
+    const auto it{std::find_if(chunks.begin() + first, chunks.end(),
+                               [required](const Chunk& chunk) { return chunk.size >= required; })};
+    if (it != chunks.end()) {
+        chunk_index = static_cast<size_t>(it - chunks.begin());
+    } else {
+        const size_t new_size{std::max(chunk_size, required)};
+        chunks.push_back(Chunk{
+            .data = std::make_unique<std::byte[]>(new_size),
+            .size = new_size,
+        });
+        chunk_index = chunks.size() - 1;
+        bytes_reserved += new_size;
+        global_bytes_reserved += new_size;
+    }
+    offset = 0;
+}
+
+void ScratchArena::Rewind(const Mark& mark) noexcept {
+    chunk_index = mark.chunk;
+    offset = mark.offset;
+    bytes_used = mark.used;
+}
+
+ScratchArenaStats ScratchArena::Stats() const noexcept {
+    return {
+        .allocations = allocations,
+        .bytes_reserved = bytes_reserved,
+        .bytes_peak = bytes_peak,
+    };
+}
+
+} // namespace Shader
@@ -0,0 +1,126 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "common/common_types.h"
+
+namespace Shader {
+
+struct ScratchArenaStats {
+    u64 allocations;    ///< Number of allocations served
+    u64 bytes_reserved; ///< Bytes currently held in arena chunks
+    u64 bytes_peak;     ///< Largest number of bytes in use at once by a single arena
+};
+
+/**
+ * Monotonic allocator for short lived containers used by the recompiler passes.
+ * Deallocation is a no-op, memory is returned wholesale when the outermost ScratchScope ends.
+ * Chunks are kept between programs, so after warming up a worker thread does not hit the heap
+ * for pass-local containers anymore. Each thread owns its own arena.
+ */
+class ScratchArena {
+public:
+    explicit ScratchArena(size_t chunk_size = 64 * 1024);
+    ~ScratchArena();
+
+    ScratchArena(const ScratchArena&) = delete;
+    ScratchArena& operator=(const ScratchArena&) = delete;
+
+    /// Returns the arena of the calling thread
+    [[nodiscard]] static ScratchArena& ThreadLocal();
+
+    /// Returns the statistics of every arena created by the process
+    [[nodiscard]] static ScratchArenaStats GlobalStats();
+
+    [[nodiscard]] void* Allocate(size_t size, size_t alignment);
+
+    [[nodiscard]] ScratchArenaStats Stats() const noexcept;
+
+private:
+    friend class ScratchScope;
+
+    struct Chunk {
+        std::unique_ptr<std::byte[]> data;
+        size_t size;
+    };
+
+    struct Mark {
+        size_t chunk;
+        size_t offset;
+        size_t used;
+    };
+
+    [[nodiscard]] Mark GetMark() const noexcept {
+        return {chunk_index, offset, bytes_used};
+    }
+
+    void Rewind(const Mark& mark) noexcept;
+
+    [[nodiscard]] void* TryBump(size_t size, size_t alignment) noexcept;
+
+    void NextChunk(size_t required);
+
+    std::vector<Chunk> chunks;
+    size_t chunk_index{};
+    size_t offset{};
+    size_t chunk_size;
+
+    size_t bytes_used{};
+    u64 allocations{};
+    u64 bytes_reserved{};
+    u64 bytes_peak{};
+};
+
+/// Releases every allocation made on the thread arena during the lifetime of the scope
+class ScratchScope {
+public:
+    explicit ScratchScope(ScratchArena& arena_ = ScratchArena::ThreadLocal())
+        : arena{arena_}, mark{arena.GetMark()} {}
+
+    ~ScratchScope() {
+        arena.Rewind(mark);
+    }
+
+    ScratchScope(const ScratchScope&) = delete;
+    ScratchScope& operator=(const ScratchScope&) = delete;
+
+private:
+    ScratchArena& arena;
+    ScratchArena::Mark mark;
+};
+
+/// Standard allocator drawing from the arena of the thread that constructs it
+template <typename T>
+class ScratchAllocator {
+public:
+    using value_type = T;
+
+    ScratchAllocator() noexcept : arena{&ScratchArena::ThreadLocal()} {}
+
+    template <typename U>
+    ScratchAllocator(const ScratchAllocator<U>& other) noexcept : arena{other.arena} {}
+
+    [[nodiscard]] T* allocate(size_t n) {
+        return static_cast<T*>(arena->Allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T*, size_t) noexcept {}
+
+    template <typename U>
+    [[nodiscard]] bool operator==(const ScratchAllocator<U>& other) const noexcept {
+        return arena == other.arena;
+    }
+
+private:
+    template <typename U>
+    friend class ScratchAllocator;
+
+    ScratchArena* arena;
+};
+
+} // namespace Shader
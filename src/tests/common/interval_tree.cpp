@@ -0,0 +1,168 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/interval_tree.h"
+#include "common/literals.h"
+
+using namespace Common::Literals;
+
+namespace {
+struct Interval {
+    u64 begin;
+    u64 end;
+    u32 value;
+};
+
+std::vector<u32> QueryTree(const Common::IntervalTree<u64, u32>& tree, u64 begin, u64 end) {
+    std::vector<u32> result;
+    tree.ForEachOverlapping(begin, end, [&result](u32 value) { result.push_back(value); });
+    std::ranges::sort(result);
+    return result;
+}
+
+std::vector<u32> QueryList(const std::vector<Interval>& intervals, u64 begin, u64 end) {
+    std::vector<u32> result;
+    for (const Interval& interval : intervals) {
+        if (interval.begin < end && begin < interval.end) {
+            result.push_back(interval.value);
+        }
+    }
+    std::ranges::sort(result);
+    return result;
+}
+} // Anonymous namespace
+
+TEST_CASE("IntervalTree[Overlaps]", "[common]") {
+    Common::IntervalTree<u64, u32> tree;
+    tree.Insert(0x1000, 0x2000, 1);
+    tree.Insert(0x1800, 0x1900, 2);
+    tree.Insert(0x1000, 0x1400, 3);
+
+    REQUIRE(tree.Size() == 3);
+    REQUIRE(QueryTree(tree, 0x0, 0x1000).empty());
+    REQUIRE(QueryTree(tree, 0x2000, 0x4000).empty());
+    REQUIRE(QueryTree(tree, 0x1fff, 0x2000) == std::vector<u32>{1});
+    REQUIRE(QueryTree(tree, 0x1400, 0x1801) == std::vector<u32>{1, 2});
+    REQUIRE(QueryTree(tree, 0x0, 0x10000) == std::vector<u32>{1, 2, 3});
+
+    std::vector<u32> ordered;
+    tree.ForEachOverlapping(0x0, 0x10000, [&ordered](u32 value) { ordered.push_back(value); });
+    REQUIRE(ordered == std::vector<u32>{1, 3, 2});
+
+    u32 first{};
+    tree.ForEachOverlapping(0x0, 0x10000, [&first](u32 value) {
+        first = value;
+        return true;
+    });
+    REQUIRE(first == 1);
+
+    REQUIRE(!tree.Erase(0x1000, 2));
+    REQUIRE(tree.Erase(0x1000, 1));
+    REQUIRE(!tree.Erase(0x1000, 1));
+    REQUIRE(QueryTree(tree, 0x0, 0x10000) == std::vector<u32>{2, 3});
+    REQUIRE(tree.Size() == 2);
+}
+
+TEST_CASE("IntervalTree[Random]", "[common]") {
+    std::mt19937_64 rng{1234};
+    Common::IntervalTree<u64, u32> tree;
+    std::vector<Interval> intervals;
+    for (u32 value = 0; value < 4000; ++value) {
+        const u64 begin = (rng() % 0x1000) << 12;
+        const u64 size = (rng() % 0x200) << 10;
+        tree.Insert(begin, begin + size, value);
+        intervals.push_back({begin, begin + size, value});
+
+        if (value % 3 == 0) {
+            const size_t index = rng() % intervals.size();
+            REQUIRE(tree.Erase(intervals[index].begin, intervals[index].value));
+            intervals.erase(intervals.begin() + index);
+        }
+        const u64 query_begin = (rng() % 0x1000) << 12;
+        const u64 query_end = query_begin + (rng() % 0x100) * 0x800;
+        REQUIRE(QueryTree(tree, query_begin, query_end) ==
+                QueryList(intervals, query_begin, query_end));
+    }
+    REQUIRE(tree.Size() == intervals.size());
+}
+
+TEST_CASE("IntervalTree[Benchmark]", "[common]") {
+    // Reproduces the texture cache lookups of many large aliased render targets,
+    // comparing the former per page map against the interval tree.
+    static constexpr u64 PAGE_BITS = 20;
+    static constexpr u64 NUM_IMAGES = 2048;
+    static constexpr u64 NUM_QUERIES = 20000;
+
+    std::mt19937_64 rng{5678};
+    std::vector<Interval> images;
+    for (u32 value = 0; value < NUM_IMAGES; ++value) {
+        const u64 begin = (rng() % 0x4000) << 16;
+        const u64 size = 32_MiB + (rng() % 32) * 1_MiB;
+        images.push_back({begin, begin + size, value});
+    }
+    std::vector<std::pair<u64, u64>> queries;
+    for (u64 i = 0; i < NUM_QUERIES; ++i) {
+        const u64 begin = (rng() % 0x4000) << 16;
+        queries.emplace_back(begin, begin + 16_MiB);
+    }
+
+    std::unordered_map<u64, std::vector<u32>> page_table;
+    for (const Interval& image : images) {
+        for (u64 page = image.begin >> PAGE_BITS; page <= (image.end - 1) >> PAGE_BITS; ++page) {
+            page_table[page].push_back(image.value);
+        }
+    }
+    std::vector<bool> picked(NUM_IMAGES);
+    const auto page_start = std::chrono::steady_clock::now();
+    u64 page_matches = 0;
+    for (const auto& [begin, end] : queries) {
+        std::vector<u32> picked_values;
+        for (u64 page = begin >> PAGE_BITS; page <= (end - 1) >> PAGE_BITS; ++page) {
+            const auto it = page_table.find(page);
+            if (it == page_table.end()) {
+                continue;
+            }
+            for (const u32 value : it->second) {
+                const Interval& image = images[value];
+                if (picked[value] || !(image.begin < end && begin < image.end)) {
+                    continue;
+                }
+                picked[value] = true;
+                picked_values.push_back(value);
+                ++page_matches;
+            }
+        }
+        for (const u32 value : picked_values) {
+            picked[value] = false;
+        }
+    }
+    const auto page_time = std::chrono::steady_clock::now() - page_start;
+
+    Common::IntervalTree<u64, u32> tree;
+    for (const Interval& image : images) {
+        tree.Insert(image.begin, image.end, image.value);
+    }
+    const auto tree_start = std::chrono::steady_clock::now();
+    u64 tree_matches = 0;
+    for (const auto& [begin, end] : queries) {
+        tree.ForEachOverlapping(begin, end, [&tree_matches](u32) { ++tree_matches; });
+    }
+    const auto tree_time = std::chrono::steady_clock::now() - tree_start;
+
+    REQUIRE(page_matches == tree_matches);
+    using std::chrono::duration_cast;
+    using std::chrono::microseconds;
+    std::printf("IntervalTree: page map %lld us, interval tree %lld us for %llu overlaps\n",
+                static_cast<long long>(duration_cast<microseconds>(page_time).count()),
+                static_cast<long long>(duration_cast<microseconds>(tree_time).count()),
+                static_cast<unsigned long long>(tree_matches));
+}
@@ -4,12 +4,15 @@
 #include <catch2/catch_test_macros.hpp>
 
 #include <array>
+#include <atomic>
 #include <bitset>
 #include <chrono>
 #include <cstdlib>
 #include <memory>
 #include <optional>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include "core/core.h"
 #include "core/core_timing.h"
@@ -139,3 +142,43 @@ TEST_CASE("CoreTiming[BasicOrderNoPausing]", "[core]") {
     printf("HostTimer No Pausing Timer Time: %.3f %.6f\n", timer_time / 1000.f,
            timer_time / 1000000.f);
 }
+
+TEST_CASE("CoreTiming[ScheduleContention]", "[core]") {
+    ScopeInit guard;
+    auto& core_timing = guard.core_timing;
+    core_timing.SyncPause(true);
+    core_timing.SyncPause(false);
+
+    constexpr std::size_t num_threads = 4;
+    constexpr std::size_t num_iterations = 100000;
+    std::atomic<u64> num_fired{};
+
+    const u64 start = core_timing.GetGlobalTimeNs().count();
+    std::vector<std::jthread> threads;
+    for (std::size_t i = 0; i < num_threads; i++) {
+        threads.emplace_back([&core_timing, &num_fired] {
+            const auto event = Core::Timing::CreateEvent(
+                "contention", [&num_fired](s64 time, std::chrono::nanoseconds ns_late)
+                                  -> std::optional<std::chrono::nanoseconds> {
+                    ++num_fired;
+                    return std::nullopt;
+                });
+            for (std::size_t j = 0; j < num_iterations; j++) {
+                core_timing.ScheduleEvent(std::chrono::seconds{10}, event);
+                core_timing.UnscheduleEvent(event, Core::Timing::UnscheduleEventType::NoWait);
+            }
+            core_timing.UnscheduleEvent(event);
+        });
+    }
+    threads.clear();
+    const u64 end = core_timing.GetGlobalTimeNs().count();
+
+    while (core_timing.HasPendingEvents())
+        ;
+
+    REQUIRE(num_fired == 0);
+
+    const double seconds = static_cast<double>(end - start) / 1000000000.0;
+    const double ops = static_cast<double>(num_threads * num_iterations * 2) / seconds;
+    printf("HostTimer Contention: %.0f schedule/unschedule ops per second\n", ops);
+}
@@ -0,0 +1,59 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/common_types.h"
+#include "core/hle/ipc.h"
+#include "core/hle/service/hle_ipc.h"
+
+namespace {
+IPC::BufferDescriptorABW MakeDescriptorABW(VAddr address, u64 size) {
+    IPC::BufferDescriptorABW descriptor{};
+    descriptor.address_bits_0_31 = static_cast<u32>(address);
+    descriptor.address_bits_32_35.Assign(static_cast<u32>(address >> 32));
+    descriptor.address_bits_36_38.Assign(static_cast<u32>(address >> 36));
+    descriptor.size_bits_0_31 = static_cast<u32>(size);
+    descriptor.size_bits_32_35.Assign(static_cast<u32>(size >> 32));
+    return descriptor;
+}
+
+IPC::BufferDescriptorC MakeDescriptorC(VAddr address, u64 size) {
+    IPC::BufferDescriptorC descriptor{};
+    descriptor.address_bits_0_31 = static_cast<u32>(address);
+    descriptor.address_bits_32_47.Assign(static_cast<u32>(address >> 32));
+    descriptor.size.Assign(static_cast<u32>(size));
+    return descriptor;
+}
+} // Anonymous namespace
+
+TEST_CASE("HLERequestContext[aliased_buffers]", "[core]") {
+    // In place request: the output buffer B covers the second half of the input buffer A
+    const std::array inputs{
+        MakeDescriptorABW(0x1'0000'1000, 0x200),
+        MakeDescriptorABW(0x1'0000'4000, 0),
+    };
+    const auto overlaps = [&inputs](VAddr address, u64 size) {
+        return Service::CountOverlappingDescriptors<IPC::BufferDescriptorABW>(address, size,
+                                                                              inputs);
+    };
+    const IPC::BufferDescriptorABW output = MakeDescriptorABW(0x1'0000'1100, 0x200);
+    REQUIRE(overlaps(output.Address(), output.Size()) == 1);
+
+    // Buffers that only touch are not aliased
+    REQUIRE(overlaps(0x1'0000'0F00, 0x100) == 0);
+    REQUIRE(overlaps(0x1'0000'1200, 0x100) == 0);
+
+    // Empty descriptors never alias anything
+    REQUIRE(overlaps(0x1'0000'3F00, 0x200) == 0);
+
+    // Receive lists go through the same check
+    const std::array receive_lists{
+        MakeDescriptorC(0x2'0000'0000, 0x80),
+        MakeDescriptorC(0x2'0000'0040, 0x80),
+    };
+    REQUIRE(Service::CountOverlappingDescriptors<IPC::BufferDescriptorC>(0x2'0000'0040, 0x80,
+                                                                         receive_lists) == 2);
+}
@@ -0,0 +1,114 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/common_types.h"
+#include "common/literals.h"
+#include "common/scope_exit.h"
+#include "common/settings.h"
+#include "core/core.h"
+#include "core/file_sys/program_metadata.h"
+#include "core/frontend/emu_window.h"
+#include "core/frontend/graphics_context.h"
+#include "core/hle/kernel/k_process.h"
+#include "core/memory.h"
+
+namespace {
+using namespace Common::Literals;
+
+class NullWindow final : public Core::Frontend::EmuWindow {
+public:
+    std::unique_ptr<Core::Frontend::GraphicsContext> CreateSharedContext() const override {
+        return std::make_unique<Core::Frontend::GraphicsContext>();
+    }
+
+    bool IsShown() const override {
+        return true;
+    }
+};
+
+struct BlockCopy {
+    const char* name;
+    u64 offset;
+    u64 size;
+    u32 iterations;
+};
+} // Anonymous namespace
+
+TEST_CASE("Memory[ReadWriteBlock]", "[core]") {
+    // Copies into the code region of a process that is never started, the sizes and alignments
+    // of HLE service buffers are measured together with larger multi page copies.
+    static constexpr u64 CODE_SIZE = 4_MiB;
+    static constexpr std::array<BlockCopy, 4> COPIES{{
+        {"small", 0x10, 0x40, 1'000'000},
+        {"page", 0x1000, 0x1000, 200'000},
+        {"page straddling", 0x1F00, 0x400, 500'000},
+        {"large", 0x3000, 1_MiB, 500},
+    }};
+
+    const auto renderer_backend = Settings::values.renderer_backend.GetValue();
+    const bool use_async = Settings::values.use_asynchronous_gpu_emulation.GetValue();
+    SCOPE_EXIT {
+        Settings::values.renderer_backend.SetValue(renderer_backend);
+        Settings::values.use_asynchronous_gpu_emulation.SetValue(use_async);
+    };
+    Settings::values.renderer_backend.SetValue(Settings::RendererBackend::Null);
+    Settings::values.use_asynchronous_gpu_emulation.SetValue(false);
+
+    NullWindow window;
+    Core::System system;
+    system.Initialize();
+    REQUIRE(system.LoadGPUOnly(window) == Core::SystemResultStatus::Success);
+    SCOPE_EXIT {
+        system.ShutdownMainProcess();
+    };
+
+    auto* const process = Kernel::KProcess::Create(system.Kernel());
+    Kernel::KProcess::Register(system.Kernel(), process);
+    SCOPE_EXIT {
+        process->Close();
+    };
+    REQUIRE(process
+                ->LoadFromMetadata(FileSys::ProgramMetadata::GetDefault(), CODE_SIZE, 0, false)
+                .IsSuccess());
+
+    auto& memory = process->GetMemory();
+    const u64 base = GetInteger(process->GetEntryPoint());
+
+    std::mt19937 rng{1};
+    for (const auto& [name, offset, size, iterations] : COPIES) {
+        std::vector<u8> input(size);
+        for (u8& value : input) {
+            value = static_cast<u8>(rng());
+        }
+        std::vector<u8> output(size);
+
+        const auto write_start = std::chrono::steady_clock::now();
+        for (u32 i = 0; i < iterations; ++i) {
+            memory.WriteBlock(base + offset, input.data(), size);
+        }
+        const auto write_time = std::chrono::steady_clock::now() - write_start;
+
+        const auto read_start = std::chrono::steady_clock::now();
+        for (u32 i = 0; i < iterations; ++i) {
+            memory.ReadBlock(base + offset, output.data(), size);
+        }
+        const auto read_time = std::chrono::steady_clock::now() - read_start;
+        REQUIRE(output == input);
+
+        const auto nanoseconds = [iterations](auto time) {
+            return std::chrono::duration<f64, std::nano>(time).count() / iterations;
+        };
+        std::printf("Memory: %s copies of 0x%llx bytes, WriteBlock %.1f ns, ReadBlock %.1f ns\n",
+                    name, static_cast<unsigned long long>(size), nanoseconds(write_time),
+                    nanoseconds(read_time));
+    }
+}
@@ -0,0 +1,247 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <span>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/cityhash.h"
+#include "common/common_types.h"
+#include "video_core/textures/astc.h"
+
+namespace {
+/// Size in bits of count weights encoded with the range selected by the R and H block mode bits
+u32 WeightBits(u32 count, u32 range_bits, bool high_precision) {
+    struct Encoding {
+        u32 bits;
+        u32 trits;
+        u32 quints;
+    };
+    static constexpr std::array<Encoding, 6> low_precision_encodings{{
+        {1, 0, 0},
+        {0, 1, 0},
+        {2, 0, 0},
+        {0, 0, 1},
+        {1, 1, 0},
+        {3, 0, 0},
+    }};
+    static constexpr std::array<Encoding, 6> high_precision_encodings{{
+        {1, 0, 1},
+        {2, 1, 0},
+        {4, 0, 0},
+        {2, 0, 1},
+        {3, 1, 0},
+        {5, 0, 0},
+    }};
+    const Encoding& encoding =
+        (high_precision ? high_precision_encodings : low_precision_encodings)[range_bits - 2];
+    return count * encoding.bits + (count * 8 * encoding.trits + 4) / 5 +
+           (count * 7 * encoding.quints + 2) / 3;
+}
+
+void SetBits(std::array<u8, 16>& block, u32 offset, u32 count, u32 value) {
+    for (u32 bit = 0; bit < count; ++bit) {
+        const u32 index = offset + bit;
+        const u8 mask = static_cast<u8>(1U << (index % 8));
+        block[index / 8] = static_cast<u8>(((value >> bit) & 1) != 0 ? block[index / 8] | mask
+                                                                     : block[index / 8] & ~mask);
+    }
+}
+
+/**
+ * Generates a random LDR block that only uses valid encodings for the given footprint. The block
+ * mode, partitioning and color endpoint mode are picked at random within the limits of the
+ * specification and every other bit is random.
+ */
+std::array<u8, 16> MakeBlock(std::mt19937& rng, u32 block_width, u32 block_height) {
+    // Color endpoint modes without HDR components
+    static constexpr std::array<u32, 10> ldr_modes{0, 1, 4, 5, 6, 8, 9, 10, 12, 13};
+    while (true) {
+        const u32 range_bits = 2 + rng() % 6;
+        const bool high_precision = rng() % 2 != 0;
+        const bool dual_plane = rng() % 2 != 0;
+        const u32 a = rng() % 4;
+        const u32 b = rng() % 4;
+        u32 mode = ((range_bits & 1) << 4) | (a << 5);
+        u32 width = 0;
+        u32 height = 0;
+        bool has_flags = true;
+        switch (rng() % 6) {
+        case 0:
+            mode |= (range_bits >> 1) | (b << 7);
+            width = b + 4;
+            height = a + 2;
+            break;
+        case 1:
+            mode |= (range_bits >> 1) | 0x4 | (b << 7);
+            width = b + 8;
+            height = a + 2;
+            break;
+        case 2:
+            mode |= (range_bits >> 1) | 0x8 | (b << 7);
+            width = a + 2;
+            height = b + 8;
+            break;
+        case 3:
+            mode |= (range_bits >> 1) | 0xC | ((b & 1) << 7);
+            width = a + 2;
+            height = (b & 1) + 6;
+            break;
+        case 4:
+            mode |= (range_bits >> 1) | 0xC | 0x100 | ((b & 1) << 7);
+            width = (b & 1) + 2;
+            height = a + 2;
+            break;
+        default:
+            // Wide grids have no dual plane and high precision bits
+            mode |= ((range_bits >> 1) << 2) | 0x100 | (b << 9);
+            width = a + 6;
+            height = b + 6;
+            has_flags = false;
+            break;
+        }
+        if (has_flags) {
+            mode |= (high_precision ? 0x200 : 0) | (dual_plane ? 0x400 : 0);
+        }
+        const bool is_dual_plane = has_flags && dual_plane;
+        const u32 num_partitions = 1 + rng() % (is_dual_plane ? 3 : 4);
+        const u32 weight_bits = WeightBits(width * height * (is_dual_plane ? 2 : 1), range_bits,
+                                           has_flags && high_precision);
+        const u32 endpoint_mode = ldr_modes[rng() % ldr_modes.size()];
+        const u32 num_values = num_partitions * ((endpoint_mode / 4) * 2 + 2);
+        const u32 color_bits = 128 - weight_bits - (num_partitions == 1 ? 17 : 29) -
+                               (is_dual_plane ? 2 : 0);
+        if (width > block_width || height > block_height || weight_bits < 24 ||
+            weight_bits > 96 || color_bits < (13 * num_values + 4) / 5) {
+            continue;
+        }
+
+        std::array<u8, 16> block;
+        for (u8& value : block) {
+            value = static_cast<u8>(rng());
+        }
+        SetBits(block, 0, 11, mode);
+        SetBits(block, 11, 2, num_partitions - 1);
+        if (num_partitions == 1) {
+            SetBits(block, 13, 4, endpoint_mode);
+        } else {
+            // Every partition shares the same endpoint mode, the partition index stays random
+            SetBits(block, 23, 6, endpoint_mode << 2);
+        }
+        return block;
+    }
+}
+
+std::vector<u8> MakeBlocks(u32 seed, u32 block_width, u32 block_height, u32 num_blocks) {
+    std::mt19937 rng{seed};
+    std::vector<u8> data;
+    data.reserve(num_blocks * 16);
+    for (u32 i = 0; i < num_blocks; ++i) {
+        const std::array<u8, 16> block = MakeBlock(rng, block_width, block_height);
+        data.insert(data.end(), block.begin(), block.end());
+    }
+    return data;
+}
+
+struct ReferenceHash {
+    u32 block_width;
+    u32 block_height;
+    u64 hash;
+};
+
+// Hashes of the decoder output before its SIMD interpolation and block mode table were added
+constexpr std::array<ReferenceHash, 14> REFERENCE_HASHES{{
+    {4, 4, 0x26fc0cdb1c33d6d6ULL},
+    {5, 4, 0x0ae4e087c7333c90ULL},
+    {5, 5, 0x41fca30ea9ffaaf9ULL},
+    {6, 5, 0x0a8b09294e1be96aULL},
+    {6, 6, 0xc6cad2b90ff67f2fULL},
+    {8, 5, 0x907ac40bdd419dc3ULL},
+    {8, 6, 0x93bf2f98adc2c021ULL},
+    {8, 8, 0x46ea7fc11feeac0eULL},
+    {10, 5, 0x0806da2f30551c81ULL},
+    {10, 6, 0x8868a13466766e48ULL},
+    {10, 8, 0x8f32a5881a72b186ULL},
+    {10, 10, 0xe5a8d965ef2c4269ULL},
+    {12, 10, 0x01927ea04330c040ULL},
+    {12, 12, 0x646067014d43dfb7ULL},
+}};
+} // Anonymous namespace
+
+TEST_CASE("ASTC[VoidExtent]", "[video_core]") {
+    // Constant color block, the color is stored as UNORM16 and truncated to 8 bits
+    std::array<u8, 16> block{};
+    SetBits(block, 0, 12, 0xDFC);
+    // All ones extent coordinates, the color applies to the whole texture
+    SetBits(block, 12, 20, 0xFFFFF);
+    SetBits(block, 32, 32, 0xFFFFFFFF);
+    SetBits(block, 64, 16, 0x12FF);
+    SetBits(block, 80, 16, 0x3400);
+    SetBits(block, 96, 16, 0xABCD);
+    SetBits(block, 112, 16, 0xFFFF);
+
+    std::array<u8, 6 * 5 * 4> output{};
+    Tegra::Texture::ASTC::Decompress(block, 6, 5, 1, 6, 5, output);
+    for (size_t texel = 0; texel < output.size(); texel += 4) {
+        REQUIRE(output[texel + 0] == 0x12);
+        REQUIRE(output[texel + 1] == 0x34);
+        REQUIRE(output[texel + 2] == 0xAB);
+        REQUIRE(output[texel + 3] == 0xFF);
+    }
+}
+
+TEST_CASE("ASTC[MatchesReference]", "[video_core]") {
+    // Two slices of 16x16 blocks, cropped so the last row and column of blocks are partial
+    static constexpr u32 BLOCKS_X = 16;
+    static constexpr u32 BLOCKS_Y = 16;
+    static constexpr u32 DEPTH = 2;
+
+    for (const auto& [block_width, block_height, expected_hash] : REFERENCE_HASHES) {
+        const std::vector<u8> data = MakeBlocks(block_width * 16 + block_height, block_width,
+                                                block_height, BLOCKS_X * BLOCKS_Y * DEPTH);
+        const u32 width = BLOCKS_X * block_width - 1;
+        const u32 height = BLOCKS_Y * block_height - 1;
+        std::vector<u8> output(static_cast<size_t>(width) * height * DEPTH * 4);
+        Tegra::Texture::ASTC::Decompress(data, width, height, DEPTH, block_width, block_height,
+                                         output);
+
+        INFO("Block size " << block_width << "x" << block_height);
+        REQUIRE(Common::CityHash64(reinterpret_cast<const char*>(output.data()), output.size()) ==
+                expected_hash);
+    }
+}
+
+TEST_CASE("ASTC[Benchmark]", "[video_core]") {
+    // 2048x2048 textures, a common size for compressed assets
+    static constexpr u32 SIZE = 2048;
+    static constexpr u32 ITERATIONS = 4;
+
+    static constexpr std::array<std::array<u32, 2>, 3> BLOCK_SIZES{{
+        {4, 4},
+        {8, 8},
+        {12, 12},
+    }};
+
+    std::vector<u8> output(static_cast<size_t>(SIZE) * SIZE * 4);
+    for (const auto& [block_width, block_height] : BLOCK_SIZES) {
+        const u32 num_blocks = ((SIZE + block_width - 1) / block_width) *
+                               ((SIZE + block_height - 1) / block_height);
+        const std::vector<u8> data = MakeBlocks(1, block_width, block_height, num_blocks);
+
+        const auto start = std::chrono::steady_clock::now();
+        for (u32 i = 0; i < ITERATIONS; ++i) {
+            Tegra::Texture::ASTC::Decompress(data, SIZE, SIZE, 1, block_width, block_height,
+                                             output);
+        }
+        const auto time = std::chrono::steady_clock::now() - start;
+
+        const f64 texels = static_cast<f64>(SIZE) * SIZE * ITERATIONS;
+        std::printf("ASTC: %ux%u blocks, %.1f Mtexels/s\n", block_width, block_height,
+                    texels / std::chrono::duration<f64>(time).count() / 1e6);
+    }
+}
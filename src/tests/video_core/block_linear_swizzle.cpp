@@ -0,0 +1,208 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/common_types.h"
+#include "video_core/textures/decoders.h"
+
+using namespace Tegra::Texture;
+
+namespace {
+constexpr std::array<u32, 8> BYTES_PER_PIXEL{1, 2, 3, 4, 6, 8, 12, 16};
+
+constexpr SwizzleTable SWIZZLE_TABLE = MakeSwizzleTable();
+
+/// Byte addressing of a block linear surface computed from the GOB swizzle table.
+struct ReferenceLayout {
+    u32 width_in_bytes;
+    u32 height;
+    u32 block_height;
+    u32 block_depth;
+
+    u32 Offset(u32 x, u32 y, u32 z) const {
+        const u32 gobs_in_x = (width_in_bytes + GOB_SIZE_X - 1) / GOB_SIZE_X;
+        const u32 gobs_per_block = 1U << (block_height + block_depth);
+        const u32 block_row_size = gobs_in_x * gobs_per_block * GOB_SIZE;
+        const u32 block_rows = (height + (GOB_SIZE_Y << block_height) - 1) /
+                               (GOB_SIZE_Y << block_height);
+
+        const u32 gob_x = x / GOB_SIZE_X;
+        const u32 gob_y = y / GOB_SIZE_Y;
+        const u32 block_z = z >> block_depth;
+        const u32 gob_z = z & ((1U << block_depth) - 1);
+        const u32 gob_index = (gob_z << block_height) + (gob_y & ((1U << block_height) - 1));
+        return block_z * block_rows * block_row_size + (gob_y >> block_height) * block_row_size +
+               gob_x * gobs_per_block * GOB_SIZE + gob_index * GOB_SIZE +
+               SWIZZLE_TABLE[y % GOB_SIZE_Y][x % GOB_SIZE_X];
+    }
+};
+
+std::vector<u8> RandomBytes(size_t size, std::mt19937& rng) {
+    std::vector<u8> data(size);
+    for (u8& value : data) {
+        value = static_cast<u8>(rng());
+    }
+    return data;
+}
+
+void ReferenceSwizzle(std::vector<u8>& swizzled, const std::vector<u8>& linear,
+                      const ReferenceLayout& layout, u32 depth) {
+    for (u32 z = 0; z < depth; ++z) {
+        for (u32 y = 0; y < layout.height; ++y) {
+            for (u32 x = 0; x < layout.width_in_bytes; ++x) {
+                const size_t linear_offset =
+                    (static_cast<size_t>(z) * layout.height + y) * layout.width_in_bytes + x;
+                swizzled[layout.Offset(x, y, z)] = linear[linear_offset];
+            }
+        }
+    }
+}
+
+void ReferenceUnswizzle(std::vector<u8>& linear, const std::vector<u8>& swizzled,
+                        const ReferenceLayout& layout, u32 depth) {
+    for (u32 z = 0; z < depth; ++z) {
+        for (u32 y = 0; y < layout.height; ++y) {
+            for (u32 x = 0; x < layout.width_in_bytes; ++x) {
+                const size_t linear_offset =
+                    (static_cast<size_t>(z) * layout.height + y) * layout.width_in_bytes + x;
+                linear[linear_offset] = swizzled[layout.Offset(x, y, z)];
+            }
+        }
+    }
+}
+} // Anonymous namespace
+
+TEST_CASE("BlockLinearSwizzle[Texture]", "[video_core]") {
+    // Strides are not aligned beyond GOBs, like images without tile width spacing
+    std::mt19937 rng{7};
+    for (u32 iteration = 0; iteration < 200; ++iteration) {
+        const u32 bytes_per_pixel = BYTES_PER_PIXEL[rng() % BYTES_PER_PIXEL.size()];
+        const u32 width = 1 + rng() % 200;
+        const u32 height = 1 + rng() % 100;
+        // Every fourth image is a 3D image with enough slices to take the parallel path
+        const u32 depth = iteration % 4 == 0 ? 1 + rng() % 40 : 1;
+        const u32 block_height = rng() % 6;
+        const u32 block_depth = depth > 1 ? rng() % 3 : 0;
+        const ReferenceLayout layout{width * bytes_per_pixel, height, block_height, block_depth};
+        const size_t swizzled_size =
+            CalculateSize(true, bytes_per_pixel, width, height, depth, block_height, block_depth);
+
+        const std::vector<u8> linear =
+            RandomBytes(static_cast<size_t>(width) * height * depth * bytes_per_pixel, rng);
+        const std::vector<u8> initial = RandomBytes(swizzled_size, rng);
+        std::vector<u8> swizzled = initial;
+        std::vector<u8> expected_swizzled = initial;
+        SwizzleTexture(swizzled, linear, bytes_per_pixel, width, height, depth, block_height,
+                       block_depth, 0);
+        ReferenceSwizzle(expected_swizzled, linear, layout, depth);
+        REQUIRE(swizzled == expected_swizzled);
+
+        std::vector<u8> unswizzled(linear.size());
+        std::vector<u8> expected_unswizzled(linear.size());
+        UnswizzleTexture(unswizzled, initial, bytes_per_pixel, width, height, depth, block_height,
+                         block_depth, 0);
+        ReferenceUnswizzle(expected_unswizzled, initial, layout, depth);
+        REQUIRE(unswizzled == expected_unswizzled);
+    }
+}
+
+TEST_CASE("BlockLinearSwizzle[Subrect]", "[video_core]") {
+    std::mt19937 rng{11};
+    for (u32 iteration = 0; iteration < 300; ++iteration) {
+        const u32 bytes_per_pixel = BYTES_PER_PIXEL[rng() % BYTES_PER_PIXEL.size()];
+        const u32 width = 1 + rng() % 200;
+        const u32 height = 1 + rng() % 100;
+        const u32 block_height = rng() % 6;
+        const u32 origin_x = rng() % width;
+        const u32 origin_y = rng() % height;
+        const u32 extent_x = 1 + rng() % (width - origin_x);
+        const u32 extent_y = 1 + rng() % (height - origin_y);
+        const u32 pitch = extent_x * bytes_per_pixel + rng() % 16;
+        const ReferenceLayout layout{width * bytes_per_pixel, height, block_height, 0};
+        const size_t swizzled_size =
+            CalculateSize(true, bytes_per_pixel, width, height, 1, block_height, 0);
+
+        const std::vector<u8> linear = RandomBytes(static_cast<size_t>(pitch) * extent_y, rng);
+        const std::vector<u8> initial = RandomBytes(swizzled_size, rng);
+        std::vector<u8> swizzled = initial;
+        std::vector<u8> expected_swizzled = initial;
+        std::vector<u8> unswizzled(linear.size());
+        std::vector<u8> expected_unswizzled(linear.size());
+
+        SwizzleSubrect(swizzled, linear, bytes_per_pixel, width, height, 1, origin_x, origin_y,
+                       extent_x, extent_y, block_height, 0, pitch);
+        UnswizzleSubrect(unswizzled, initial, bytes_per_pixel, width, height, 1, origin_x,
+                         origin_y, extent_x, extent_y, block_height, 0, pitch);
+        // Pixels are stored whole at the address of their first byte, so the 3, 6 and 12 byte
+        // pixels that straddle 16 byte runs stay contiguous
+        for (u32 line = 0; line < extent_y; ++line) {
+            for (u32 column = 0; column < extent_x; ++column) {
+                const u32 offset = layout.Offset((origin_x + column) * bytes_per_pixel,
+                                                 origin_y + line, 0);
+                const u32 linear_offset = line * pitch + column * bytes_per_pixel;
+                for (u32 byte = 0; byte < bytes_per_pixel; ++byte) {
+                    expected_swizzled[offset + byte] = linear[linear_offset + byte];
+                    expected_unswizzled[linear_offset + byte] = initial[offset + byte];
+                }
+            }
+        }
+        REQUIRE(swizzled == expected_swizzled);
+        REQUIRE(unswizzled == expected_unswizzled);
+    }
+}
+
+TEST_CASE("BlockLinearSwizzle[Benchmark]", "[video_core]") {
+    // 1024x1024 images with a typical block height. Whole images are copied with the widest pixel
+    // size their width allows, subrects keep the pixel size of the format, as used by DMA copies.
+    static constexpr u32 SIZE = 1024;
+    static constexpr u32 BLOCK_HEIGHT = 4;
+    static constexpr u32 ITERATIONS = 10;
+    static constexpr u32 ORIGIN = 3;
+    static constexpr u32 EXTENT = SIZE - 2 * ORIGIN;
+
+    std::mt19937 rng{1};
+    for (const u32 bytes_per_pixel : {1U, 4U, 12U, 16U}) {
+        const u32 pitch = SIZE * bytes_per_pixel;
+        const std::vector<u8> linear = RandomBytes(static_cast<size_t>(pitch) * SIZE, rng);
+        std::vector<u8> swizzled(
+            CalculateSize(true, bytes_per_pixel, SIZE, SIZE, 1, BLOCK_HEIGHT, 0));
+        std::vector<u8> unswizzled(linear.size());
+
+        const auto measure = [&](auto&& func) {
+            const auto start = std::chrono::steady_clock::now();
+            for (u32 i = 0; i < ITERATIONS; ++i) {
+                func();
+            }
+            const auto time = std::chrono::steady_clock::now() - start;
+            return static_cast<f64>(linear.size()) * ITERATIONS /
+                   std::chrono::duration<f64>(time).count() / 1e6;
+        };
+        const f64 swizzle = measure([&] {
+            SwizzleTexture(swizzled, linear, bytes_per_pixel, SIZE, SIZE, 1, BLOCK_HEIGHT, 0, 0);
+        });
+        const f64 unswizzle = measure([&] {
+            UnswizzleTexture(unswizzled, swizzled, bytes_per_pixel, SIZE, SIZE, 1, BLOCK_HEIGHT,
+                             0, 0);
+        });
+        REQUIRE(unswizzled == linear);
+
+        const f64 swizzle_subrect = measure([&] {
+            SwizzleSubrect(swizzled, linear, bytes_per_pixel, SIZE, SIZE, 1, ORIGIN, ORIGIN,
+                           EXTENT, EXTENT, BLOCK_HEIGHT, 0, pitch);
+        });
+        const f64 unswizzle_subrect = measure([&] {
+            UnswizzleSubrect(unswizzled, swizzled, bytes_per_pixel, SIZE, SIZE, 1, ORIGIN, ORIGIN,
+                             EXTENT, EXTENT, BLOCK_HEIGHT, 0, pitch);
+        });
+        std::printf("BlockLinearSwizzle: %u bytes per pixel, swizzle %.0f MB/s, unswizzle %.0f "
+                    "MB/s, subrect swizzle %.0f MB/s, subrect unswizzle %.0f MB/s\n",
+                    bytes_per_pixel, swizzle, unswizzle, swizzle_subrect, unswizzle_subrect);
+    }
+}
@@ -0,0 +1,88 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <filesystem>
+#include <memory>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/common_types.h"
+#include "common/scope_exit.h"
+#include "common/settings.h"
+#include "core/core.h"
+#include "core/frontend/emu_window.h"
+#include "core/frontend/graphics_context.h"
+#include "video_core/command_capture.h"
+#include "video_core/command_replay.h"
+#include "video_core/gpu.h"
+
+namespace {
+using Tegra::BufferMethods;
+using Tegra::CommandHeader;
+using Tegra::SubmissionMode;
+
+class NullWindow final : public Core::Frontend::EmuWindow {
+public:
+    std::unique_ptr<Core::Frontend::GraphicsContext> CreateSharedContext() const override {
+        return std::make_unique<Core::Frontend::GraphicsContext>();
+    }
+
+    bool IsShown() const override {
+        return true;
+    }
+};
+
+CommandHeader Word(u32 value) {
+    CommandHeader header{};
+    header.argument = value;
+    return header;
+}
+} // Anonymous namespace
+
+TEST_CASE("CommandReplay[semaphore_acquire]", "[video_core]") {
+    const auto path = std::filesystem::temp_directory_path() / "yuzu_replay_acquire.ygc";
+    SCOPE_EXIT {
+        std::error_code ec;
+        std::filesystem::remove(path, ec);
+    };
+
+    // The acquire waits for a value nothing in the replay ever writes
+    const std::array<CommandHeader, 5> words{
+        Tegra::BuildCommandHeader(BufferMethods::SemaphoreAddressHigh, 2,
+                                  SubmissionMode::Increasing),
+        Word(0),
+        Word(0x10000),
+        Tegra::BuildCommandHeader(BufferMethods::SemaphoreAcquire, 1, SubmissionMode::Increasing),
+        Word(1),
+    };
+    {
+        Tegra::CommandCaptureWriter writer{path, 0};
+        REQUIRE(writer.IsOpen());
+        writer.WriteList(1, words);
+    }
+
+    const auto renderer_backend = Settings::values.renderer_backend.GetValue();
+    const bool use_async = Settings::values.use_asynchronous_gpu_emulation.GetValue();
+    SCOPE_EXIT {
+        Settings::values.renderer_backend.SetValue(renderer_backend);
+        Settings::values.use_asynchronous_gpu_emulation.SetValue(use_async);
+    };
+    Settings::values.renderer_backend.SetValue(Settings::RendererBackend::Null);
+    Settings::values.use_asynchronous_gpu_emulation.SetValue(false);
+
+    NullWindow window;
+    Core::System system;
+    system.Initialize();
+    REQUIRE(system.LoadGPUOnly(window) == Core::SystemResultStatus::Success);
+    SCOPE_EXIT {
+        system.ShutdownMainProcess();
+    };
+    system.GPU().Start();
+
+    const auto results = Tegra::ReplayCommandCapture(system, path, 2);
+    REQUIRE(results);
+    REQUIRE(results->num_lists == 2);
+    REQUIRE(results->num_words == 2 * words.size());
+    REQUIRE(results->engines.methods[Tegra::DispatchStatistics::PULLER_INDEX] == 2 * 3);
+}
@@ -0,0 +1,179 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/common_types.h"
+#include "common/scope_exit.h"
+#include "common/settings.h"
+#include "core/core.h"
+#include "core/frontend/emu_window.h"
+#include "core/frontend/graphics_context.h"
+#include "video_core/gpu.h"
+#include "video_core/rasterizer_interface.h"
+#include "video_core/renderer_base.h"
+#include "video_core/renderer_null/null_rasterizer.h"
+
+namespace {
+enum class Event {
+    Invalidate,
+    CPUWrite,
+};
+
+struct RecordedEvent {
+    Event event;
+    DAddr addr;
+    u64 size;
+
+    bool operator==(const RecordedEvent&) const = default;
+};
+
+/// Records the cache maintenance requests it receives and ignores everything else
+class RecordingRasterizer final : public VideoCore::RasterizerInterface {
+public:
+    void Draw(bool is_indexed, u32 instance_count) override {}
+    void DrawTexture() override {}
+    void Clear(u32 layer_count) override {}
+    void DispatchCompute() override {}
+    void ResetCounter(VideoCommon::QueryType type) override {}
+    void Query(GPUVAddr gpu_addr, VideoCommon::QueryType type,
+               VideoCommon::QueryPropertiesFlags flags, u32 payload, u32 subreport) override {}
+    void BindGraphicsUniformBuffer(size_t stage, u32 index, GPUVAddr gpu_addr, u32 size) override {}
+    void DisableGraphicsUniformBuffer(size_t stage, u32 index) override {}
+    void SignalFence(std::function<void()>&& func) override {
+        func();
+    }
+    void SyncOperation(std::function<void()>&& func) override {
+        func();
+    }
+    void SignalSyncPoint(u32 value) override {}
+    void SignalReference() override {}
+    void ReleaseFences(bool force) override {}
+    void FlushAll() override {}
+    void FlushRegion(DAddr addr, u64 size, VideoCommon::CacheType which) override {}
+    bool MustFlushRegion(DAddr addr, u64 size, VideoCommon::CacheType which) override {
+        return false;
+    }
+    VideoCore::RasterizerDownloadArea GetFlushArea(DAddr addr, u64 size) override {
+        return {.start_address = addr, .end_address = addr + size, .preemtive = true};
+    }
+    void InvalidateRegion(DAddr addr, u64 size, VideoCommon::CacheType which) override {}
+    void OnCacheInvalidation(DAddr addr, u64 size) override {
+        Record(Event::Invalidate, addr, size);
+    }
+    bool OnCPUWrite(DAddr addr, u64 size) override {
+        Record(Event::CPUWrite, addr, size);
+        return false;
+    }
+    void InvalidateGPUCache() override {}
+    void UnmapMemory(DAddr addr, u64 size) override {}
+    void ModifyGPUMemory(size_t as_id, GPUVAddr addr, u64 size) override {}
+    void FlushAndInvalidateRegion(DAddr addr, u64 size, VideoCommon::CacheType which) override {}
+    void WaitForIdle() override {}
+    void FragmentBarrier() override {}
+    void TiledCacheBarrier() override {}
+    void FlushCommands() override {}
+    void TickFrame() override {}
+    bool AccelerateSurfaceCopy(const Tegra::Engines::Fermi2D::Surface& src,
+                               const Tegra::Engines::Fermi2D::Surface& dst,
+                               const Tegra::Engines::Fermi2D::Config& copy_config) override {
+        return true;
+    }
+    Tegra::Engines::AccelerateDMAInterface& AccessAccelerateDMA() override {
+        return accelerate_dma;
+    }
+    void AccelerateInlineToMemory(GPUVAddr address, size_t copy_size,
+                                  std::span<const u8> memory) override {}
+    void LoadDiskResources(u64 title_id, std::stop_token stop_loading,
+                           const VideoCore::DiskResourceLoadCallback& callback) override {}
+
+    [[nodiscard]] std::vector<RecordedEvent> Events() {
+        std::scoped_lock lk{mutex};
+        return events;
+    }
+
+private:
+    void Record(Event event, DAddr addr, u64 size) {
+        std::scoped_lock lk{mutex};
+        events.push_back({event, addr, size});
+    }
+
+    Null::AccelerateDMA accelerate_dma;
+    std::mutex mutex;
+    std::vector<RecordedEvent> events;
+};
+
+class RecordingRenderer final : public VideoCore::RendererBase {
+public:
+    explicit RecordingRenderer(Core::Frontend::EmuWindow& window,
+                               std::unique_ptr<Core::Frontend::GraphicsContext> context_)
+        : RendererBase(window, std::move(context_)) {}
+
+    void Composite(std::span<const Tegra::FramebufferConfig> layers) override {}
+    std::vector<u8> GetAppletCaptureBuffer() override {
+        return {};
+    }
+    VideoCore::RasterizerInterface* ReadRasterizer() override {
+        return &rasterizer;
+    }
+    std::string GetDeviceVendor() const override {
+        return "Recording";
+    }
+
+    RecordingRasterizer rasterizer;
+};
+
+class NullWindow final : public Core::Frontend::EmuWindow {
+public:
+    std::unique_ptr<Core::Frontend::GraphicsContext> CreateSharedContext() const override {
+        return std::make_unique<Core::Frontend::GraphicsContext>();
+    }
+
+    bool IsShown() const override {
+        return true;
+    }
+};
+} // Anonymous namespace
+
+TEST_CASE("GPUThread[invalidation_order]", "[video_core]") {
+    const auto renderer_backend = Settings::values.renderer_backend.GetValue();
+    const bool use_async = Settings::values.use_asynchronous_gpu_emulation.GetValue();
+    SCOPE_EXIT {
+        Settings::values.renderer_backend.SetValue(renderer_backend);
+        Settings::values.use_asynchronous_gpu_emulation.SetValue(use_async);
+    };
+    Settings::values.renderer_backend.SetValue(Settings::RendererBackend::Null);
+    Settings::values.use_asynchronous_gpu_emulation.SetValue(true);
+
+    NullWindow window;
+    Core::System system;
+    system.Initialize();
+    REQUIRE(system.LoadGPUOnly(window) == Core::SystemResultStatus::Success);
+    SCOPE_EXIT {
+        system.ShutdownMainProcess();
+    };
+
+    auto& gpu = system.GPU();
+    auto renderer = std::make_unique<RecordingRenderer>(window, window.CreateSharedContext());
+    RecordingRasterizer& rasterizer = renderer->rasterizer;
+    gpu.BindRenderer(std::move(renderer));
+    gpu.Start();
+
+    // No command is queued in between, CPU side queries must still see every invalidation
+    gpu.InvalidateRegion(0x10000, 0x1000);
+    gpu.OnCPUWrite(0x10000, 4);
+    gpu.FlushAndInvalidateRegion(0x20000, 0x1000);
+    gpu.OnCPUWrite(0x20000, 8);
+
+    const std::vector<RecordedEvent> expected{
+        {Event::Invalidate, 0x10000, 0x1000},
+        {Event::CPUWrite, 0x10000, 4},
+        {Event::Invalidate, 0x20000, 0x1000},
+        {Event::CPUWrite, 0x20000, 8},
+    };
+    REQUIRE(rasterizer.Events() == expected);
+}
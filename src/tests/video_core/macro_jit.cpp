@@ -0,0 +1,232 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/common_types.h"
+#include "core/core.h"
+#include "core/device_memory.h"
+#include "video_core/engines/maxwell_3d.h"
+#include "video_core/host1x/gpu_device_memory_manager.h"
+#include "video_core/macro/macro.h"
+#include "video_core/macro/macro_interpreter.h"
+#include "video_core/memory_manager.h"
+
+namespace {
+using namespace Tegra::Macro;
+using Tegra::Engines::Maxwell3D;
+
+// Shader program registers, writing to them from a macro has no side effects
+constexpr u32 SCRATCH_METHOD = MAXWELL3D_REG_INDEX(pipelines);
+constexpr u32 METHOD_INCREMENT = 1 << 12;
+constexpr u32 MACRO_METHOD = 0;
+
+Opcode MakeOpcode(Operation operation, ResultOperation result, u32 dst, u32 src_a) {
+    Opcode opcode{};
+    opcode.operation.Assign(operation);
+    opcode.result_operation.Assign(result);
+    opcode.dst.Assign(dst);
+    opcode.src_a.Assign(src_a);
+    return opcode;
+}
+
+u32 Alu(ALUOperation alu_operation, ResultOperation result, u32 dst, u32 src_a, u32 src_b) {
+    Opcode opcode = MakeOpcode(Operation::ALU, result, dst, src_a);
+    opcode.src_b.Assign(src_b);
+    opcode.alu_operation.Assign(alu_operation);
+    return opcode.raw;
+}
+
+u32 Immediate(Operation operation, ResultOperation result, u32 dst, u32 src_a, s32 immediate) {
+    Opcode opcode = MakeOpcode(operation, result, dst, src_a);
+    opcode.immediate.Assign(immediate);
+    return opcode.raw;
+}
+
+u32 AddImmediate(ResultOperation result, u32 dst, u32 src_a, s32 immediate) {
+    return Immediate(Operation::AddImmediate, result, dst, src_a, immediate);
+}
+
+u32 Read(ResultOperation result, u32 dst, u32 src_a, s32 immediate) {
+    return Immediate(Operation::Read, result, dst, src_a, immediate);
+}
+
+u32 Bitfield(Operation operation, ResultOperation result, u32 dst, u32 src_a, u32 src_b,
+             u32 src_bit, u32 size, u32 dst_bit) {
+    Opcode opcode = MakeOpcode(operation, result, dst, src_a);
+    opcode.src_b.Assign(src_b);
+    opcode.bf_src_bit.Assign(src_bit);
+    opcode.bf_size.Assign(size);
+    opcode.bf_dst_bit.Assign(dst_bit);
+    return opcode.raw;
+}
+
+u32 Branch(BranchCondition condition, bool annul, u32 src_a, s32 offset) {
+    Opcode opcode{};
+    opcode.operation.Assign(Operation::Branch);
+    opcode.branch_condition.Assign(condition);
+    opcode.branch_annul.Assign(annul ? 1 : 0);
+    opcode.src_a.Assign(src_a);
+    opcode.immediate.Assign(offset);
+    return opcode.raw;
+}
+
+u32 Exit(u32 raw) {
+    Opcode opcode{raw};
+    opcode.is_exit.Assign(1);
+    return opcode.raw;
+}
+
+u32 Nop() {
+    return AddImmediate(ResultOperation::Move, 0, 0, 0);
+}
+
+u32 SetMethod(u32 reg, u32 method) {
+    return AddImmediate(ResultOperation::MoveAndSetMethod, reg, 0, static_cast<s32>(method));
+}
+
+struct MacroProgram {
+    std::vector<u32> code;
+    std::vector<u32> parameters;
+};
+
+/// Runs programs through the interpreter and the host macro engine on separate Maxwell3D instances
+class MacroHarness {
+public:
+    MacroHarness()
+        : device_memory_manager{device_memory}, memory_manager{system, device_memory_manager},
+          interpreted_3d{std::make_unique<Maxwell3D>(system, memory_manager)},
+          compiled_3d{std::make_unique<Maxwell3D>(system, memory_manager)} {}
+
+    void Run(const MacroProgram& program) {
+        Tegra::MacroInterpreter interpreter{*interpreted_3d};
+        const auto compiled{Tegra::GetMacroEngine(*compiled_3d)};
+        for (const u32 word : program.code) {
+            interpreter.AddCode(MACRO_METHOD, word);
+            compiled->AddCode(MACRO_METHOD, word);
+        }
+        interpreter.Execute(MACRO_METHOD, program.parameters);
+        compiled->Execute(MACRO_METHOD, program.parameters);
+    }
+
+    /// Returns true when both engines left the same register state behind
+    [[nodiscard]] bool RegistersMatch() const {
+        return std::ranges::equal(interpreted_3d->regs.reg_array, compiled_3d->regs.reg_array);
+    }
+
+    [[nodiscard]] u32 InterpretedRegister(u32 method) const {
+        return interpreted_3d->regs.reg_array[method];
+    }
+
+private:
+    Core::System system;
+    Core::DeviceMemory device_memory;
+    Tegra::MaxwellDeviceMemoryManager device_memory_manager;
+    Tegra::MemoryManager memory_manager;
+    std::unique_ptr<Maxwell3D> interpreted_3d;
+    std::unique_ptr<Maxwell3D> compiled_3d;
+};
+} // Anonymous namespace
+
+TEST_CASE("MacroJIT[alu]", "[video_core]") {
+    MacroHarness harness;
+    harness.Run({
+        .code{
+            AddImmediate(ResultOperation::IgnoreAndFetch, 2, 0, 0),
+            SetMethod(7, SCRATCH_METHOD | METHOD_INCREMENT),
+            Alu(ALUOperation::Add, ResultOperation::MoveAndSend, 3, 1, 2),
+            Alu(ALUOperation::AddWithCarry, ResultOperation::MoveAndSend, 3, 2, 2),
+            Alu(ALUOperation::Subtract, ResultOperation::MoveAndSend, 4, 2, 1),
+            Alu(ALUOperation::SubtractWithBorrow, ResultOperation::MoveAndSend, 4, 2, 1),
+            Alu(ALUOperation::Xor, ResultOperation::MoveAndSend, 5, 1, 2),
+            Alu(ALUOperation::Or, ResultOperation::MoveAndSend, 5, 1, 2),
+            Alu(ALUOperation::And, ResultOperation::MoveAndSend, 5, 1, 2),
+            Alu(ALUOperation::AndNot, ResultOperation::MoveAndSend, 5, 1, 2),
+            Alu(ALUOperation::Nand, ResultOperation::MoveAndSend, 5, 1, 2),
+            AddImmediate(ResultOperation::MoveAndSend, 6, 1, 1),
+            AddImmediate(ResultOperation::MoveAndSend, 6, 1, 2),
+            AddImmediate(ResultOperation::MoveAndSend, 6, 1, -3),
+            Exit(AddImmediate(ResultOperation::MoveAndSend, 6, 1, 0x1ffff)),
+            Nop(),
+        },
+        .parameters{0xfffffff0, 0x20},
+    });
+    REQUIRE(harness.InterpretedRegister(SCRATCH_METHOD) == 0x10);
+    REQUIRE(harness.RegistersMatch());
+}
+
+TEST_CASE("MacroJIT[bitfield]", "[video_core]") {
+    MacroHarness harness;
+    harness.Run({
+        .code{
+            AddImmediate(ResultOperation::IgnoreAndFetch, 2, 0, 0),
+            SetMethod(7, SCRATCH_METHOD | METHOD_INCREMENT),
+            Bitfield(Operation::ExtractInsert, ResultOperation::MoveAndSend, 3, 1, 2, 0, 4, 8),
+            Bitfield(Operation::ExtractInsert, ResultOperation::MoveAndSend, 3, 1, 1, 28, 8, 30),
+            Bitfield(Operation::ExtractShiftLeftImmediate, ResultOperation::MoveAndSend, 4, 2, 1,
+                     0, 12, 4),
+            Bitfield(Operation::ExtractShiftLeftImmediate, ResultOperation::MoveAndSend, 4, 2, 1,
+                     0, 0, 4),
+            Bitfield(Operation::ExtractShiftLeftRegister, ResultOperation::MoveAndSend, 5, 2, 1,
+                     16, 8, 0),
+            Exit(Bitfield(Operation::ExtractShiftLeftRegister, ResultOperation::MoveAndSend, 5, 2,
+                          1, 24, 16, 0)),
+            Nop(),
+        },
+        .parameters{0xdeadbeef, 5},
+    });
+    REQUIRE(harness.RegistersMatch());
+}
+
+TEST_CASE("MacroJIT[branch]", "[video_core]") {
+    MacroHarness harness;
+    harness.Run({
+        .code{
+            SetMethod(7, SCRATCH_METHOD | METHOD_INCREMENT),
+            AddImmediate(ResultOperation::IgnoreAndFetch, 2, 0, 0),
+            // Loop body, sends r1 + r3 once per iteration
+            Alu(ALUOperation::Add, ResultOperation::MoveAndSend, 4, 1, 3),
+            AddImmediate(ResultOperation::Move, 2, 2, -1),
+            Branch(BranchCondition::NotZero, false, 2, -2),
+            // Delay slot, also executed when the loop falls through
+            AddImmediate(ResultOperation::Move, 3, 3, 3),
+            // Annulled branch skips the next instruction
+            Branch(BranchCondition::Zero, true, 0, 2),
+            AddImmediate(ResultOperation::MoveAndSend, 5, 0, 0x55),
+            Exit(AddImmediate(ResultOperation::MoveAndSend, 6, 3, 1)),
+            // Exit delay slot
+            AddImmediate(ResultOperation::MoveAndSend, 6, 6, 1),
+        },
+        .parameters{0x100, 4},
+    });
+    REQUIRE(harness.InterpretedRegister(SCRATCH_METHOD + 4) == 13);
+    REQUIRE(harness.RegistersMatch());
+}
+
+TEST_CASE("MacroJIT[result_operations]", "[video_core]") {
+    MacroHarness harness;
+    harness.Run({
+        .code{
+            SetMethod(7, SCRATCH_METHOD + 0x10),
+            Alu(ALUOperation::Add, ResultOperation::MoveAndSend, 2, 1, 1),
+            Read(ResultOperation::Move, 3, 0, SCRATCH_METHOD + 0x10),
+            AddImmediate(ResultOperation::MoveAndSetMethodFetchAndSend, 4, 0,
+                         SCRATCH_METHOD + 0x11),
+            AddImmediate(ResultOperation::FetchAndSetMethod, 5, 0, SCRATCH_METHOD + 0x12),
+            Alu(ALUOperation::Add, ResultOperation::FetchAndSend, 6, 3, 5),
+            AddImmediate(ResultOperation::MoveAndSetMethodSend, 4, 0,
+                         SCRATCH_METHOD + 0x13 + 3 * METHOD_INCREMENT),
+            AddImmediate(ResultOperation::MoveAndSend, 4, 4, 7),
+            Read(ResultOperation::MoveAndSend, 4, 0, SCRATCH_METHOD + 0x10),
+            Exit(Read(ResultOperation::MoveAndSend, 4, 7, 1)),
+            Nop(),
+        },
+        .parameters{0x1234, 0x5678, 0x9abc, 0xdef0},
+    });
+    REQUIRE(harness.InterpretedRegister(SCRATCH_METHOD + 0x10) == 0x2468);
+    REQUIRE(harness.RegistersMatch());
+}
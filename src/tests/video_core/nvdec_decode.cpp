@@ -0,0 +1,149 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/common_types.h"
+#include "common/scope_exit.h"
+#include "common/settings.h"
+#include "video_core/host1x/ffmpeg/ffmpeg.h"
+
+namespace {
+using Tegra::Host1x::NvdecCommon::VideoCodec;
+
+struct Stream {
+    VideoCodec codec;
+    std::vector<std::vector<u8>> packets;
+};
+
+std::vector<u8> ReadFile(const char* path) {
+    std::ifstream file{path, std::ios::binary};
+    return {std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+}
+
+/// Splits an H.264 Annex B stream into access units, each one is a Nvdec picture.
+std::vector<std::vector<u8>> SplitAnnexB(std::span<const u8> data) {
+    std::vector<std::vector<u8>> units;
+    size_t unit_begin = 0;
+    bool has_slice = false;
+    for (size_t i = 0; i + 3 < data.size(); ++i) {
+        if (data[i] != 0 || data[i + 1] != 0 || data[i + 2] != 1) {
+            continue;
+        }
+        const size_t nal_begin = i > 0 && data[i - 1] == 0 ? i - 1 : i;
+        const u8 header = data[i + 3];
+        const u32 type = header & 0x1f;
+        const bool is_slice = type == 1 || type == 5;
+        bool starts_unit = false;
+        if (is_slice) {
+            // The first slice of a picture starts at macroblock 0, coded as a single set bit
+            starts_unit = i + 4 < data.size() && (data[i + 4] & 0x80) != 0;
+        } else {
+            // SEI, SPS, PPS, access unit delimiters and the reserved types before slices
+            starts_unit = (type >= 6 && type <= 9) || (type >= 14 && type <= 18);
+        }
+        if (has_slice && starts_unit) {
+            units.emplace_back(data.begin() + unit_begin, data.begin() + nal_begin);
+            unit_begin = nal_begin;
+            has_slice = false;
+        }
+        has_slice |= is_slice;
+        i += 2;
+    }
+    if (unit_begin < data.size()) {
+        units.emplace_back(data.begin() + unit_begin, data.end());
+    }
+    return units;
+}
+
+/// Reads the frames of an IVF file, the container of raw VP8 and VP9 streams.
+std::optional<Stream> ParseIvf(std::span<const u8> data) {
+    static constexpr size_t FRAME_HEADER_SIZE = 12;
+    if (data.size() < 32 || std::memcmp(data.data(), "DKIF", 4) != 0) {
+        return std::nullopt;
+    }
+    Stream stream{};
+    if (std::memcmp(data.data() + 8, "VP80", 4) == 0) {
+        stream.codec = VideoCodec::VP8;
+    } else if (std::memcmp(data.data() + 8, "VP90", 4) == 0) {
+        stream.codec = VideoCodec::VP9;
+    } else {
+        return std::nullopt;
+    }
+    size_t offset = data[6] | (data[7] << 8);
+    while (offset + FRAME_HEADER_SIZE <= data.size()) {
+        u32 frame_size;
+        std::memcpy(&frame_size, data.data() + offset, sizeof(frame_size));
+        offset += FRAME_HEADER_SIZE;
+        if (offset + frame_size > data.size()) {
+            break;
+        }
+        stream.packets.emplace_back(data.begin() + offset, data.begin() + offset + frame_size);
+        offset += frame_size;
+    }
+    return stream;
+}
+
+std::optional<Stream> ParseStream(std::string_view path, std::span<const u8> data) {
+    if (path.ends_with(".ivf")) {
+        return ParseIvf(data);
+    }
+    if (path.ends_with(".h264") || path.ends_with(".264")) {
+        return Stream{VideoCodec::H264, SplitAnnexB(data)};
+    }
+    return std::nullopt;
+}
+} // Anonymous namespace
+
+TEST_CASE("Nvdec[DecodeBenchmark]", "[video_core]") {
+    // Decodes a local elementary stream through the FFmpeg decoder of the Nvdec, one picture per
+    // packet. Set YUZU_NVDEC_BENCHMARK_STREAM to an H.264 Annex B (.h264) or VP8/VP9 (.ivf) file.
+    const char* const path = std::getenv("YUZU_NVDEC_BENCHMARK_STREAM");
+    if (path == nullptr) {
+        return;
+    }
+    const std::optional<Stream> stream = ParseStream(path, ReadFile(path));
+    REQUIRE(stream.has_value());
+    REQUIRE(!stream->packets.empty());
+
+    const auto nvdec_emulation = Settings::values.nvdec_emulation.GetValue();
+    SCOPE_EXIT {
+        Settings::values.nvdec_emulation.SetValue(nvdec_emulation);
+    };
+    Settings::values.nvdec_emulation.SetValue(Settings::NvdecEmulation::Cpu);
+    FFmpeg::DecodeApi decode_api;
+    REQUIRE(decode_api.Initialize(stream->codec));
+
+    size_t num_frames = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (const std::vector<u8>& packet : stream->packets) {
+        if (!decode_api.SendPacket(packet)) {
+            continue;
+        }
+        // Receive the frames like Tegra::Decoder, dropping them returns them to the frame pool
+        if (decode_api.UsingDecodeOrder()) {
+            num_frames += decode_api.ReceiveFrame() ? 1 : 0;
+            continue;
+        }
+        while (decode_api.ReceiveFrame()) {
+            ++num_frames;
+        }
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+
+    REQUIRE(num_frames > 0);
+    const f64 seconds = std::chrono::duration<f64>(elapsed).count();
+    std::printf("Nvdec: %zu packets, %zu frames in %.3f s, %.1f fps\n", stream->packets.size(),
+                num_frames, seconds, static_cast<f64>(num_frames) / seconds);
+}
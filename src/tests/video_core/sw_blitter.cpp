@@ -0,0 +1,98 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/common_types.h"
+#include "video_core/engines/sw_blitter/converter.h"
+
+namespace {
+using Tegra::RenderTargetFormat;
+using Tegra::Engines::Blitter::ConverterFactory;
+
+struct FormatInfo {
+    RenderTargetFormat format;
+    const char* name;
+    size_t bytes_per_pixel;
+};
+
+constexpr std::array BENCHMARK_FORMATS{
+    FormatInfo{RenderTargetFormat::A8B8G8R8_UNORM, "A8B8G8R8_UNORM", 4},
+    FormatInfo{RenderTargetFormat::A8R8G8B8_UNORM, "A8R8G8B8_UNORM", 4},
+    FormatInfo{RenderTargetFormat::A8B8G8R8_SRGB, "A8B8G8R8_SRGB", 4},
+    FormatInfo{RenderTargetFormat::A2B10G10R10_UNORM, "A2B10G10R10_UNORM", 4},
+    FormatInfo{RenderTargetFormat::R16G16B16A16_FLOAT, "R16G16B16A16_FLOAT", 8},
+    FormatInfo{RenderTargetFormat::R32G32B32A32_FLOAT, "R32G32B32A32_FLOAT", 16},
+    FormatInfo{RenderTargetFormat::R5G6B5_UNORM, "R5G6B5_UNORM", 2},
+};
+} // Anonymous namespace
+
+TEST_CASE("SoftwareBlitter[ConvertUnorm8]", "[video_core]") {
+    ConverterFactory factory;
+    auto* const converter = factory.GetFormatConverter(RenderTargetFormat::A8B8G8R8_UNORM);
+    std::vector<u8> pixels(256 * 4);
+    for (size_t i = 0; i < pixels.size(); ++i) {
+        pixels[i] = static_cast<u8>(i / 4);
+    }
+    std::vector<f32> intermediate(pixels.size());
+    converter->ConvertTo(pixels, intermediate);
+    for (size_t i = 0; i < intermediate.size(); ++i) {
+        REQUIRE(intermediate[i] == static_cast<f32>(i / 4) / 255.0f);
+    }
+    std::vector<u8> result(pixels.size());
+    converter->ConvertFrom(intermediate, result);
+    for (size_t i = 0; i < result.size(); ++i) {
+        REQUIRE(static_cast<s32>(result[i]) - static_cast<s32>(pixels[i]) <= 0);
+        REQUIRE(static_cast<s32>(result[i]) - static_cast<s32>(pixels[i]) >= -1);
+    }
+}
+
+TEST_CASE("SoftwareBlitter[ConvertFloat16]", "[video_core]") {
+    ConverterFactory factory;
+    auto* const converter = factory.GetFormatConverter(RenderTargetFormat::R16G16B16A16_FLOAT);
+    const std::array<u16, 4> pixel{0x3c00, 0xc000, 0x3555, 0x3800};
+    std::array<f32, 4> intermediate{};
+    converter->ConvertTo(std::span{reinterpret_cast<const u8*>(pixel.data()), sizeof(pixel)},
+                         intermediate);
+    REQUIRE(intermediate == std::array<f32, 4>{1.0f, -2.0f, 0.333251953125f, 0.5f});
+
+    std::array<u16, 4> result{};
+    converter->ConvertFrom(intermediate,
+                           std::span{reinterpret_cast<u8*>(result.data()), sizeof(result)});
+    REQUIRE(result == pixel);
+}
+
+TEST_CASE("SoftwareBlitter[ConverterBenchmark]", "[video_core]") {
+    static constexpr size_t NUM_PIXELS = 512 * 512;
+
+    ConverterFactory factory;
+    std::vector<f32> intermediate(NUM_PIXELS * 4);
+    std::vector<u8> input(NUM_PIXELS * 16);
+    std::vector<u8> output(NUM_PIXELS * 16);
+    for (size_t i = 0; i < input.size(); ++i) {
+        // Odd bytes keep every float component within [0, 1]
+        input[i] = static_cast<u8>(i % 2 == 1 ? 0x3b : i * 7);
+    }
+
+    for (const FormatInfo& src : BENCHMARK_FORMATS) {
+        for (const FormatInfo& dst : BENCHMARK_FORMATS) {
+            auto* const input_converter = factory.GetFormatConverter(src.format);
+            auto* const output_converter = factory.GetFormatConverter(dst.format);
+            const auto start = std::chrono::steady_clock::now();
+            input_converter->ConvertTo(std::span{input.data(), NUM_PIXELS * src.bytes_per_pixel},
+                                       intermediate);
+            output_converter->ConvertFrom(
+                intermediate, std::span{output.data(), NUM_PIXELS * dst.bytes_per_pixel});
+            const auto elapsed = std::chrono::steady_clock::now() - start;
+            const f64 seconds = std::chrono::duration<f64>(elapsed).count();
+            std::printf("SoftwareBlitter: %s -> %s %.1f Mpixels/s\n", src.name, dst.name,
+                        static_cast<f64>(NUM_PIXELS) / seconds / 1e6);
+        }
+    }
+}
@@ -0,0 +1,92 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cstring>
+
+#include "common/fs/path_util.h"
+#include "common/logging/log.h"
+#include "video_core/command_capture.h"
+
+namespace Tegra {
+
+CommandCaptureWriter::CommandCaptureWriter(const std::filesystem::path& path, u64 program_id)
+    : file{path, Common::FS::FileAccessMode::Write, Common::FS::FileType::BinaryFile} {
+    if (!file.IsOpen()) {
+        LOG_ERROR(HW_GPU, "Failed to create command capture at {}",
+                  Common::FS::PathToUTF8String(path));
+        return;
+    }
+    const CaptureHeader header{
+        .magic = CAPTURE_MAGIC,
+        .version = CAPTURE_VERSION,
+        .program_id = program_id,
+    };
+    if (!file.WriteObject(header)) {
+        LOG_ERROR(HW_GPU, "Failed to write command capture header");
+        file.Close();
+        return;
+    }
+    LOG_INFO(HW_GPU, "Capturing GPU command stream to {}", Common::FS::PathToUTF8String(path));
+}
+
+CommandCaptureWriter::~CommandCaptureWriter() {
+    if (file.IsOpen()) {
+        LOG_INFO(HW_GPU, "Captured {} command lists", num_lists);
+    }
+}
+
+void CommandCaptureWriter::WriteList(s32 channel, std::span<const CommandHeader> words) {
+    std::scoped_lock lock{mutex};
+    if (!file.IsOpen()) {
+        return;
+    }
+    const CaptureListHeader list_header{
+        .channel = channel,
+        .num_words = static_cast<u32>(words.size()),
+    };
+    if (!file.WriteObject(list_header) || file.WriteSpan(words) != words.size()) {
+        LOG_ERROR(HW_GPU, "Failed to write command capture, stopping capture");
+        file.Close();
+        return;
+    }
+    ++num_lists;
+}
+
+CommandCaptureReader::CommandCaptureReader(const std::filesystem::path& path) : file{path} {
+    const std::span<const u8> data = file.Data();
+    if (data.size() < sizeof(CaptureHeader)) {
+        return;
+    }
+    std::memcpy(&header, data.data(), sizeof(header));
+    if (header.magic != CAPTURE_MAGIC || header.version != CAPTURE_VERSION) {
+        LOG_ERROR(HW_GPU, "Invalid command capture version {}", header.version);
+        return;
+    }
+    position = sizeof(CaptureHeader);
+    is_valid = true;
+}
+
+std::optional<CapturedList> CommandCaptureReader::Next() {
+    const std::span<const u8> data = file.Data();
+    if (!is_valid || data.size() - position < sizeof(CaptureListHeader)) {
+        return std::nullopt;
+    }
+    CaptureListHeader list_header;
+    std::memcpy(&list_header, data.data() + position, sizeof(list_header));
+    position += sizeof(list_header);
+
+    const size_t words_size = static_cast<size_t>(list_header.num_words) * sizeof(CommandHeader);
+    if (data.size() - position < words_size) {
+        LOG_WARNING(HW_GPU, "Command capture is truncated");
+        position = data.size();
+        return std::nullopt;
+    }
+    const auto* const words = reinterpret_cast<const CommandHeader*>(data.data() + position);
+    position += words_size;
+    return CapturedList{
+        .channel = list_header.channel,
+        .words{words, list_header.num_words},
+    };
+}
+
+} // namespace Tegra
@@ -0,0 +1,94 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <span>
+
+#include "common/common_types.h"
+#include "common/fs/file.h"
+#include "common/fs/mapped_file.h"
+#include "video_core/dma_pusher.h"
+
+namespace Tegra {
+
+/**
+ * Command stream captures store every command list executed by the DMA pushers, already resolved
+ * from guest memory, so they can be replayed without the guest application.
+ *
+ * Layout: a CaptureHeader followed by one CaptureListHeader per command list, each followed by
+ * num_words command words.
+ */
+struct CaptureHeader {
+    u32 magic;
+    u32 version;
+    u64 program_id;
+};
+static_assert(sizeof(CaptureHeader) == 16);
+
+struct CaptureListHeader {
+    s32 channel;
+    u32 num_words;
+};
+static_assert(sizeof(CaptureListHeader) == 8);
+
+constexpr u32 CAPTURE_MAGIC = 0x53434759; // "YGCS"
+constexpr u32 CAPTURE_VERSION = 1;
+
+/// Appends executed command lists to a capture file, shared by all channels of a GPU
+class CommandCaptureWriter {
+public:
+    explicit CommandCaptureWriter(const std::filesystem::path& path, u64 program_id);
+    ~CommandCaptureWriter();
+
+    [[nodiscard]] bool IsOpen() const {
+        return file.IsOpen();
+    }
+
+    /// Writes a command list executed on channel
+    void WriteList(s32 channel, std::span<const CommandHeader> words);
+
+private:
+    std::mutex mutex;
+    Common::FS::IOFile file;
+    u64 num_lists{};
+};
+
+struct CapturedList {
+    s32 channel;
+    std::span<const CommandHeader> words;
+};
+
+/// Reads command lists back from a memory mapped capture file
+class CommandCaptureReader {
+public:
+    explicit CommandCaptureReader(const std::filesystem::path& path);
+
+    /// Returns true when the file was mapped and has a valid header
+    [[nodiscard]] bool IsValid() const noexcept {
+        return is_valid;
+    }
+
+    [[nodiscard]] u64 ProgramId() const noexcept {
+        return header.program_id;
+    }
+
+    /// Returns the next command list, or nullopt at the end of the capture
+    [[nodiscard]] std::optional<CapturedList> Next();
+
+    /// Restarts reading from the first command list
+    void Rewind() noexcept {
+        position = sizeof(CaptureHeader);
+    }
+
+private:
+    Common::FS::MappedFile file;
+    CaptureHeader header{};
+    size_t position{};
+    bool is_valid{};
+};
+
+} // namespace Tegra
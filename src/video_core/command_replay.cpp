@@ -0,0 +1,72 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <memory>
+#include <numeric>
+#include <unordered_map>
+
+#include "common/fs/path_util.h"
+#include "common/logging/log.h"
+#include "core/core.h"
+#include "video_core/command_capture.h"
+#include "video_core/command_replay.h"
+#include "video_core/control/channel_state.h"
+#include "video_core/gpu.h"
+#include "video_core/memory_manager.h"
+
+namespace Tegra {
+
+std::optional<ReplayResults> ReplayCommandCapture(Core::System& system,
+                                                  const std::filesystem::path& path,
+                                                  u32 iterations) {
+    CommandCaptureReader reader{path};
+    if (!reader.IsValid()) {
+        LOG_ERROR(HW_GPU, "Failed to open command capture {}", Common::FS::PathToUTF8String(path));
+        return std::nullopt;
+    }
+    GPU& gpu = system.GPU();
+    ReplayResults results{};
+
+    // Map captured channel ids to channels created for the replay
+    std::unordered_map<s32, std::shared_ptr<Control::ChannelState>> channels;
+    const auto get_channel = [&](s32 captured_channel) {
+        auto& channel = channels[captured_channel];
+        if (!channel) {
+            channel = gpu.AllocateChannel();
+            channel->memory_manager = std::make_shared<MemoryManager>(system);
+            gpu.InitAddressSpace(*channel->memory_manager);
+            gpu.InitChannel(*channel, reader.ProgramId());
+            channel->dma_pusher->SetStatistics(&results.engines);
+            channel->dma_pusher->SetReplayMode(true);
+        }
+        return channel->bind_id;
+    };
+
+    const auto start = std::chrono::steady_clock::now();
+    for (u32 iteration = 0; iteration < iterations; ++iteration) {
+        reader.Rewind();
+        while (const std::optional<CapturedList> list = reader.Next()) {
+            if (list->words.empty()) {
+                continue;
+            }
+            const s32 channel = get_channel(list->channel);
+            CommandList entries;
+            entries.prefetch_command_list.assign(list->words.begin(), list->words.end());
+            gpu.PushGPUEntries(channel, std::move(entries));
+
+            ++results.num_lists;
+            results.num_words += list->words.size();
+        }
+    }
+    results.time = std::chrono::steady_clock::now() - start;
+    results.num_methods =
+        std::accumulate(results.engines.methods.begin(), results.engines.methods.end(), u64{0});
+
+    for (const auto& [captured_channel, channel] : channels) {
+        channel->dma_pusher->SetStatistics(nullptr);
+        channel->dma_pusher->SetReplayMode(false);
+    }
+    return results;
+}
+
+} // namespace Tegra
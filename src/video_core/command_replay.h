@@ -0,0 +1,43 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <chrono>
+#include <filesystem>
+#include <optional>
+
+#include "common/common_types.h"
+#include "video_core/dma_pusher.h"
+
+namespace Core {
+class System;
+}
+
+namespace Tegra {
+
+struct ReplayResults {
+    u64 num_lists{};                 ///< Command lists submitted
+    u64 num_words{};                 ///< Command words submitted
+    u64 num_methods{};               ///< Methods dispatched to the puller and the engines
+    std::chrono::nanoseconds time{}; ///< Wall time spent replaying
+    DispatchStatistics engines;      ///< Per engine breakdown
+};
+
+/**
+ * Replays a command stream capture made with dump_gpu_commands as fast as possible.
+ * Captured channels are recreated with empty address spaces, so engines reading guest memory see
+ * zeroes, which keeps the replay deterministic. Semaphore acquires complete immediately since
+ * nothing in the replay would ever release them. The GPU must run in synchronous mode.
+ *
+ * @param system      System owning the GPU, powered on without an application
+ * @param path        Path to the capture file
+ * @param iterations  Number of times the whole capture is submitted
+ *
+ * @returns Replay statistics, or nullopt when the capture could not be read.
+ */
+[[nodiscard]] std::optional<ReplayResults> ReplayCommandCapture(Core::System& system,
+                                                                const std::filesystem::path& path,
+                                                                u32 iterations = 1);
+
+} // namespace Tegra
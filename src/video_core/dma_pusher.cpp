@@ -5,6 +5,8 @@
 #include "common/microprofile.h"
 #include "common/settings.h"
 #include "core/core.h"
+#include "video_core/command_capture.h"
+#include "video_core/control/channel_state.h"
 #include "video_core/dma_pusher.h"
 #include "video_core/engines/maxwell_3d.h"
 #include "video_core/gpu.h"
@@ -18,8 +20,9 @@ constexpr u32 ComputeInline = 0x6D;
 
 DmaPusher::DmaPusher(Core::System& system_, GPU& gpu_, MemoryManager& memory_manager_,
                      Control::ChannelState& channel_state_)
-    : gpu{gpu_}, system{system_}, memory_manager{memory_manager_}, puller{gpu_, memory_manager_,
-                                                                          *this, channel_state_} {}
+    : gpu{gpu_}, system{system_}, memory_manager{memory_manager_},
+      puller{gpu_, memory_manager_, *this, channel_state_}, channel_id{channel_state_.bind_id},
+      capture{gpu_.CommandCapture()} {}
 
 DmaPusher::~DmaPusher() = default;
 
@@ -39,6 +42,11 @@ void DmaPusher::DispatchCalls() {
     }
     gpu.FlushCommands();
     gpu.OnCommandListEnd();
+
+    if (capture && !capture_buffer.empty()) {
+        capture->WriteList(channel_id, capture_buffer);
+        capture_buffer.clear();
+    }
 }
 
 bool DmaPusher::Step() {
@@ -117,6 +125,9 @@ bool DmaPusher::Step() {
 }
 
 void DmaPusher::ProcessCommands(std::span<const CommandHeader> commands) {
+    if (capture) {
+        capture_buffer.insert(capture_buffer.end(), commands.begin(), commands.end());
+    }
     for (std::size_t index = 0; index < commands.size();) {
         const CommandHeader& command_header = commands[index];
 
@@ -131,6 +142,14 @@ void DmaPusher::ProcessCommands(std::span<const CommandHeader> commands) {
                 dma_state.is_last_call = true;
                 index += max_write;
                 continue;
+            } else if (const u32 run = StreamRunLength(commands, index); run > 1) {
+                // Registers feeding the same stream (e.g. CB_DATA[i]) are consumed in one call
+                dma_state.is_last_call = dma_state.method_count <= run;
+                CallMultiMethod(&command_header.argument, run);
+                dma_state.method += run;
+                dma_state.method_count -= run;
+                index += run;
+                continue;
             } else {
                 dma_state.is_last_call = dma_state.method_count <= 1;
                 CallMethod(command_header.argument);
@@ -186,7 +205,55 @@ void DmaPusher::SetState(const CommandHeader& command_header) {
     dma_state.method_count = command_header.method_count;
 }
 
+u32 DmaPusher::StreamRunLength(std::span<const CommandHeader> commands,
+                               std::size_t index) const {
+    const auto* const engine = subchannels[dma_state.subchannel];
+    if (dma_increment_once || dma_state.method < non_puller_methods || !engine) {
+        return 0;
+    }
+    const auto& stream_mask = engine->stream_mask;
+    const u32 max_run = static_cast<u32>(
+        std::min<std::size_t>(dma_state.method_count, commands.size() - index));
+    u32 run = 0;
+    while (run < max_run && dma_state.method + run < stream_mask.size() &&
+           stream_mask[dma_state.method + run]) {
+        ++run;
+    }
+    return run;
+}
+
 void DmaPusher::CallMethod(u32 argument) const {
+    if (statistics) [[unlikely]] {
+        const size_t engine{CurrentEngineIndex()};
+        const auto start{std::chrono::steady_clock::now()};
+        DispatchMethod(argument);
+        statistics->time[engine] += std::chrono::steady_clock::now() - start;
+        ++statistics->methods[engine];
+        return;
+    }
+    DispatchMethod(argument);
+}
+
+void DmaPusher::CallMultiMethod(const u32* base_start, u32 num_methods) const {
+    if (statistics) [[unlikely]] {
+        const size_t engine{CurrentEngineIndex()};
+        const auto start{std::chrono::steady_clock::now()};
+        DispatchMultiMethod(base_start, num_methods);
+        statistics->time[engine] += std::chrono::steady_clock::now() - start;
+        statistics->methods[engine] += num_methods;
+        return;
+    }
+    DispatchMultiMethod(base_start, num_methods);
+}
+
+size_t DmaPusher::CurrentEngineIndex() const noexcept {
+    if (dma_state.method < non_puller_methods) {
+        return DispatchStatistics::PULLER_INDEX;
+    }
+    return static_cast<size_t>(subchannel_type[dma_state.subchannel]);
+}
+
+void DmaPusher::DispatchMethod(u32 argument) const {
     if (dma_state.method < non_puller_methods) {
         puller.CallPullerMethod(Engines::Puller::MethodCall{
             dma_state.method,
@@ -206,7 +273,7 @@ void DmaPusher::CallMethod(u32 argument) const {
     }
 }
 
-void DmaPusher::CallMultiMethod(const u32* base_start, u32 num_methods) const {
+void DmaPusher::DispatchMultiMethod(const u32* base_start, u32 num_methods) const {
     if (dma_state.method < non_puller_methods) {
         puller.CallMultiMethod(dma_state.method, dma_state.subchannel, base_start, num_methods,
                                dma_state.method_count);
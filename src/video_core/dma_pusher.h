@@ -4,6 +4,7 @@
 #pragma once
 
 #include <array>
+#include <chrono>
 #include <span>
 #include <vector>
 #include <boost/container/small_vector.hpp>
@@ -25,6 +26,7 @@ namespace Control {
 struct ChannelState;
 }
 
+class CommandCaptureWriter;
 class GPU;
 class MemoryManager;
 
@@ -111,6 +113,17 @@ struct CommandList final {
     boost::container::small_vector<CommandHeader, 512> prefetch_command_list;
 };
 
+/// Per engine method counters and execution time, collected while replaying command streams
+struct DispatchStatistics {
+    /// Engine slots follow Engines::EngineTypes, the last slot accounts for puller methods
+    static constexpr size_t NUM_ENGINES =
+        static_cast<size_t>(Engines::EngineTypes::KeplerMemory) + 2;
+    static constexpr size_t PULLER_INDEX = NUM_ENGINES - 1;
+
+    std::array<u64, NUM_ENGINES> methods{};
+    std::array<std::chrono::nanoseconds, NUM_ENGINES> time{};
+};
+
 /**
  * The DmaPusher class implements DMA submission to FIFOs, providing an area of memory that the
  * emulated app fills with commands and tells PFIFO to process. The pushbuffers are then assembled
@@ -138,6 +151,16 @@ public:
 
     void BindRasterizer(VideoCore::RasterizerInterface* rasterizer);
 
+    /// Starts timing method calls per engine into statistics, nullptr stops collecting
+    void SetStatistics(DispatchStatistics* statistics_) {
+        statistics = statistics_;
+    }
+
+    /// Makes the puller complete semaphore acquires immediately, see Puller::SetReplayMode
+    void SetReplayMode(bool replay_mode) {
+        puller.SetReplayMode(replay_mode);
+    }
+
 private:
     static constexpr u32 non_puller_methods = 0x40;
     static constexpr u32 max_subchannels = 8;
@@ -146,9 +169,18 @@ private:
 
     void SetState(const CommandHeader& command_header);
 
+    /// Returns how many of the next incrementing words write registers of the same stream
+    [[nodiscard]] u32 StreamRunLength(std::span<const CommandHeader> commands,
+                                      std::size_t index) const;
+
     void CallMethod(u32 argument) const;
     void CallMultiMethod(const u32* base_start, u32 num_methods) const;
 
+    void DispatchMethod(u32 argument) const;
+    void DispatchMultiMethod(const u32* base_start, u32 num_methods) const;
+
+    [[nodiscard]] size_t CurrentEngineIndex() const noexcept;
+
     Common::ScratchBuffer<CommandHeader>
         command_headers; ///< Buffer for list of commands fetched at once
 
@@ -178,6 +210,11 @@ private:
     Core::System& system;
     MemoryManager& memory_manager;
     mutable Engines::Puller puller;
+
+    s32 channel_id;
+    CommandCaptureWriter* capture;
+    std::vector<CommandHeader> capture_buffer; ///< Words of the command list being captured
+    DispatchStatistics* statistics{};
 };
 
 } // namespace Tegra
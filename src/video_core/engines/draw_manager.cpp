@@ -1,6 +1,8 @@
 // SPDX-FileCopyrightText: Copyright 2022 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <cstring>
+
 #include "common/settings.h"
 #include "video_core/dirty_flags.h"
 #include "video_core/engines/draw_manager.h"
@@ -67,6 +69,42 @@ void DrawManager::ProcessMethodCall(u32 method, u32 argument) {
     }
 }
 
+void DrawManager::ProcessInlineIndices(u32 method, std::span<const u32> arguments) {
+    auto& indexes{draw_state.inline_index_draw_indexes};
+    const size_t offset{indexes.size()};
+    switch (method) {
+    case MAXWELL3D_REG_INDEX(draw_inline_index):
+        indexes.resize(offset + arguments.size_bytes());
+        std::memcpy(indexes.data() + offset, arguments.data(), arguments.size_bytes());
+        break;
+    case MAXWELL3D_REG_INDEX(inline_index_2x16.even): {
+        indexes.resize(offset + arguments.size_bytes() * 2);
+        u8* out{indexes.data() + offset};
+        for (const u32 argument : arguments) {
+            const std::array<u32, 2> unpacked{argument & 0xffff, argument >> 16};
+            std::memcpy(out, unpacked.data(), sizeof(unpacked));
+            out += sizeof(unpacked);
+        }
+        break;
+    }
+    case MAXWELL3D_REG_INDEX(inline_index_4x8.index0): {
+        indexes.resize(offset + arguments.size_bytes() * 4);
+        u8* out{indexes.data() + offset};
+        for (const u32 argument : arguments) {
+            const std::array<u32, 4> unpacked{argument & 0xff, (argument >> 8) & 0xff,
+                                              (argument >> 16) & 0xff, argument >> 24};
+            std::memcpy(out, unpacked.data(), sizeof(unpacked));
+            out += sizeof(unpacked);
+        }
+        break;
+    }
+    default:
+        ASSERT_MSG(false, "Invalid inline index method {:#x}", method);
+        return;
+    }
+    draw_state.draw_mode = DrawMode::InlineIndex;
+}
+
 void DrawManager::Clear(u32 layer_count) {
     if (maxwell3d->ShouldExecute()) {
         maxwell3d->rasterizer->Clear(layer_count);
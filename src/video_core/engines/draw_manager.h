@@ -2,6 +2,8 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #pragma once
+#include <span>
+
 #include "common/common_types.h"
 #include "video_core/engines/maxwell_3d.h"
 
@@ -60,6 +62,9 @@ public:
 
     void ProcessMethodCall(u32 method, u32 argument);
 
+    /// Appends a run of arguments written to one of the inline index registers
+    void ProcessInlineIndices(u32 method, std::span<const u32> arguments);
+
     void Clear(u32 layer_count);
 
     void DrawDeferred();
@@ -38,6 +38,9 @@ public:
     }
 
     std::bitset<std::numeric_limits<u16>::max()> execution_mask{};
+    /// Registers that append their argument to a data stream. Consecutive registers in this mask
+    /// must feed the same stream, so incrementing writes to them can be sent as one multi method.
+    std::bitset<std::numeric_limits<u16>::max()> stream_mask{};
     std::vector<std::pair<u32, u32>> method_sink{};
     bool current_dirty{};
     GPUVAddr current_dma_segment;
@@ -33,6 +33,10 @@ Maxwell3D::Maxwell3D(Core::System& system_, MemoryManager& memory_manager_)
     for (size_t i = 0; i < execution_mask.size(); i++) {
         execution_mask[i] = IsMethodExecutable(static_cast<u32>(i));
     }
+    stream_mask.reset();
+    for (size_t i = 0; i < Regs::NumCBData; i++) {
+        stream_mask[MAXWELL3D_REG_INDEX(const_buffer.buffer) + i] = true;
+    }
 }
 
 Maxwell3D::~Maxwell3D() = default;
@@ -464,7 +468,21 @@ void Maxwell3D::CallMultiMethod(u32 method, const u32* base_start, u32 amount,
         upload_state.ProcessData(base_start, amount);
         return;
     }
+    case MAXWELL3D_REG_INDEX(draw_inline_index):
+    case MAXWELL3D_REG_INDEX(inline_index_2x16.even):
+    case MAXWELL3D_REG_INDEX(inline_index_4x8.index0):
+        if (shadow_state.shadow_ram_control != Regs::ShadowRamControl::Replay) {
+            ProcessDirtyRegisters(method, ProcessShadowRam(method, base_start[amount - 1]));
+            draw_manager->ProcessInlineIndices(method, {base_start, amount});
+            return;
+        }
+        [[fallthrough]];
     default:
+        if (!execution_mask[method]) {
+            // Plain register writes have no side effects, only the last value is observable
+            CallMethod(method, base_start[amount - 1], methods_pending - amount + 1 <= 1);
+            break;
+        }
         for (u32 i = 0; i < amount; i++) {
             CallMethod(method, base_start[i], methods_pending - i <= 1);
         }
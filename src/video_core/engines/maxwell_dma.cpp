@@ -3,6 +3,7 @@
 
 #include "common/algorithm.h"
 #include "common/assert.h"
+#include "common/div_ceil.h"
 #include "common/logging/log.h"
 #include "common/microprofile.h"
 #include "common/polyfill_ranges.h"
@@ -28,6 +29,49 @@ namespace Tegra::Engines {
 
 using namespace Texture;
 
+namespace {
+/// Range of the block rows of a block linear surface touched by a copy.
+struct TouchedRows {
+    size_t offset;
+    size_t size;
+    u32 origin_y;
+    u32 height;
+    bool is_first_slice;
+};
+
+/**
+ * Finds the block rows touched by a copy of num_lines lines starting at origin_y, along with the
+ * origin and height relative to the first of them. Partial updates then only read and write back
+ * those rows instead of the whole surface. Copies spilling into other slices touch everything.
+ */
+TouchedRows GetTouchedRows(u32 bytes_per_pixel, u32 width, u32 height, u32 depth, u32 origin_y,
+                           u32 num_lines, u32 block_height, u32 block_depth) {
+    if (depth == 0 || origin_y >= height || num_lines > height - origin_y) {
+        return {
+            .offset = 0,
+            .size = CalculateSize(true, bytes_per_pixel, width, height, depth, block_height,
+                                  block_depth),
+            .origin_y = origin_y,
+            .height = height,
+            .is_first_slice = false,
+        };
+    }
+    const u32 row_shift = GOB_SIZE_Y_SHIFT + block_height;
+    const size_t row_size =
+        CalculateSize(true, bytes_per_pixel, width, 1U << row_shift, 1, block_height, block_depth);
+    const u32 first_row = origin_y >> row_shift;
+    const u32 end_row = Common::DivCeilLog2(origin_y + num_lines, row_shift);
+    const u32 skipped_lines = first_row << row_shift;
+    return {
+        .offset = first_row * row_size,
+        .size = (end_row - first_row) * row_size,
+        .origin_y = origin_y - skipped_lines,
+        .height = height - skipped_lines,
+        .is_first_slice = true,
+    };
+}
+} // Anonymous namespace
+
 MaxwellDMA::MaxwellDMA(Core::System& system_, MemoryManager& memory_manager_)
     : system{system_}, memory_manager{memory_manager_} {
     execution_mask.reset();
@@ -221,18 +265,19 @@ void MaxwellDMA::CopyBlockLinearToPitch() {
     const u32 depth = src_params.depth;
     const u32 block_height = src_params.block_size.height;
     const u32 block_depth = src_params.block_size.depth;
-    const size_t src_size =
-        CalculateSize(true, bytes_per_pixel, width, height, depth, block_height, block_depth);
+    const TouchedRows src_rows = GetTouchedRows(bytes_per_pixel, width, height, depth,
+                                                src_params.origin.y, regs.line_count,
+                                                block_height, block_depth);
 
     const size_t dst_size = dst_operand.pitch * regs.line_count;
 
     Tegra::Memory::GpuGuestMemory<u8, Tegra::Memory::GuestMemoryFlags::SafeRead> tmp_read_buffer(
-        memory_manager, src_operand.address, src_size, &read_buffer);
+        memory_manager, src_operand.address + src_rows.offset, src_rows.size, &read_buffer);
     Tegra::Memory::GpuGuestMemoryScoped<u8, Tegra::Memory::GuestMemoryFlags::UnsafeReadCachedWrite>
         tmp_write_buffer(memory_manager, dst_operand.address, dst_size, &write_buffer);
 
-    UnswizzleSubrect(tmp_write_buffer, tmp_read_buffer, bytes_per_pixel, width, height, depth,
-                     x_offset, src_params.origin.y, x_elements, regs.line_count, block_height,
+    UnswizzleSubrect(tmp_write_buffer, tmp_read_buffer, bytes_per_pixel, width, src_rows.height,
+                     depth, x_offset, src_rows.origin_y, x_elements, regs.line_count, block_height,
                      block_depth, dst_operand.pitch);
 }
 
@@ -284,20 +329,21 @@ void MaxwellDMA::CopyPitchToBlockLinear() {
     const u32 depth = dst_params.depth;
     const u32 block_height = dst_params.block_size.height;
     const u32 block_depth = dst_params.block_size.depth;
-    const size_t dst_size =
-        CalculateSize(true, bytes_per_pixel, width, height, depth, block_height, block_depth);
+    const TouchedRows dst_rows = GetTouchedRows(bytes_per_pixel, width, height, depth,
+                                                dst_params.origin.y, regs.line_count,
+                                                block_height, block_depth);
     const size_t src_size = static_cast<size_t>(regs.pitch_in) * regs.line_count;
 
     GPUVAddr src_addr = regs.offset_in;
-    GPUVAddr dst_addr = regs.offset_out;
+    GPUVAddr dst_addr = regs.offset_out + dst_rows.offset;
     Tegra::Memory::GpuGuestMemory<u8, Tegra::Memory::GuestMemoryFlags::SafeRead> tmp_read_buffer(
         memory_manager, src_addr, src_size, &read_buffer);
     Tegra::Memory::GpuGuestMemoryScoped<u8, Tegra::Memory::GuestMemoryFlags::UnsafeReadCachedWrite>
-        tmp_write_buffer(memory_manager, dst_addr, dst_size, &write_buffer);
+        tmp_write_buffer(memory_manager, dst_addr, dst_rows.size, &write_buffer);
 
     //  If the input is linear and the output is tiled, swizzle the input and copy it over.
-    SwizzleSubrect(tmp_write_buffer, tmp_read_buffer, bytes_per_pixel, width, height, depth,
-                   x_offset, dst_params.origin.y, x_elements, regs.line_count, block_height,
+    SwizzleSubrect(tmp_write_buffer, tmp_read_buffer, bytes_per_pixel, width, dst_rows.height,
+                   depth, x_offset, dst_rows.origin_y, x_elements, regs.line_count, block_height,
                    block_depth, regs.pitch_in);
 }
 
@@ -306,7 +352,7 @@ void MaxwellDMA::CopyBlockLinearToBlockLinear() {
 
     const bool is_remapping = regs.launch_dma.remap_enable != 0;
 
-    // Deswizzle the input and copy it over.
+    // Copy the tiled input into the tiled output.
     const DMA::Parameters& src = regs.src_params;
     const DMA::Parameters& dst = regs.dst_params;
 
@@ -334,28 +380,45 @@ void MaxwellDMA::CopyBlockLinearToBlockLinear() {
     }
 
     const u32 bytes_per_pixel = base_bpp << bpp_shift;
-    const size_t src_size = CalculateSize(true, bytes_per_pixel, src_width, src.height, src.depth,
-                                          src.block_size.height, src.block_size.depth);
-    const size_t dst_size = CalculateSize(true, bytes_per_pixel, dst_width, dst.height, dst.depth,
-                                          dst.block_size.height, dst.block_size.depth);
+    const TouchedRows src_rows =
+        GetTouchedRows(bytes_per_pixel, src_width, src.height, src.depth, src.origin.y,
+                       regs.line_count, src.block_size.height, src.block_size.depth);
+    const TouchedRows dst_rows =
+        GetTouchedRows(bytes_per_pixel, dst_width, dst.height, dst.depth, dst.origin.y,
+                       regs.line_count, dst.block_size.height, dst.block_size.depth);
+    const GPUVAddr src_addr = regs.offset_in + src_rows.offset;
+    const GPUVAddr dst_addr = regs.offset_out + dst_rows.offset;
+
+    Tegra::Memory::GpuGuestMemory<u8, Tegra::Memory::GuestMemoryFlags::SafeRead> tmp_read_buffer(
+        memory_manager, src_addr, src_rows.size, &read_buffer);
+    Tegra::Memory::GpuGuestMemoryScoped<u8, Tegra::Memory::GuestMemoryFlags::SafeReadCachedWrite>
+        tmp_write_buffer(memory_manager, dst_addr, dst_rows.size, &write_buffer);
+
+    // Overlapping copies go through a linear intermediate so no source data is overwritten before
+    // it is read.
+    const bool is_overlapping =
+        src_addr < dst_addr + dst_rows.size && dst_addr < src_addr + src_rows.size;
+    if (src_rows.is_first_slice && dst_rows.is_first_slice && !is_overlapping) {
+        CopySwizzledSubrect(tmp_write_buffer, tmp_read_buffer, bytes_per_pixel, dst_width,
+                            dst_x_offset, dst_rows.origin_y, dst.block_size.height,
+                            dst.block_size.depth, src_width, src_x_offset, src_rows.origin_y,
+                            src.block_size.height, src.block_size.depth, x_elements,
+                            regs.line_count);
+        return;
+    }
 
     const u32 pitch = x_elements * bytes_per_pixel;
     const size_t mid_buffer_size = pitch * regs.line_count;
 
     intermediate_buffer.resize_destructive(mid_buffer_size);
 
-    Tegra::Memory::GpuGuestMemory<u8, Tegra::Memory::GuestMemoryFlags::SafeRead> tmp_read_buffer(
-        memory_manager, regs.offset_in, src_size, &read_buffer);
-    Tegra::Memory::GpuGuestMemoryScoped<u8, Tegra::Memory::GuestMemoryFlags::SafeReadCachedWrite>
-        tmp_write_buffer(memory_manager, regs.offset_out, dst_size, &write_buffer);
-
-    UnswizzleSubrect(intermediate_buffer, tmp_read_buffer, bytes_per_pixel, src_width, src.height,
-                     src.depth, src_x_offset, src.origin.y, x_elements, regs.line_count,
-                     src.block_size.height, src.block_size.depth, pitch);
+    UnswizzleSubrect(intermediate_buffer, tmp_read_buffer, bytes_per_pixel, src_width,
+                     src_rows.height, src.depth, src_x_offset, src_rows.origin_y, x_elements,
+                     regs.line_count, src.block_size.height, src.block_size.depth, pitch);
 
-    SwizzleSubrect(tmp_write_buffer, intermediate_buffer, bytes_per_pixel, dst_width, dst.height,
-                   dst.depth, dst_x_offset, dst.origin.y, x_elements, regs.line_count,
-                   dst.block_size.height, dst.block_size.depth, pitch);
+    SwizzleSubrect(tmp_write_buffer, intermediate_buffer, bytes_per_pixel, dst_width,
+                   dst_rows.height, dst.depth, dst_x_offset, dst_rows.origin_y, x_elements,
+                   regs.line_count, dst.block_size.height, dst.block_size.depth, pitch);
 }
 
 void MaxwellDMA::ReleaseSemaphore() {
@@ -123,6 +123,10 @@ void Puller::ProcessSemaphoreRelease() {
 }
 
 void Puller::ProcessSemaphoreAcquire() {
+    if (replay_mode) {
+        // Semaphores live in guest memory that replays don't have, nothing would release them
+        return;
+    }
     u32 word = memory_manager.Read<u32>(regs.semaphore_address.SemaphoreAddress());
     const auto value = regs.semaphore_acquire;
     while (word != value) {
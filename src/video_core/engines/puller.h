@@ -16,6 +16,7 @@ class System;
 }
 
 namespace Tegra {
+class GPU;
 class MemoryManager;
 class DmaPusher;
 
@@ -84,6 +85,12 @@ public:
     void CallEngineMultiMethod(u32 method, u32 subchannel, const u32* base_start, u32 amount,
                                u32 methods_pending);
 
+    /// Completes semaphore acquires without waiting, used when replaying command captures whose
+    /// guest memory was not captured
+    void SetReplayMode(bool replay_mode_) {
+        replay_mode = replay_mode_;
+    }
+
 private:
     Tegra::GPU& gpu;
 
@@ -91,6 +98,7 @@ private:
     DmaPusher& dma_pusher;
     Control::ChannelState& channel_state;
     VideoCore::RasterizerInterface* rasterizer = nullptr;
+    bool replay_mode{};
 
     static constexpr std::size_t NUM_REGS = 0x800;
     struct Regs {
@@ -3,9 +3,13 @@
 
 #include <algorithm>
 #include <cmath>
+#include <thread>
 #include <vector>
 
+#include "common/assert.h"
+#include "common/div_ceil.h"
 #include "common/scratch_buffer.h"
+#include "common/thread_worker.h"
 #include "video_core/engines/sw_blitter/blitter.h"
 #include "video_core/engines/sw_blitter/converter.h"
 #include "video_core/guest_memory.h"
@@ -28,15 +32,24 @@ namespace {
 
 constexpr size_t ir_components = 4;
 
-void NearestNeighbor(std::span<const u8> input, std::span<u8> output, u32 src_width, u32 src_height,
-                     u32 dst_width, u32 dst_height, size_t bpp) {
+/// Blits with fewer pixels than this are not worth splitting across threads
+constexpr size_t ParallelBlitThreshold = 256 * 256;
+
+/// Upper bound of threads used by a single blit
+constexpr size_t MaxBlitThreads = 8;
+
+template <size_t bpp>
+void NearestNeighbor(std::span<const u8> input, std::span<u8> output, u32 src_width,
+                     u32 src_height, u32 dst_width, u32 dst_height, size_t first_row,
+                     size_t end_row) {
     const size_t dx_du = std::llround((static_cast<f64>(src_width) / dst_width) * (1ULL << 32));
     const size_t dy_dv = std::llround((static_cast<f64>(src_height) / dst_height) * (1ULL << 32));
-    size_t src_y = 0;
-    for (u32 y = 0; y < dst_height; y++) {
+    size_t src_y = first_row * dy_dv;
+    for (size_t y = first_row; y < end_row; y++) {
+        const size_t src_row = (src_y >> 32) * src_width;
         size_t src_x = 0;
         for (u32 x = 0; x < dst_width; x++) {
-            const size_t read_from = ((src_y * src_width + src_x) >> 32) * bpp;
+            const size_t read_from = (src_row + (src_x >> 32)) * bpp;
             const size_t write_to = (y * dst_width + x) * bpp;
 
             std::memcpy(&output[write_to], &input[read_from], bpp);
@@ -46,15 +59,41 @@ void NearestNeighbor(std::span<const u8> input, std::span<u8> output, u32 src_wi
     }
 }
 
+void NearestNeighbor(std::span<const u8> input, std::span<u8> output, u32 src_width, u32 src_height,
+                     u32 dst_width, u32 dst_height, size_t bpp, size_t first_row, size_t end_row) {
+    // Dispatch on the pixel size so every copy is a single fixed size load and store
+    switch (bpp) {
+    case 1:
+        return NearestNeighbor<1>(input, output, src_width, src_height, dst_width, dst_height,
+                                  first_row, end_row);
+    case 2:
+        return NearestNeighbor<2>(input, output, src_width, src_height, dst_width, dst_height,
+                                  first_row, end_row);
+    case 4:
+        return NearestNeighbor<4>(input, output, src_width, src_height, dst_width, dst_height,
+                                  first_row, end_row);
+    case 8:
+        return NearestNeighbor<8>(input, output, src_width, src_height, dst_width, dst_height,
+                                  first_row, end_row);
+    case 16:
+        return NearestNeighbor<16>(input, output, src_width, src_height, dst_width, dst_height,
+                                   first_row, end_row);
+    default:
+        UNIMPLEMENTED_MSG("Unsupported bytes per pixel {}", bpp);
+    }
+}
+
 void NearestNeighborFast(std::span<const f32> input, std::span<f32> output, u32 src_width,
-                         u32 src_height, u32 dst_width, u32 dst_height) {
+                         u32 src_height, u32 dst_width, u32 dst_height, size_t first_row,
+                         size_t end_row) {
     const size_t dx_du = std::llround((static_cast<f64>(src_width) / dst_width) * (1ULL << 32));
     const size_t dy_dv = std::llround((static_cast<f64>(src_height) / dst_height) * (1ULL << 32));
-    size_t src_y = 0;
-    for (u32 y = 0; y < dst_height; y++) {
+    size_t src_y = first_row * dy_dv;
+    for (size_t y = first_row; y < end_row; y++) {
+        const size_t src_row = (src_y >> 32) * src_width;
         size_t src_x = 0;
         for (u32 x = 0; x < dst_width; x++) {
-            const size_t read_from = ((src_y * src_width + src_x) >> 32) * ir_components;
+            const size_t read_from = (src_row + (src_x >> 32)) * ir_components;
             const size_t write_to = (y * dst_width + x) * ir_components;
 
             std::memcpy(&output[write_to], &input[read_from], sizeof(f32) * ir_components);
@@ -65,48 +104,38 @@ void NearestNeighborFast(std::span<const f32> input, std::span<f32> output, u32
 }
 
 void Bilinear(std::span<const f32> input, std::span<f32> output, size_t src_width,
-              size_t src_height, size_t dst_width, size_t dst_height) {
-    const auto bilinear_sample = [](std::span<const f32> x0_y0, std::span<const f32> x1_y0,
-                                    std::span<const f32> x0_y1, std::span<const f32> x1_y1,
-                                    f32 weight_x, f32 weight_y) {
-        std::array<f32, ir_components> result{};
-        for (size_t i = 0; i < ir_components; i++) {
-            const f32 a = std::lerp(x0_y0[i], x1_y0[i], weight_x);
-            const f32 b = std::lerp(x0_y1[i], x1_y1[i], weight_x);
-            result[i] = std::lerp(a, b, weight_y);
-        }
-        return result;
-    };
+              size_t src_height, size_t dst_width, size_t dst_height, size_t first_row,
+              size_t end_row) {
     const f32 dx_du =
         dst_width > 1 ? static_cast<f32>(src_width - 1) / static_cast<f32>(dst_width - 1) : 0.f;
     const f32 dy_dv =
         dst_height > 1 ? static_cast<f32>(src_height - 1) / static_cast<f32>(dst_height - 1) : 0.f;
-    for (u32 y = 0; y < dst_height; y++) {
-        for (u32 x = 0; x < dst_width; x++) {
-            const f32 x_low = std::floor(static_cast<f32>(x) * dx_du);
-            const f32 y_low = std::floor(static_cast<f32>(y) * dy_dv);
-            const f32 x_high = std::ceil(static_cast<f32>(x) * dx_du);
-            const f32 y_high = std::ceil(static_cast<f32>(y) * dy_dv);
-            const f32 weight_x = (static_cast<f32>(x) * dx_du) - x_low;
-            const f32 weight_y = (static_cast<f32>(y) * dy_dv) - y_low;
-
-            const auto read_src = [&](f32 in_x, f32 in_y) {
-                const size_t read_from =
-                    ((static_cast<size_t>(in_x) * src_width + static_cast<size_t>(in_y)) >> 32) *
-                    ir_components;
-                return std::span<const f32>(&input[read_from], ir_components);
-            };
-
-            auto x0_y0 = read_src(x_low, y_low);
-            auto x1_y0 = read_src(x_high, y_low);
-            auto x0_y1 = read_src(x_low, y_high);
-            auto x1_y1 = read_src(x_high, y_high);
-
-            const auto result = bilinear_sample(x0_y0, x1_y0, x0_y1, x1_y1, weight_x, weight_y);
-
-            const size_t write_to = (y * dst_width + x) * ir_components;
-
-            std::memcpy(&output[write_to], &result, sizeof(f32) * ir_components);
+    for (size_t y = first_row; y < end_row; y++) {
+        const f32 src_y = static_cast<f32>(y) * dy_dv;
+        const f32 y_low = std::floor(src_y);
+        const f32 weight_y = src_y - y_low;
+        const size_t row_low = static_cast<size_t>(y_low);
+        const size_t row_high = std::min(static_cast<size_t>(std::ceil(src_y)), src_height - 1);
+        const f32* const input_low = &input[row_low * src_width * ir_components];
+        const f32* const input_high = &input[row_high * src_width * ir_components];
+        f32* const output_row = &output[y * dst_width * ir_components];
+        for (size_t x = 0; x < dst_width; x++) {
+            const f32 src_x = static_cast<f32>(x) * dx_du;
+            const f32 x_low = std::floor(src_x);
+            const f32 weight_x = src_x - x_low;
+            const size_t column_low = static_cast<size_t>(x_low) * ir_components;
+            const size_t column_high =
+                std::min(static_cast<size_t>(std::ceil(src_x)), src_width - 1) * ir_components;
+
+            std::array<f32, ir_components> result;
+            for (size_t i = 0; i < ir_components; i++) {
+                const f32 a = std::lerp(input_low[column_low + i], input_low[column_high + i],
+                                        weight_x);
+                const f32 b = std::lerp(input_high[column_low + i], input_high[column_high + i],
+                                        weight_x);
+                result[i] = std::lerp(a, b, weight_y);
+            }
+            std::memcpy(&output_row[x * ir_components], result.data(), sizeof(result));
         }
     }
 }
@@ -128,12 +157,36 @@ void ProcessPitchLinear(std::span<const u8> input, std::span<u8> output, size_t
 } // namespace
 
 struct SoftwareBlitEngine::BlitEngineImpl {
+    /// Runs func(first_row, end_row) over all the rows, split across threads for large blits
+    template <typename Func>
+    void ForEachRowRange(size_t num_rows, size_t num_pixels, Func&& func) {
+        const size_t num_threads =
+            std::min<size_t>(std::thread::hardware_concurrency(), MaxBlitThreads);
+        if (num_pixels < ParallelBlitThreshold || num_threads <= 1 || num_rows <= 1) {
+            func(0, num_rows);
+            return;
+        }
+        if (!workers) {
+            // The calling thread takes one of the ranges
+            workers = std::make_unique<Common::ThreadWorker>(num_threads - 1, "SoftwareBlitter");
+        }
+        const size_t rows_per_range = Common::DivCeil(num_rows, num_threads);
+        for (size_t first_row = rows_per_range; first_row < num_rows;
+             first_row += rows_per_range) {
+            const size_t end_row = std::min(first_row + rows_per_range, num_rows);
+            workers->QueueWork([&func, first_row, end_row] { func(first_row, end_row); });
+        }
+        func(0, rows_per_range);
+        workers->WaitForRequests();
+    }
+
     Common::ScratchBuffer<u8> tmp_buffer;
     Common::ScratchBuffer<u8> src_buffer;
     Common::ScratchBuffer<u8> dst_buffer;
     Common::ScratchBuffer<f32> intermediate_src;
     Common::ScratchBuffer<f32> intermediate_dst;
     ConverterFactory converter_factory;
+    std::unique_ptr<Common::ThreadWorker> workers;
 };
 
 SoftwareBlitEngine::SoftwareBlitEngine(MemoryManager& memory_manager_)
@@ -173,29 +226,55 @@ bool SoftwareBlitEngine::Blit(Fermi2D::Surface& src, Fermi2D::Surface& dst,
     const bool no_passthrough =
         src.format != dst.format || src_extent_x != dst_extent_x || src_extent_y != dst_extent_y;
 
+    const size_t dst_num_pixels = static_cast<size_t>(dst_extent_x) * dst_extent_y;
+
     const auto conversion_phase_same_format = [&]() {
-        NearestNeighbor(impl->src_buffer, impl->dst_buffer, src_extent_x, src_extent_y,
-                        dst_extent_x, dst_extent_y, dst_bytes_per_pixel);
+        impl->ForEachRowRange(dst_extent_y, dst_num_pixels, [&](size_t first_row, size_t end_row) {
+            NearestNeighbor(impl->src_buffer, impl->dst_buffer, src_extent_x, src_extent_y,
+                            dst_extent_x, dst_extent_y, dst_bytes_per_pixel, first_row, end_row);
+        });
     };
 
     const auto conversion_phase_ir = [&]() {
         auto* input_converter = impl->converter_factory.GetFormatConverter(src.format);
+        auto* output_converter = impl->converter_factory.GetFormatConverter(dst.format);
         impl->intermediate_src.resize_destructive((src_copy_size / src_bytes_per_pixel) *
                                                   ir_components);
         impl->intermediate_dst.resize_destructive((dst_copy_size / dst_bytes_per_pixel) *
                                                   ir_components);
-        input_converter->ConvertTo(impl->src_buffer, impl->intermediate_src);
-
-        if (config.filter != Fermi2D::Filter::Bilinear) {
-            NearestNeighborFast(impl->intermediate_src, impl->intermediate_dst, src_extent_x,
-                                src_extent_y, dst_extent_x, dst_extent_y);
-        } else {
-            Bilinear(impl->intermediate_src, impl->intermediate_dst, src_extent_x, src_extent_y,
-                     dst_extent_x, dst_extent_y);
-        }
-
-        auto* output_converter = impl->converter_factory.GetFormatConverter(dst.format);
-        output_converter->ConvertFrom(impl->intermediate_dst, impl->dst_buffer);
+        const std::span<const u8> src_pixels{impl->src_buffer};
+        const std::span<u8> dst_pixels{impl->dst_buffer};
+        const std::span<f32> intermediate_src{impl->intermediate_src};
+        const std::span<f32> intermediate_dst{impl->intermediate_dst};
+
+        const size_t src_row_size = src_extent_x * src_bytes_per_pixel;
+        const size_t src_ir_row_size = src_extent_x * ir_components;
+        impl->ForEachRowRange(src_extent_y, static_cast<size_t>(src_extent_x) * src_extent_y,
+                              [&](size_t first_row, size_t end_row) {
+                                  const size_t num_rows = end_row - first_row;
+                                  input_converter->ConvertTo(
+                                      src_pixels.subspan(first_row * src_row_size,
+                                                         num_rows * src_row_size),
+                                      intermediate_src.subspan(first_row * src_ir_row_size,
+                                                               num_rows * src_ir_row_size));
+                              });
+
+        // Filtering and the output conversion of a row only depend on the converted source
+        const size_t dst_row_size = dst_extent_x * dst_bytes_per_pixel;
+        const size_t dst_ir_row_size = dst_extent_x * ir_components;
+        impl->ForEachRowRange(dst_extent_y, dst_num_pixels, [&](size_t first_row, size_t end_row) {
+            if (config.filter != Fermi2D::Filter::Bilinear) {
+                NearestNeighborFast(intermediate_src, intermediate_dst, src_extent_x, src_extent_y,
+                                    dst_extent_x, dst_extent_y, first_row, end_row);
+            } else {
+                Bilinear(intermediate_src, intermediate_dst, src_extent_x, src_extent_y,
+                         dst_extent_x, dst_extent_y, first_row, end_row);
+            }
+            const size_t num_rows = end_row - first_row;
+            output_converter->ConvertFrom(
+                intermediate_dst.subspan(first_row * dst_ir_row_size, num_rows * dst_ir_row_size),
+                dst_pixels.subspan(first_row * dst_row_size, num_rows * dst_row_size));
+        });
     };
 
     // Do actual Blit
@@ -1,6 +1,7 @@
 // SPDX-FileCopyrightText: Copyright 2022 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-3.0-or-later
 
+#include <algorithm>
 #include <array>
 #include <cmath>
 #include <span>
@@ -740,7 +741,7 @@ private:
                 out_component = Common::BitCast<f32>(value);
             } else if constexpr (component_sizes[which_component] == 16) {
                 static constexpr u32 sign_mask = 0x8000;
-                static constexpr u32 mantissa_mask = 0x8000;
+                static constexpr u32 mantissa_mask = 0x03ff;
                 out_component = Common::BitCast<f32>(((value & sign_mask) << 16) |
                                                      (((value & 0x7c00) + 0x1C000) << 13) |
                                                      ((value & mantissa_mask) << 13));
@@ -817,6 +818,7 @@ private:
         } else if constexpr (component_types[which_component] == ComponentType::SRGB) {
             if constexpr (component_swizzle[which_component] != Swizzle::A) {
                 if constexpr (component_sizes[which_component] == 8) {
+                    in_component = std::clamp(in_component, 0.0f, 1.0f);
                     const u32 index = calculate_unorm();
                     in_component = RGB_TO_SRGB_LUT[index];
                 } else {
@@ -829,90 +831,75 @@ private:
         }
     }
 
+    FORCE_INLINE void ConvertToComponents(const std::array<u32, total_words_per_pixel>& words,
+                                          std::array<f32, components_per_ir_rep>& new_components) {
+        if constexpr (component_swizzle[0] != Swizzle::None) {
+            ConvertToComponent<0>(words[bound_words[0]],
+                                  new_components[static_cast<size_t>(component_swizzle[0])]);
+        }
+        if constexpr (num_components >= 2 && component_swizzle[1] != Swizzle::None) {
+            ConvertToComponent<1>(words[bound_words[1]],
+                                  new_components[static_cast<size_t>(component_swizzle[1])]);
+        }
+        if constexpr (num_components >= 3 && component_swizzle[2] != Swizzle::None) {
+            ConvertToComponent<2>(words[bound_words[2]],
+                                  new_components[static_cast<size_t>(component_swizzle[2])]);
+        }
+        if constexpr (num_components >= 4 && component_swizzle[3] != Swizzle::None) {
+            ConvertToComponent<3>(words[bound_words[3]],
+                                  new_components[static_cast<size_t>(component_swizzle[3])]);
+        }
+    }
+
+    FORCE_INLINE void ConvertFromComponents(
+        const std::array<f32, components_per_ir_rep>& old_components,
+        std::array<u32, total_words_per_pixel>& words) {
+        if constexpr (component_swizzle[0] != Swizzle::None) {
+            ConvertFromComponent<0>(words[bound_words[0]],
+                                    old_components[static_cast<size_t>(component_swizzle[0])]);
+        }
+        if constexpr (num_components >= 2 && component_swizzle[1] != Swizzle::None) {
+            ConvertFromComponent<1>(words[bound_words[1]],
+                                    old_components[static_cast<size_t>(component_swizzle[1])]);
+        }
+        if constexpr (num_components >= 3 && component_swizzle[2] != Swizzle::None) {
+            ConvertFromComponent<2>(words[bound_words[2]],
+                                    old_components[static_cast<size_t>(component_swizzle[2])]);
+        }
+        if constexpr (num_components >= 4 && component_swizzle[3] != Swizzle::None) {
+            ConvertFromComponent<3>(words[bound_words[3]],
+                                    old_components[static_cast<size_t>(component_swizzle[3])]);
+        }
+    }
+
 public:
+    // Pixels are assembled in local arrays and copied out whole, so the stores do not alias the
+    // input and the compiler can keep every component in registers.
     void ConvertTo(std::span<const u8> input, std::span<f32> output) override {
         const size_t num_pixels = output.size() / components_per_ir_rep;
+        const u8* const src = input.data();
+        f32* const dst = output.data();
         for (size_t pixel = 0; pixel < num_pixels; pixel++) {
             std::array<u32, total_words_per_pixel> words{};
-
-            std::memcpy(words.data(), &input[pixel * total_bytes_per_pixel], total_bytes_per_pixel);
-            std::span<f32> new_components(&output[pixel * components_per_ir_rep],
-                                          components_per_ir_rep);
-            if constexpr (component_swizzle[0] != Swizzle::None) {
-                ConvertToComponent<0>(words[bound_words[0]],
-                                      new_components[static_cast<size_t>(component_swizzle[0])]);
-            } else {
-                new_components[0] = 0.0f;
-            }
-            if constexpr (num_components >= 2) {
-                if constexpr (component_swizzle[1] != Swizzle::None) {
-                    ConvertToComponent<1>(
-                        words[bound_words[1]],
-                        new_components[static_cast<size_t>(component_swizzle[1])]);
-                } else {
-                    new_components[1] = 0.0f;
-                }
-            } else {
-                new_components[1] = 0.0f;
-            }
-            if constexpr (num_components >= 3) {
-                if constexpr (component_swizzle[2] != Swizzle::None) {
-                    ConvertToComponent<2>(
-                        words[bound_words[2]],
-                        new_components[static_cast<size_t>(component_swizzle[2])]);
-                } else {
-                    new_components[2] = 0.0f;
-                }
-            } else {
-                new_components[2] = 0.0f;
-            }
-            if constexpr (num_components >= 4) {
-                if constexpr (component_swizzle[3] != Swizzle::None) {
-                    ConvertToComponent<3>(
-                        words[bound_words[3]],
-                        new_components[static_cast<size_t>(component_swizzle[3])]);
-                } else {
-                    new_components[3] = 0.0f;
-                }
-            } else {
-                new_components[3] = 0.0f;
-            }
+            std::memcpy(words.data(), src + pixel * total_bytes_per_pixel, total_bytes_per_pixel);
+            std::array<f32, components_per_ir_rep> new_components{};
+            ConvertToComponents(words, new_components);
+            std::memcpy(dst + pixel * components_per_ir_rep, new_components.data(),
+                        sizeof(new_components));
         }
     }
 
     void ConvertFrom(std::span<const f32> input, std::span<u8> output) override {
         const size_t num_pixels = output.size() / total_bytes_per_pixel;
+        const f32* const src = input.data();
+        u8* const dst = output.data();
         for (size_t pixel = 0; pixel < num_pixels; pixel++) {
-            std::span<const f32> old_components(&input[pixel * components_per_ir_rep],
-                                                components_per_ir_rep);
+            std::array<f32, components_per_ir_rep> old_components;
+            std::memcpy(old_components.data(), src + pixel * components_per_ir_rep,
+                        sizeof(old_components));
             std::array<u32, total_words_per_pixel> words{};
-            if constexpr (component_swizzle[0] != Swizzle::None) {
-                ConvertFromComponent<0>(words[bound_words[0]],
-                                        old_components[static_cast<size_t>(component_swizzle[0])]);
-            }
-            if constexpr (num_components >= 2) {
-                if constexpr (component_swizzle[1] != Swizzle::None) {
-                    ConvertFromComponent<1>(
-                        words[bound_words[1]],
-                        old_components[static_cast<size_t>(component_swizzle[1])]);
-                }
-            }
-            if constexpr (num_components >= 3) {
-                if constexpr (component_swizzle[2] != Swizzle::None) {
-                    ConvertFromComponent<2>(
-                        words[bound_words[2]],
-                        old_components[static_cast<size_t>(component_swizzle[2])]);
-                }
-            }
-            if constexpr (num_components >= 4) {
-                if constexpr (component_swizzle[3] != Swizzle::None) {
-                    ConvertFromComponent<3>(
-                        words[bound_words[3]],
-                        old_components[static_cast<size_t>(component_swizzle[3])]);
-                }
-            }
-            std::memcpy(&output[pixel * total_bytes_per_pixel], words.data(),
-                        total_bytes_per_pixel);
+            ConvertFromComponents(old_components, words);
+            std::memcpy(dst + pixel * total_bytes_per_pixel, words.data(), total_bytes_per_pixel);
         }
     }
 
@@ -8,7 +8,11 @@
 #include <list>
 #include <memory>
 
+#include <fmt/format.h>
+
 #include "common/assert.h"
+#include "common/fs/fs.h"
+#include "common/fs/path_util.h"
 #include "common/microprofile.h"
 #include "common/settings.h"
 #include "core/core.h"
@@ -18,6 +22,7 @@
 #include "core/hle/service/nvdrv/nvdata.h"
 #include "core/perf_stats.h"
 #include "video_core/cdma_pusher.h"
+#include "video_core/command_capture.h"
 #include "video_core/control/channel_state.h"
 #include "video_core/control/scheduler.h"
 #include "video_core/dma_pusher.h"
@@ -68,11 +73,29 @@ struct GPU::Impl {
     }
 
     void InitChannel(Control::ChannelState& to_init, u64 program_id) {
+        if (Settings::values.dump_gpu_commands && !command_capture) {
+            StartCommandCapture(program_id);
+        }
         to_init.Init(system, gpu, program_id);
         to_init.BindRasterizer(rasterizer);
         rasterizer->InitializeChannel(to_init);
     }
 
+    void StartCommandCapture(u64 program_id) {
+        const auto capture_dir{Common::FS::GetYuzuPath(Common::FS::YuzuPath::DumpDir) /
+                               "gpu_captures"};
+        if (!Common::FS::CreateDirs(capture_dir)) {
+            LOG_ERROR(HW_GPU, "Failed to create command capture directory");
+            return;
+        }
+        command_capture = std::make_unique<CommandCaptureWriter>(
+            capture_dir / fmt::format("{:016X}.ygc", program_id), program_id);
+    }
+
+    CommandCaptureWriter* CommandCapture() {
+        return command_capture && command_capture->IsOpen() ? command_capture.get() : nullptr;
+    }
+
     void InitAddressSpace(Tegra::MemoryManager& memory_manager) {
         memory_manager.BindRasterizer(rasterizer);
     }
@@ -345,6 +368,8 @@ struct GPU::Impl {
     s32 new_channel_id{1};
     /// Shader build notifier
     std::unique_ptr<VideoCore::ShaderNotify> shader_notify;
+    /// Command stream capture, only created when dump_gpu_commands is enabled
+    std::unique_ptr<CommandCaptureWriter> command_capture;
     /// When true, we are about to shut down emulation session, so terminate outstanding tasks
     std::atomic_bool shutting_down{};
 
@@ -486,6 +511,10 @@ const VideoCore::ShaderNotify& GPU::ShaderNotify() const {
     return impl->ShaderNotify();
 }
 
+CommandCaptureWriter* GPU::CommandCapture() {
+    return impl->CommandCapture();
+}
+
 void GPU::RequestComposite(std::vector<Tegra::FramebufferConfig>&& layers,
                            std::vector<Service::Nvidia::NvFence>&& fences) {
     impl->RequestComposite(std::move(layers), std::move(fences));
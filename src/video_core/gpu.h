@@ -22,6 +22,7 @@ class ShaderNotify;
 } // namespace VideoCore
 
 namespace Tegra {
+class CommandCaptureWriter;
 class DmaPusher;
 struct CommandList;
 
@@ -204,6 +205,9 @@ public:
     /// Returns a const reference to the shader notifier.
     [[nodiscard]] const VideoCore::ShaderNotify& ShaderNotify() const;
 
+    /// Returns the command stream capture, nullptr when capturing is disabled.
+    [[nodiscard]] CommandCaptureWriter* CommandCapture();
+
     [[nodiscard]] u64 GetTicks() const;
 
     [[nodiscard]] bool IsAsync() const;
@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include "common/assert.h"
+#include "common/logging/log.h"
 #include "common/microprofile.h"
 #include "common/scope_exit.h"
 #include "common/settings.h"
@@ -16,6 +17,10 @@
 #include "video_core/renderer_base.h"
 
 namespace VideoCommon::GPUThread {
+namespace {
+/// Maximum number of commands executed per wake-up before waiters are notified
+constexpr size_t MAX_BATCH_SIZE = 64;
+} // Anonymous namespace
 
 /// Runs the GPU thread
 static void RunThread(std::stop_token stop_token, Core::System& system,
@@ -41,19 +46,28 @@ static void RunThread(std::stop_token stop_token, Core::System& system,
         if (stop_token.stop_requested()) {
             break;
         }
-        if (auto* submit_list = std::get_if<SubmitListCommand>(&next.data)) {
-            scheduler.Push(submit_list->channel, std::move(submit_list->entries));
-        } else if (std::holds_alternative<GPUTickCommand>(next.data)) {
-            system.GPU().TickWork();
-        } else if (const auto* flush = std::get_if<FlushRegionCommand>(&next.data)) {
-            rasterizer->FlushRegion(flush->addr, flush->size);
-        } else if (const auto* invalidate = std::get_if<InvalidateRegionCommand>(&next.data)) {
-            rasterizer->OnCacheInvalidation(invalidate->addr, invalidate->size);
-        } else {
-            ASSERT(false);
-        }
-        state.signaled_fence.store(next.fence);
-        if (next.block) {
+        // Drain whatever else was queued in the meantime before going back to sleep
+        size_t batch_size{};
+        bool notify{};
+        do {
+            if (auto* submit_list = std::get_if<SubmitListCommand>(&next.data)) {
+                scheduler.Push(submit_list->channel, std::move(submit_list->entries));
+            } else if (std::holds_alternative<GPUTickCommand>(next.data)) {
+                system.GPU().TickWork();
+            } else if (const auto* flush = std::get_if<FlushRegionCommand>(&next.data)) {
+                rasterizer->FlushRegion(flush->addr, flush->size);
+            } else if (const auto* invalidate = std::get_if<InvalidateRegionCommand>(&next.data)) {
+                rasterizer->OnCacheInvalidation(invalidate->addr, invalidate->size);
+            } else {
+                ASSERT(false);
+            }
+            state.signaled_fence.store(next.fence);
+            notify |= next.block;
+        } while (++batch_size < MAX_BATCH_SIZE && state.queue.TryPop(next));
+
+        state.num_commands.fetch_add(batch_size, std::memory_order_relaxed);
+        state.num_batches.fetch_add(1, std::memory_order_relaxed);
+        if (notify) {
             // We have to lock the write_lock to ensure that the condition_variable wait not get a
             // race between the check and the lock itself.
             std::scoped_lock lk{state.write_lock};
@@ -65,12 +79,22 @@ static void RunThread(std::stop_token stop_token, Core::System& system,
 ThreadManager::ThreadManager(Core::System& system_, bool is_async_)
     : system{system_}, is_async{is_async_} {}
 
-ThreadManager::~ThreadManager() = default;
+ThreadManager::~ThreadManager() {
+    const ThreadStatistics stats{GetStatistics()};
+    if (stats.batches == 0) {
+        return;
+    }
+    const double seconds{std::chrono::duration<double>(stats.uptime).count()};
+    LOG_INFO(HW_GPU,
+             "GPU thread executed {} commands in {} batches ({:.0f} commands/s)", stats.commands,
+             stats.batches, static_cast<double>(stats.commands) / seconds);
+}
 
 void ThreadManager::StartThread(VideoCore::RendererBase& renderer,
                                 Core::Frontend::GraphicsContext& context,
                                 Tegra::Control::Scheduler& scheduler) {
     rasterizer = renderer.ReadRasterizer();
+    start_time = std::chrono::steady_clock::now();
     thread = std::jthread(RunThread, std::ref(system), std::ref(renderer), std::ref(context),
                           std::ref(scheduler), std::ref(state));
 }
@@ -99,6 +123,7 @@ void ThreadManager::TickGPU() {
 }
 
 void ThreadManager::InvalidateRegion(DAddr addr, u64 size) {
+    // Applied right away, CPU threads query the rasterizer caches directly after writing memory
     rasterizer->OnCacheInvalidation(addr, size);
 }
 
@@ -107,6 +132,14 @@ void ThreadManager::FlushAndInvalidateRegion(DAddr addr, u64 size) {
     rasterizer->OnCacheInvalidation(addr, size);
 }
 
+ThreadStatistics ThreadManager::GetStatistics() const {
+    return {
+        .commands = state.num_commands.load(std::memory_order_relaxed),
+        .batches = state.num_batches.load(std::memory_order_relaxed),
+        .uptime = std::chrono::steady_clock::now() - start_time,
+    };
+}
+
 u64 ThreadManager::PushCommand(CommandData&& command_data, bool block) {
     if (!is_async) {
         // In synchronous GPU mode, block the caller until the command has executed
@@ -4,10 +4,12 @@
 #pragma once
 
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <mutex>
 #include <optional>
 #include <thread>
+#include <utility>
 #include <variant>
 
 #include "common/bounded_threadsafe_queue.h"
@@ -87,14 +89,25 @@ struct CommandDataContainer {
     bool block{};
 };
 
+/// Counters describing the work done by the GPU thread
+struct ThreadStatistics {
+    u64 commands{};                    ///< Commands executed by the GPU thread
+    u64 batches{};                     ///< Wake-ups of the GPU thread, each drains a batch
+    std::chrono::nanoseconds uptime{}; ///< Time since the GPU thread was started
+};
+
 /// Struct used to synchronize the GPU thread
 struct SynchState final {
-    using CommandQueue = Common::MPSCQueue<CommandDataContainer>;
+    // Producers are serialized by write_lock, so the queue only ever sees a single producer
+    using CommandQueue = Common::SPSCQueue<CommandDataContainer>;
     std::mutex write_lock;
     CommandQueue queue;
     u64 last_fence{};
     std::atomic<u64> signaled_fence{};
     std::condition_variable_any cv;
+
+    std::atomic<u64> num_commands{};
+    std::atomic<u64> num_batches{};
 };
 
 /// Class used to manage the GPU thread
@@ -121,6 +134,9 @@ public:
 
     void TickGPU();
 
+    /// Returns a snapshot of the GPU thread counters
+    [[nodiscard]] ThreadStatistics GetStatistics() const;
+
 private:
     /// Pushes a command to be executed by the GPU thread
     u64 PushCommand(CommandData&& command_data, bool block = false);
@@ -131,6 +147,7 @@ private:
 
     SynchState state;
     std::jthread thread;
+    std::chrono::steady_clock::time_point start_time;
 };
 
 } // namespace VideoCommon::GPUThread
@@ -33,8 +33,18 @@ void Decoder::Decode() {
     }
 
     // Receive output frames from decoder.
-    auto frame = decode_api.ReceiveFrame();
+    if (UsingDecodeOrder()) {
+        PushFrame(decode_api.ReceiveFrame());
+        return;
+    }
+    // Decoders outputting in presentation order may hold frames back for reordering and later
+    // return several at once, queue every ready frame so the output never falls behind.
+    while (auto frame = decode_api.ReceiveFrame()) {
+        PushFrame(std::move(frame));
+    }
+}
 
+void Decoder::PushFrame(std::shared_ptr<FFmpeg::Frame>&& frame) {
     if (IsInterlaced()) {
         auto [luma_top, luma_bottom, chroma_top, chroma_bottom] = GetInterlacedOffsets();
         auto frame_copy = frame;
@@ -45,6 +45,9 @@ protected:
                      const Host1x::NvdecCommon::NvdecRegisters& regs,
                      Host1x::FrameQueue& frame_queue);
 
+    /// Queues a decoded frame for the Vic at the output surface of the current picture
+    void PushFrame(std::shared_ptr<FFmpeg::Frame>&& frame);
+
     virtual std::span<const u8> ComposeFrame() = 0;
     virtual std::tuple<u64, u64> GetProgressiveOffsets() = 0;
     virtual std::tuple<u64, u64, u64, u64> GetInterlacedOffsets() = 0;
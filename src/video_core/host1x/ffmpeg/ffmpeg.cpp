@@ -10,6 +10,7 @@
 #include "video_core/memory_manager.h"
 
 extern "C" {
+#include <libavutil/imgutils.h>
 #ifdef LIBVA_FOUND
 // for querying VAAPI driver information
 #include <libavutil/hwcontext_vaapi.h>
@@ -22,6 +23,7 @@ namespace {
 
 constexpr AVPixelFormat PreferredGpuFormat = AV_PIX_FMT_NV12;
 constexpr AVPixelFormat PreferredCpuFormat = AV_PIX_FMT_YUV420P;
+constexpr int TransferAlignment = 32;
 constexpr std::array PreferredGpuDecoders = {
     AV_HWDEVICE_TYPE_CUDA,
 #ifdef _WIN32
@@ -75,6 +77,30 @@ Frame::~Frame() {
     av_frame_free(&m_frame);
 }
 
+std::shared_ptr<Frame> FramePool::Acquire() {
+    std::unique_ptr<Frame> frame;
+    {
+        std::scoped_lock lock{m_mutex};
+        if (!m_free_frames.empty()) {
+            frame = std::move(m_free_frames.back());
+            m_free_frames.pop_back();
+        }
+    }
+    if (!frame) {
+        frame = std::make_unique<Frame>();
+    }
+    return std::shared_ptr<Frame>(frame.release(), [pool = shared_from_this()](Frame* released) {
+        pool->Release(released);
+    });
+}
+
+void FramePool::Release(Frame* frame) {
+    // Hand the picture buffers back to their pools right away, only the AVFrame is kept.
+    av_frame_unref(frame->GetFrame());
+    std::scoped_lock lock{m_mutex};
+    m_free_frames.emplace_back(frame);
+}
+
 Decoder::Decoder(Tegra::Host1x::NvdecCommon::VideoCodec codec) {
     const AVCodecID av_codec = [&] {
         switch (codec) {
@@ -189,13 +215,17 @@ bool HardwareContext::InitializeWithType(AVHWDeviceType type) {
 DecoderContext::DecoderContext(const Decoder& decoder) : m_decoder{decoder} {
     m_codec_context = avcodec_alloc_context3(m_decoder.GetCodec());
     av_opt_set(m_codec_context->priv_data, "tune", "zerolatency", 0);
+    // Frame threading holds back one frame per thread, but games expect the surface of a decode
+    // to be ready once its syncpoint is signalled. Slice threading has no such delay.
     m_codec_context->thread_count = 0;
-    m_codec_context->thread_type &= ~FF_THREAD_FRAME;
+    m_codec_context->thread_type = FF_THREAD_SLICE;
 }
 
 DecoderContext::~DecoderContext() {
     av_buffer_unref(&m_codec_context->hw_device_ctx);
     avcodec_free_context(&m_codec_context);
+    // Buffers still referenced by queued frames are freed once they are released.
+    av_buffer_pool_uninit(&m_transfer_pool);
 }
 
 void DecoderContext::InitializeHardwareDecoder(const HardwareContext& context,
@@ -219,7 +249,7 @@ bool DecoderContext::OpenContext(const Decoder& decoder) {
 }
 
 bool DecoderContext::SendPacket(const Packet& packet) {
-    m_temp_frame = std::make_shared<Frame>();
+    m_temp_frame = m_frame_pool->Acquire();
     m_got_frame = 0;
 
 // Android can randomly crash when calling decode directly, so skip.
@@ -271,10 +301,14 @@ std::shared_ptr<Frame> DecoderContext::ReceiveFrame() {
     } else
 #endif
     {
+        m_temp_frame = m_frame_pool->Acquire();
 
         const auto ReceiveImpl = [&](AVFrame* frame) {
             if (const int ret = avcodec_receive_frame(m_codec_context, frame); ret < 0) {
-                LOG_ERROR(HW_GPU, "avcodec_receive_frame error: {}", AVError(ret));
+                // The decoder may hold frames back until it has received more packets.
+                if (ret != AVERROR(EAGAIN)) {
+                    LOG_ERROR(HW_GPU, "avcodec_receive_frame error: {}", AVError(ret));
+                }
                 return false;
             }
 
@@ -290,13 +324,17 @@ std::shared_ptr<Frame> DecoderContext::ReceiveFrame() {
                 return {};
             }
 
-            m_temp_frame->SetFormat(PreferredGpuFormat);
+            if (!AllocateTransferFrame(m_temp_frame->GetFrame(), intermediate_frame.GetFrame())) {
+                return {};
+            }
             if (const int ret = av_hwframe_transfer_data(m_temp_frame->GetFrame(),
                                                          intermediate_frame.GetFrame(), 0);
                 ret < 0) {
                 LOG_ERROR(HW_GPU, "av_hwframe_transfer_data error: {}", AVError(ret));
                 return {};
             }
+            // Frames transferred into existing buffers do not take the properties of the source.
+            av_frame_copy_props(m_temp_frame->GetFrame(), intermediate_frame.GetFrame());
         } else {
             // Otherwise, decode the frame as normal.
             if (!ReceiveImpl(m_temp_frame->GetFrame())) {
@@ -312,6 +350,32 @@ std::shared_ptr<Frame> DecoderContext::ReceiveFrame() {
     return std::move(m_temp_frame);
 }
 
+bool DecoderContext::AllocateTransferFrame(AVFrame* dst, const AVFrame* src) {
+    // Take the CPU copies of hardware frames from a pool, saving a large allocation per frame.
+    const int size = av_image_get_buffer_size(PreferredGpuFormat, src->width, src->height,
+                                              TransferAlignment);
+    if (size < 0) {
+        LOG_ERROR(HW_GPU, "av_image_get_buffer_size error: {}", AVError(size));
+        return false;
+    }
+    if (!m_transfer_pool || m_transfer_pool_size != size) {
+        av_buffer_pool_uninit(&m_transfer_pool);
+        m_transfer_pool = av_buffer_pool_init(static_cast<size_t>(size), nullptr);
+        m_transfer_pool_size = size;
+    }
+    dst->buf[0] = av_buffer_pool_get(m_transfer_pool);
+    if (!dst->buf[0]) {
+        LOG_ERROR(HW_GPU, "Failed to allocate a {} byte transfer buffer", size);
+        return false;
+    }
+    dst->format = PreferredGpuFormat;
+    dst->width = src->width;
+    dst->height = src->height;
+    av_image_fill_arrays(dst->data, dst->linesize, dst->buf[0]->data, PreferredGpuFormat,
+                         src->width, src->height, TransferAlignment);
+    return true;
+}
+
 void DecodeApi::Reset() {
     m_hardware_context.reset();
     m_decoder_context.reset();
@@ -4,6 +4,7 @@
 #pragma once
 
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <span>
 #include <vector>
@@ -38,6 +39,7 @@ namespace FFmpeg {
 
 class Packet;
 class Frame;
+class FramePool;
 class Decoder;
 class HardwareContext;
 class DecoderContext;
@@ -121,6 +123,25 @@ private:
     AVFrame* m_frame{};
 };
 
+// Recycles Frames once their last reference is dropped, usually by the Vic after composing them.
+// Frames keep the pool alive, so they may outlive the decoder that produced them.
+class FramePool : public std::enable_shared_from_this<FramePool> {
+public:
+    YUZU_NON_COPYABLE(FramePool);
+    YUZU_NON_MOVEABLE(FramePool);
+
+    FramePool() = default;
+    ~FramePool() = default;
+
+    std::shared_ptr<Frame> Acquire();
+
+private:
+    void Release(Frame* frame);
+
+    std::mutex m_mutex;
+    std::vector<std::unique_ptr<Frame>> m_free_frames;
+};
+
 // Wraps an AVCodec, a type containing information about a codec.
 class Decoder {
 public:
@@ -186,10 +207,15 @@ public:
     }
 
 private:
+    bool AllocateTransferFrame(AVFrame* dst, const AVFrame* src);
+
     const Decoder& m_decoder;
     AVCodecContext* m_codec_context{};
     s32 m_got_frame{};
     std::shared_ptr<Frame> m_temp_frame{};
+    std::shared_ptr<FramePool> m_frame_pool{std::make_shared<FramePool>()};
+    AVBufferPool* m_transfer_pool{};
+    int m_transfer_pool_size{};
     bool m_decode_order{};
 };
 
@@ -209,6 +235,8 @@ public:
     }
 
     bool SendPacket(std::span<const u8> packet_data);
+
+    /// Returns the next decoded frame, or nullptr when the decoder has none ready.
     std::shared_ptr<Frame> ReceiveFrame();
 
 private:
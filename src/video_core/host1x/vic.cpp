@@ -1,7 +1,9 @@
 // SPDX-FileCopyrightText: Copyright 2020 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
 #include <array>
+#include <thread>
 #include <tuple>
 #include <stdint.h>
 
@@ -32,6 +34,7 @@ extern "C" {
 #include "common/alignment.h"
 #include "common/assert.h"
 #include "common/bit_field.h"
+#include "common/div_ceil.h"
 #include "common/logging/log.h"
 #include "common/polyfill_thread.h"
 #include "common/settings.h"
@@ -50,6 +53,10 @@ extern "C" {
 
 namespace Tegra::Host1x {
 namespace {
+// Frames below 720p are processed on the VIC thread, splitting them costs more than it saves
+constexpr u32 ParallelFrameThreshold = 1280 * 720;
+constexpr u32 MaxFrameThreads = 4;
+
 static bool HasSSE41() {
 #if defined(ARCHITECTURE_x86_64)
     const auto& cpu_caps{Common::GetCPUCaps()};
@@ -91,6 +98,180 @@ void SwizzleSurface(std::span<u8> output, u32 out_stride, std::span<const u8> in
     }
 }
 
+/// Converts the pixels [begin, end) of a 4:2:0 line to the 10-bit intermediate format.
+template <bool Planar>
+void DecodeLineLinear(Pixel* out, const u8* luma, const u8* chroma_u, const u8* chroma_v,
+                      s32 begin, s32 end, u16 alpha) {
+    for (s32 x = begin; x < end; x++) {
+        out[x].r = static_cast<u16>(luma[x] << 2);
+        // Chroma samples are duplicated horizontally and vertically.
+        if constexpr (Planar) {
+            out[x].g = static_cast<u16>(chroma_u[x / 2] << 2);
+            out[x].b = static_cast<u16>(chroma_v[x / 2] << 2);
+        } else {
+            out[x].g = static_cast<u16>(chroma_u[(x & ~1) + 0] << 2);
+            out[x].b = static_cast<u16>(chroma_u[(x & ~1) + 1] << 2);
+        }
+        out[x].a = alpha;
+    }
+}
+
+#if defined(ARCHITECTURE_x86_64) || defined(ARCHITECTURE_arm64)
+template <bool Planar>
+void DecodeLineSSE41(Pixel* out, const u8* luma, const u8* chroma_u, const u8* chroma_v,
+                     s32 width, u16 planar_alpha) {
+    const auto alpha = _mm_slli_epi64(_mm_set1_epi64x(static_cast<s64>(planar_alpha)), 48);
+
+    const auto shuffle_mask = _mm_set_epi8(13, 15, 14, 12, 9, 11, 10, 8, 5, 7, 6, 4, 1, 3, 2, 0);
+    const auto sse_aligned_width = Common::AlignDown(width, 16);
+
+    s32 x = 0;
+    for (; x < sse_aligned_width; x += 16) {
+        // clang-format off
+        // Prefetch next iteration's memory
+        _mm_prefetch((const char*)&luma[x + 16], _MM_HINT_T0);
+
+        // Load 8 bytes * 2 of 8-bit luma samples
+        // luma0 = 00 00 00 00 00 00 00 00 LL LL LL LL LL LL LL LL
+        auto luma0 = _mm_loadl_epi64((__m128i*)&luma[x + 0]);
+        auto luma1 = _mm_loadl_epi64((__m128i*)&luma[x + 8]);
+
+        __m128i chroma;
+
+        if constexpr (Planar) {
+            _mm_prefetch((const char*)&chroma_u[x / 2 + 8], _MM_HINT_T0);
+            _mm_prefetch((const char*)&chroma_v[x / 2 + 8], _MM_HINT_T0);
+
+            // If Chroma is planar, we have separate U and V planes, load 8 bytes of each
+            // chroma_u0 = 00 00 00 00 00 00 00 00 UU UU UU UU UU UU UU UU
+            // chroma_v0 = 00 00 00 00 00 00 00 00 VV VV VV VV VV VV VV VV
+            auto chroma_u0 = _mm_loadl_epi64((__m128i*)&chroma_u[x / 2]);
+            auto chroma_v0 = _mm_loadl_epi64((__m128i*)&chroma_v[x / 2]);
+
+            // Interleave the 8 bytes of U and V into a single 16 byte reg
+            // chroma = VV UU VV UU VV UU VV UU VV UU VV UU VV UU VV UU
+            chroma = _mm_unpacklo_epi8(chroma_u0, chroma_v0);
+        } else {
+            _mm_prefetch((const char*)&chroma_u[x / 2 + 8], _MM_HINT_T0);
+
+            // Chroma is already interleaved in semiplanar format, just load 16 bytes
+            // chroma = VV UU VV UU VV UU VV UU VV UU VV UU VV UU VV UU
+            chroma = _mm_load_si128((__m128i*)&chroma_u[x]);
+        }
+
+        // Convert the low 8 bytes of 8-bit luma into 16-bit luma
+        // luma0 = [00] [00] [00] [00] [00] [00] [00] [00] [LL] [LL] [LL] [LL] [LL] [LL] [LL] [LL]
+        // ->
+        // luma0 = [00 LL] [00 LL] [00 LL] [00 LL] [00 LL] [00 LL] [00 LL] [00 LL]
+        luma0 = _mm_cvtepu8_epi16(luma0);
+        luma1 = _mm_cvtepu8_epi16(luma1);
+
+        // Treat the 8 bytes of 8-bit chroma as 16-bit channels, this allows us to take both the
+        // U and V together as one element. Using chroma twice here duplicates the values, as we
+        // take element 0 from chroma, and then element 0 from chroma again, etc. We need to
+        // duplicate chroma horitonally as chroma is half the width of luma.
+        // chroma   = [VV8 UU8] [VV7 UU7] [VV6 UU6] [VV5 UU5] [VV4 UU4] [VV3 UU3] [VV2 UU2] [VV1 UU1]
+        // ->
+        // chroma00 = [VV4 UU4] [VV4 UU4] [VV3 UU3] [VV3 UU3] [VV2 UU2] [VV2 UU2] [VV1 UU1] [VV1 UU1]
+        // chroma01 = [VV8 UU8] [VV8 UU8] [VV7 UU7] [VV7 UU7] [VV6 UU6] [VV6 UU6] [VV5 UU5] [VV5 UU5]
+        auto chroma00 = _mm_unpacklo_epi16(chroma, chroma);
+        auto chroma01 = _mm_unpackhi_epi16(chroma, chroma);
+
+        // Interleave the 16-bit luma and chroma.
+        // luma0    = [008 LL8] [007 LL7] [006 LL6] [005 LL5] [004 LL4] [003 LL3] [002 LL2] [001 LL1]
+        // chroma00 = [VV8 UU8] [VV7 UU7] [VV6 UU6] [VV5 UU5] [VV4 UU4] [VV3 UU3] [VV2 UU2] [VV1 UU1]
+        // ->
+        // yuv0     = [VV4 UU4 004 LL4] [VV3 UU3 003 LL3] [VV2 UU2 002 LL2] [VV1 UU1 001 LL1]
+        // yuv1     = [VV8 UU8 008 LL8] [VV7 UU7 007 LL7] [VV6 UU6 006 LL6] [VV5 UU5 005 LL5]
+        auto yuv0 = _mm_unpacklo_epi16(luma0, chroma00);
+        auto yuv1 = _mm_unpackhi_epi16(luma0, chroma00);
+        auto yuv2 = _mm_unpacklo_epi16(luma1, chroma01);
+        auto yuv3 = _mm_unpackhi_epi16(luma1, chroma01);
+
+        // Shuffle the luma/chroma into the channel ordering we actually want. The high byte of
+        // the luma which is now a constant 0 after converting 8-bit -> 16-bit is used as the
+        // alpha. Luma -> R, U -> G, V -> B, 0 -> A
+        // yuv0 = [VV4 UU4 004 LL4] [VV3 UU3 003 LL3] [VV2 UU2 002 LL2] [VV1 UU1 001 LL1]
+        // ->
+        // yuv0 = [AA4 VV4 UU4 LL4] [AA3 VV3 UU3 LL3] [AA2 VV2 UU2 LL2] [AA1 VV1 UU1 LL1]
+        yuv0 = _mm_shuffle_epi8(yuv0, shuffle_mask);
+        yuv1 = _mm_shuffle_epi8(yuv1, shuffle_mask);
+        yuv2 = _mm_shuffle_epi8(yuv2, shuffle_mask);
+        yuv3 = _mm_shuffle_epi8(yuv3, shuffle_mask);
+
+        // Extend the 8-bit channels we have into 16-bits, as that's the target surface format.
+        // Since this turns just the low 8 bytes into 16 bytes, the second of
+        // each operation here right shifts the register by 8 to get the high pixels.
+        // yuv0  = [AA4] [VV4] [UU4] [LL4] [AA3] [VV3] [UU3] [LL3] [AA2] [VV2] [UU2] [LL2] [AA1] [VV1] [UU1] [LL1]
+        // ->
+        // yuv01 = [002 AA2] [002 VV2] [002 UU2] [002 LL2] [001 AA1] [001 VV1] [001 UU1] [001 LL1]
+        // yuv23 = [004 AA4] [004 VV4] [004 UU4] [004 LL4] [003 AA3] [003 VV3] ]003 UU3] [003 LL3]
+        auto yuv01 = _mm_cvtepu8_epi16(yuv0);
+        auto yuv23 = _mm_cvtepu8_epi16(_mm_srli_si128(yuv0, 8));
+        auto yuv45 = _mm_cvtepu8_epi16(yuv1);
+        auto yuv67 = _mm_cvtepu8_epi16(_mm_srli_si128(yuv1, 8));
+        auto yuv89 = _mm_cvtepu8_epi16(yuv2);
+        auto yuv1011 = _mm_cvtepu8_epi16(_mm_srli_si128(yuv2, 8));
+        auto yuv1213 = _mm_cvtepu8_epi16(yuv3);
+        auto yuv1415 = _mm_cvtepu8_epi16(_mm_srli_si128(yuv3, 8));
+
+        // Left-shift all 16-bit channels by 2, this is to get us into a 10-bit format instead
+        // of 8, which is the format alpha is in, as well as other blending values.
+        yuv01 = _mm_slli_epi16(yuv01, 2);
+        yuv23 = _mm_slli_epi16(yuv23, 2);
+        yuv45 = _mm_slli_epi16(yuv45, 2);
+        yuv67 = _mm_slli_epi16(yuv67, 2);
+        yuv89 = _mm_slli_epi16(yuv89, 2);
+        yuv1011 = _mm_slli_epi16(yuv1011, 2);
+        yuv1213 = _mm_slli_epi16(yuv1213, 2);
+        yuv1415 = _mm_slli_epi16(yuv1415, 2);
+
+        // OR in the planar alpha, this has already been duplicated and shifted into position,
+        // and just fills in the AA channels with the actual alpha value.
+        yuv01 = _mm_or_si128(yuv01, alpha);
+        yuv23 = _mm_or_si128(yuv23, alpha);
+        yuv45 = _mm_or_si128(yuv45, alpha);
+        yuv67 = _mm_or_si128(yuv67, alpha);
+        yuv89 = _mm_or_si128(yuv89, alpha);
+        yuv1011 = _mm_or_si128(yuv1011, alpha);
+        yuv1213 = _mm_or_si128(yuv1213, alpha);
+        yuv1415 = _mm_or_si128(yuv1415, alpha);
+
+        // Store out the pixels. One pixel is now 8 bytes, so each store is 2 pixels.
+        // [AA AA] [VV VV] [UU UU] [LL LL] [AA AA] [VV VV] [UU UU] [LL LL]
+        _mm_store_si128((__m128i*)&out[x + 0], yuv01);
+        _mm_store_si128((__m128i*)&out[x + 2], yuv23);
+        _mm_store_si128((__m128i*)&out[x + 4], yuv45);
+        _mm_store_si128((__m128i*)&out[x + 6], yuv67);
+        _mm_store_si128((__m128i*)&out[x + 8], yuv89);
+        _mm_store_si128((__m128i*)&out[x + 10], yuv1011);
+        _mm_store_si128((__m128i*)&out[x + 12], yuv1213);
+        _mm_store_si128((__m128i*)&out[x + 14], yuv1415);
+
+        // clang-format on
+    }
+    DecodeLineLinear<Planar>(out, luma, chroma_u, chroma_v, x, width, planar_alpha);
+}
+#endif
+
+/// Converts a 4:2:0 line to the 10-bit intermediate format with the best kernel for the host.
+template <bool Planar>
+void DecodeLine([[maybe_unused]] bool has_sse41, Pixel* out, const u8* luma, const u8* chroma_u,
+                const u8* chroma_v, s32 width, u16 alpha) {
+#if defined(ARCHITECTURE_x86_64)
+    if (!has_sse41) {
+        DecodeLineLinear<Planar>(out, luma, chroma_u, chroma_v, 0, width, alpha);
+        return;
+    }
+#endif
+
+#if defined(ARCHITECTURE_x86_64) || defined(ARCHITECTURE_arm64)
+    DecodeLineSSE41<Planar>(out, luma, chroma_u, chroma_v, width, alpha);
+#else
+    DecodeLineLinear<Planar>(out, luma, chroma_u, chroma_v, 0, width, alpha);
+#endif
+}
+
 } // namespace
 
 Vic::Vic(Host1x& host1x_, s32 id_, u32 syncpt, FrameQueue& frame_queue_)
@@ -104,6 +285,25 @@ Vic::~Vic() {
     frame_queue.Close(id);
 }
 
+template <typename Func>
+void Vic::ForEachRowRange(u32 num_rows, u32 row_width, Func&& func) {
+    const u32 num_threads = std::min(std::thread::hardware_concurrency(), MaxFrameThreads);
+    if (u64{num_rows} * row_width < ParallelFrameThreshold || num_threads <= 1 || num_rows <= 1) {
+        func(0U, num_rows);
+        return;
+    }
+    if (!workers) {
+        workers = std::make_unique<Common::ThreadWorker>(num_threads - 1, "VicWorker");
+    }
+    const u32 rows_per_range = Common::DivCeil(num_rows, num_threads);
+    for (u32 first_row = rows_per_range; first_row < num_rows; first_row += rows_per_range) {
+        const u32 end_row = std::min(first_row + rows_per_range, num_rows);
+        workers->QueueWork([&func, first_row, end_row] { func(first_row, end_row); });
+    }
+    func(0U, rows_per_range);
+    workers->WaitForRequests();
+}
+
 void Vic::ProcessMethod(u32 method, u32 arg) {
     LOG_TRACE(HW_GPU, "Vic {} method 0x{:X}", id, static_cast<u32>(method));
     regs.reg_array[method] = arg;
@@ -214,197 +414,18 @@ void Vic::ReadProgressiveY8__V8U8_N420(const SlotStruct& slot,
               in_chroma_stride, out_luma_width, out_luma_height, out_luma_stride, out_luma_width,
               out_luma_height, out_luma_stride);
 
-    [[maybe_unused]] auto DecodeLinear = [&]() {
-        const auto alpha{static_cast<u16>(slot.config.planar_alpha.Value())};
-
-        for (s32 y = 0; y < in_luma_height; y++) {
-            const auto src_luma{y * in_luma_stride};
+    const auto alpha{static_cast<u16>(slot.config.planar_alpha.Value())};
+    const auto decode_rows = [&](u32 first_row, u32 end_row) {
+        for (s32 y = static_cast<s32>(first_row); y < static_cast<s32>(end_row); y++) {
             const auto src_chroma{(y / 2) * in_chroma_stride};
-            const auto dst{y * out_luma_stride};
-            for (s32 x = 0; x < in_luma_width; x++) {
-                slot_surface[dst + x].r = static_cast<u16>(luma_buffer[src_luma + x] << 2);
-                // Chroma samples are duplicated horizontally and vertically.
-                if constexpr (Planar) {
-                    slot_surface[dst + x].g =
-                        static_cast<u16>(chroma_u_buffer[src_chroma + x / 2] << 2);
-                    slot_surface[dst + x].b =
-                        static_cast<u16>(chroma_v_buffer[src_chroma + x / 2] << 2);
-                } else {
-                    slot_surface[dst + x].g =
-                        static_cast<u16>(chroma_u_buffer[src_chroma + (x & ~1) + 0] << 2);
-                    slot_surface[dst + x].b =
-                        static_cast<u16>(chroma_u_buffer[src_chroma + (x & ~1) + 1] << 2);
-                }
-                slot_surface[dst + x].a = alpha;
-            }
+            DecodeLine<Planar>(has_sse41, &slot_surface[y * out_luma_stride],
+                               &luma_buffer[y * in_luma_stride], &chroma_u_buffer[src_chroma],
+                               Planar ? &chroma_v_buffer[src_chroma] : nullptr, in_luma_width,
+                               alpha);
         }
     };
-
-#if defined(ARCHITECTURE_x86_64)
-    if (!has_sse41) {
-        DecodeLinear();
-        return;
-    }
-#endif
-
-#if defined(ARCHITECTURE_x86_64) || defined(ARCHITECTURE_arm64)
-    const auto alpha_linear{static_cast<u16>(slot.config.planar_alpha.Value())};
-    const auto alpha =
-        _mm_slli_epi64(_mm_set1_epi64x(static_cast<s64>(slot.config.planar_alpha.Value())), 48);
-
-    const auto shuffle_mask = _mm_set_epi8(13, 15, 14, 12, 9, 11, 10, 8, 5, 7, 6, 4, 1, 3, 2, 0);
-    const auto sse_aligned_width = Common::AlignDown(in_luma_width, 16);
-
-    for (s32 y = 0; y < in_luma_height; y++) {
-        const auto src_luma{y * in_luma_stride};
-        const auto src_chroma{(y / 2) * in_chroma_stride};
-        const auto dst{y * out_luma_stride};
-        s32 x = 0;
-        for (; x < sse_aligned_width; x += 16) {
-            // clang-format off
-            // Prefetch next iteration's memory
-            _mm_prefetch((const char*)&luma_buffer[src_luma + x + 16], _MM_HINT_T0);
-
-            // Load 8 bytes * 2 of 8-bit luma samples
-            // luma0 = 00 00 00 00 00 00 00 00 LL LL LL LL LL LL LL LL
-            auto luma0 = _mm_loadl_epi64((__m128i*)&luma_buffer[src_luma + x + 0]);
-            auto luma1 = _mm_loadl_epi64((__m128i*)&luma_buffer[src_luma + x + 8]);
-
-            __m128i chroma;
-
-            if constexpr (Planar) {
-                _mm_prefetch((const char*)&chroma_u_buffer[src_chroma + x / 2 + 8], _MM_HINT_T0);
-                _mm_prefetch((const char*)&chroma_v_buffer[src_chroma + x / 2 + 8], _MM_HINT_T0);
-
-                // If Chroma is planar, we have separate U and V planes, load 8 bytes of each
-                // chroma_u0 = 00 00 00 00 00 00 00 00 UU UU UU UU UU UU UU UU
-                // chroma_v0 = 00 00 00 00 00 00 00 00 VV VV VV VV VV VV VV VV
-                auto chroma_u0 = _mm_loadl_epi64((__m128i*)&chroma_u_buffer[src_chroma + x / 2]);
-                auto chroma_v0 = _mm_loadl_epi64((__m128i*)&chroma_v_buffer[src_chroma + x / 2]);
-
-                // Interleave the 8 bytes of U and V into a single 16 byte reg
-                // chroma = VV UU VV UU VV UU VV UU VV UU VV UU VV UU VV UU
-                chroma = _mm_unpacklo_epi8(chroma_u0, chroma_v0);
-            } else {
-                _mm_prefetch((const char*)&chroma_u_buffer[src_chroma + x / 2 + 8], _MM_HINT_T0);
-
-                // Chroma is already interleaved in semiplanar format, just load 16 bytes
-                // chroma = VV UU VV UU VV UU VV UU VV UU VV UU VV UU VV UU
-                chroma = _mm_load_si128((__m128i*)&chroma_u_buffer[src_chroma + x]);
-            }
-
-            // Convert the low 8 bytes of 8-bit luma into 16-bit luma
-            // luma0 = [00] [00] [00] [00] [00] [00] [00] [00] [LL] [LL] [LL] [LL] [LL] [LL] [LL] [LL]
-            // ->
-            // luma0 = [00 LL] [00 LL] [00 LL] [00 LL] [00 LL] [00 LL] [00 LL] [00 LL]
-            luma0 = _mm_cvtepu8_epi16(luma0);
-            luma1 = _mm_cvtepu8_epi16(luma1);
-
-            // Treat the 8 bytes of 8-bit chroma as 16-bit channels, this allows us to take both the
-            // U and V together as one element. Using chroma twice here duplicates the values, as we
-            // take element 0 from chroma, and then element 0 from chroma again, etc. We need to
-            // duplicate chroma horitonally as chroma is half the width of luma.
-            // chroma   = [VV8 UU8] [VV7 UU7] [VV6 UU6] [VV5 UU5] [VV4 UU4] [VV3 UU3] [VV2 UU2] [VV1 UU1]
-            // ->
-            // chroma00 = [VV4 UU4] [VV4 UU4] [VV3 UU3] [VV3 UU3] [VV2 UU2] [VV2 UU2] [VV1 UU1] [VV1 UU1]
-            // chroma01 = [VV8 UU8] [VV8 UU8] [VV7 UU7] [VV7 UU7] [VV6 UU6] [VV6 UU6] [VV5 UU5] [VV5 UU5]
-            auto chroma00 = _mm_unpacklo_epi16(chroma, chroma);
-            auto chroma01 = _mm_unpackhi_epi16(chroma, chroma);
-
-            // Interleave the 16-bit luma and chroma.
-            // luma0    = [008 LL8] [007 LL7] [006 LL6] [005 LL5] [004 LL4] [003 LL3] [002 LL2] [001 LL1]
-            // chroma00 = [VV8 UU8] [VV7 UU7] [VV6 UU6] [VV5 UU5] [VV4 UU4] [VV3 UU3] [VV2 UU2] [VV1 UU1]
-            // ->
-            // yuv0     = [VV4 UU4 004 LL4] [VV3 UU3 003 LL3] [VV2 UU2 002 LL2] [VV1 UU1 001 LL1]
-            // yuv1     = [VV8 UU8 008 LL8] [VV7 UU7 007 LL7] [VV6 UU6 006 LL6] [VV5 UU5 005 LL5]
-            auto yuv0 = _mm_unpacklo_epi16(luma0, chroma00);
-            auto yuv1 = _mm_unpackhi_epi16(luma0, chroma00);
-            auto yuv2 = _mm_unpacklo_epi16(luma1, chroma01);
-            auto yuv3 = _mm_unpackhi_epi16(luma1, chroma01);
-
-            // Shuffle the luma/chroma into the channel ordering we actually want. The high byte of
-            // the luma which is now a constant 0 after converting 8-bit -> 16-bit is used as the
-            // alpha. Luma -> R, U -> G, V -> B, 0 -> A
-            // yuv0 = [VV4 UU4 004 LL4] [VV3 UU3 003 LL3] [VV2 UU2 002 LL2] [VV1 UU1 001 LL1]
-            // ->
-            // yuv0 = [AA4 VV4 UU4 LL4] [AA3 VV3 UU3 LL3] [AA2 VV2 UU2 LL2] [AA1 VV1 UU1 LL1]
-            yuv0 = _mm_shuffle_epi8(yuv0, shuffle_mask);
-            yuv1 = _mm_shuffle_epi8(yuv1, shuffle_mask);
-            yuv2 = _mm_shuffle_epi8(yuv2, shuffle_mask);
-            yuv3 = _mm_shuffle_epi8(yuv3, shuffle_mask);
-
-            // Extend the 8-bit channels we have into 16-bits, as that's the target surface format.
-            // Since this turns just the low 8 bytes into 16 bytes, the second of
-            // each operation here right shifts the register by 8 to get the high pixels.
-            // yuv0  = [AA4] [VV4] [UU4] [LL4] [AA3] [VV3] [UU3] [LL3] [AA2] [VV2] [UU2] [LL2] [AA1] [VV1] [UU1] [LL1]
-            // ->
-            // yuv01 = [002 AA2] [002 VV2] [002 UU2] [002 LL2] [001 AA1] [001 VV1] [001 UU1] [001 LL1]
-            // yuv23 = [004 AA4] [004 VV4] [004 UU4] [004 LL4] [003 AA3] [003 VV3] ]003 UU3] [003 LL3]
-            auto yuv01 = _mm_cvtepu8_epi16(yuv0);
-            auto yuv23 = _mm_cvtepu8_epi16(_mm_srli_si128(yuv0, 8));
-            auto yuv45 = _mm_cvtepu8_epi16(yuv1);
-            auto yuv67 = _mm_cvtepu8_epi16(_mm_srli_si128(yuv1, 8));
-            auto yuv89 = _mm_cvtepu8_epi16(yuv2);
-            auto yuv1011 = _mm_cvtepu8_epi16(_mm_srli_si128(yuv2, 8));
-            auto yuv1213 = _mm_cvtepu8_epi16(yuv3);
-            auto yuv1415 = _mm_cvtepu8_epi16(_mm_srli_si128(yuv3, 8));
-
-            // Left-shift all 16-bit channels by 2, this is to get us into a 10-bit format instead
-            // of 8, which is the format alpha is in, as well as other blending values.
-            yuv01 = _mm_slli_epi16(yuv01, 2);
-            yuv23 = _mm_slli_epi16(yuv23, 2);
-            yuv45 = _mm_slli_epi16(yuv45, 2);
-            yuv67 = _mm_slli_epi16(yuv67, 2);
-            yuv89 = _mm_slli_epi16(yuv89, 2);
-            yuv1011 = _mm_slli_epi16(yuv1011, 2);
-            yuv1213 = _mm_slli_epi16(yuv1213, 2);
-            yuv1415 = _mm_slli_epi16(yuv1415, 2);
-
-            // OR in the planar alpha, this has already been duplicated and shifted into position,
-            // and just fills in the AA channels with the actual alpha value.
-            yuv01 = _mm_or_si128(yuv01, alpha);
-            yuv23 = _mm_or_si128(yuv23, alpha);
-            yuv45 = _mm_or_si128(yuv45, alpha);
-            yuv67 = _mm_or_si128(yuv67, alpha);
-            yuv89 = _mm_or_si128(yuv89, alpha);
-            yuv1011 = _mm_or_si128(yuv1011, alpha);
-            yuv1213 = _mm_or_si128(yuv1213, alpha);
-            yuv1415 = _mm_or_si128(yuv1415, alpha);
-
-            // Store out the pixels. One pixel is now 8 bytes, so each store is 2 pixels.
-            // [AA AA] [VV VV] [UU UU] [LL LL] [AA AA] [VV VV] [UU UU] [LL LL]
-            _mm_store_si128((__m128i*)&slot_surface[dst + x + 0], yuv01);
-            _mm_store_si128((__m128i*)&slot_surface[dst + x + 2], yuv23);
-            _mm_store_si128((__m128i*)&slot_surface[dst + x + 4], yuv45);
-            _mm_store_si128((__m128i*)&slot_surface[dst + x + 6], yuv67);
-            _mm_store_si128((__m128i*)&slot_surface[dst + x + 8], yuv89);
-            _mm_store_si128((__m128i*)&slot_surface[dst + x + 10], yuv1011);
-            _mm_store_si128((__m128i*)&slot_surface[dst + x + 12], yuv1213);
-            _mm_store_si128((__m128i*)&slot_surface[dst + x + 14], yuv1415);
-
-            // clang-format on
-        }
-
-        for (; x < in_luma_width; x++) {
-            slot_surface[dst + x].r = static_cast<u16>(luma_buffer[src_luma + x] << 2);
-            // Chroma samples are duplicated horizontally and vertically.
-            if constexpr (Planar) {
-                slot_surface[dst + x].g =
-                    static_cast<u16>(chroma_u_buffer[src_chroma + x / 2] << 2);
-                slot_surface[dst + x].b =
-                    static_cast<u16>(chroma_v_buffer[src_chroma + x / 2] << 2);
-            } else {
-                slot_surface[dst + x].g =
-                    static_cast<u16>(chroma_u_buffer[src_chroma + (x & ~1) + 0] << 2);
-                slot_surface[dst + x].b =
-                    static_cast<u16>(chroma_u_buffer[src_chroma + (x & ~1) + 1] << 2);
-            }
-            slot_surface[dst + x].a = alpha_linear;
-        }
-    }
-#else
-    DecodeLinear();
-#endif
+    ForEachRowRange(static_cast<u32>(in_luma_height), static_cast<u32>(in_luma_width),
+                    decode_rows);
 }
 
 template <bool Planar, bool TopField>
@@ -441,29 +462,19 @@ void Vic::ReadInterlacedY8__V8U8_N420(const SlotStruct& slot, std::span<const Pl
               in_chroma_stride, out_luma_width, out_luma_height, out_luma_stride,
               out_luma_width / 2, out_luma_height / 2, out_luma_stride);
 
-    [[maybe_unused]] auto DecodeLinear = [&]() {
-        auto DecodeBobField = [&]() {
-            const auto alpha{static_cast<u16>(slot.config.planar_alpha.Value())};
+    auto DecodeBobField = [&]() {
+        const auto alpha{static_cast<u16>(slot.config.planar_alpha.Value())};
+        const s32 first_line = TopField ? 0 : 1;
 
-            for (s32 y = static_cast<s32>(TopField == false); y < in_chroma_height * 2; y += 2) {
-                const auto src_luma{y * in_luma_stride};
+        // Each field line is decoded once and duplicated into the line of the other field.
+        const auto decode_rows = [&](u32 first_row, u32 end_row) {
+            for (s32 y = first_line + static_cast<s32>(first_row) * 2;
+                 y < first_line + static_cast<s32>(end_row) * 2; y += 2) {
                 const auto src_chroma{(y / 2) * in_chroma_stride};
                 const auto dst{y * out_luma_stride};
-                for (s32 x = 0; x < in_luma_width; x++) {
-                    slot_surface[dst + x].r = static_cast<u16>(luma_buffer[src_luma + x] << 2);
-                    if constexpr (Planar) {
-                        slot_surface[dst + x].g =
-                            static_cast<u16>(chroma_u_buffer[src_chroma + x / 2] << 2);
-                        slot_surface[dst + x].b =
-                            static_cast<u16>(chroma_v_buffer[src_chroma + x / 2] << 2);
-                    } else {
-                        slot_surface[dst + x].g =
-                            static_cast<u16>(chroma_u_buffer[src_chroma + (x & ~1) + 0] << 2);
-                        slot_surface[dst + x].b =
-                            static_cast<u16>(chroma_u_buffer[src_chroma + (x & ~1) + 1] << 2);
-                    }
-                    slot_surface[dst + x].a = alpha;
-                }
+                DecodeLine<Planar>(has_sse41, &slot_surface[dst], &luma_buffer[y * in_luma_stride],
+                                   &chroma_u_buffer[src_chroma], &chroma_v_buffer[src_chroma],
+                                   in_luma_width, alpha);
 
                 s32 other_line{};
                 if constexpr (TopField) {
@@ -475,29 +486,29 @@ void Vic::ReadInterlacedY8__V8U8_N420(const SlotStruct& slot, std::span<const Pl
                             out_luma_width * sizeof(Pixel));
             }
         };
-
-        switch (slot.config.deinterlace_mode) {
-        case DXVAHD_DEINTERLACE_MODE_PRIVATE::WEAVE:
-            // Due to the fact that we do not write to memory in nvdec, we cannot use Weave as it
-            // relies on the previous frame.
-            DecodeBobField();
-            break;
-        case DXVAHD_DEINTERLACE_MODE_PRIVATE::BOB_FIELD:
-            DecodeBobField();
-            break;
-        case DXVAHD_DEINTERLACE_MODE_PRIVATE::DISI1:
-            // Due to the fact that we do not write to memory in nvdec, we cannot use DISI1 as it
-            // relies on previous/next frames.
-            DecodeBobField();
-            break;
-        default:
-            UNIMPLEMENTED_MSG("Deinterlace mode {} not implemented!",
-                              static_cast<s32>(slot.config.deinterlace_mode.Value()));
-            break;
-        }
+        ForEachRowRange(static_cast<u32>(in_chroma_height), static_cast<u32>(in_luma_width),
+                        decode_rows);
     };
 
-    DecodeLinear();
+    switch (slot.config.deinterlace_mode) {
+    case DXVAHD_DEINTERLACE_MODE_PRIVATE::WEAVE:
+        // Due to the fact that we do not write to memory in nvdec, we cannot use Weave as it
+        // relies on the previous frame.
+        DecodeBobField();
+        break;
+    case DXVAHD_DEINTERLACE_MODE_PRIVATE::BOB_FIELD:
+        DecodeBobField();
+        break;
+    case DXVAHD_DEINTERLACE_MODE_PRIVATE::DISI1:
+        // Due to the fact that we do not write to memory in nvdec, we cannot use DISI1 as it
+        // relies on previous/next frames.
+        DecodeBobField();
+        break;
+    default:
+        UNIMPLEMENTED_MSG("Deinterlace mode {} not implemented!",
+                          static_cast<s32>(slot.config.deinterlace_mode.Value()));
+        break;
+    }
 }
 
 template <bool Planar>
@@ -563,9 +574,10 @@ void Vic::Blend(const ConfigStruct& config, const SlotStruct& slot) {
     // TODO Alpha blending. No games I've seen use more than a single surface or supply an alpha
     // below max, so it's ignored for now.
 
-    if (!slot.color_matrix.matrix_enable) {
-        const auto copy_width = std::min(source_right - source_left, rect_right - rect_left);
+    const auto copy_width = std::min(source_right - source_left, rect_right - rect_left);
+    const auto copy_height = source_bottom - source_top;
 
+    if (!slot.color_matrix.matrix_enable) {
         for (u32 y = source_top; y < source_bottom; y++) {
             const auto dst_line = y * out_surface_width;
             const auto src_line = y * in_surface_width;
@@ -581,7 +593,8 @@ void Vic::Blend(const ConfigStruct& config, const SlotStruct& slot) {
         //                           | 1 |
         // clang-format on
 
-        [[maybe_unused]] auto DecodeLinear = [&]() {
+        // Converts the pixels from first_x onwards of the rows [first_row, end_row) of the copy.
+        auto DecodeLinear = [&](u32 first_row, u32 end_row, u32 first_x) {
             const auto r0c0 = static_cast<s32>(slot.color_matrix.matrix_coeff00.Value());
             const auto r0c1 = static_cast<s32>(slot.color_matrix.matrix_coeff01.Value());
             const auto r0c2 = static_cast<s32>(slot.color_matrix.matrix_coeff02.Value());
@@ -623,10 +636,10 @@ void Vic::Blend(const ConfigStruct& config, const SlotStruct& slot) {
                 return {r, g, b, static_cast<s32>(in_pixel.a)};
             };
 
-            for (u32 y = source_top; y < source_bottom; y++) {
+            for (u32 y = source_top + first_row; y < source_top + end_row; y++) {
                 const auto src{y * in_surface_width + source_left};
                 const auto dst{y * out_surface_width + rect_left};
-                for (u32 x = source_left; x < source_right; x++) {
+                for (u32 x = first_x; x < copy_width; x++) {
                     auto [r, g, b, a] = MatMul(slot_surface[src + x]);
 
                     r = std::clamp(r, clamp_min, clamp_max);
@@ -642,7 +655,9 @@ void Vic::Blend(const ConfigStruct& config, const SlotStruct& slot) {
 
 #if defined(ARCHITECTURE_x86_64)
         if (!has_sse41) {
-            DecodeLinear();
+            ForEachRowRange(copy_height, copy_width, [&](u32 first_row, u32 end_row) {
+                DecodeLinear(first_row, end_row, 0);
+            });
             return;
         }
 #endif
@@ -709,89 +724,97 @@ void Vic::Blend(const ConfigStruct& config, const SlotStruct& slot) {
             return _mm_srai_epi32(out, 8);
         };
 
-        for (u32 y = source_top; y < source_bottom; y++) {
-            const auto src{y * in_surface_width + source_left};
-            const auto dst{y * out_surface_width + rect_left};
-            for (u32 x = source_left; x < source_right; x += 8) {
-                // clang-format off
-                // Prefetch the next iteration's memory
-                _mm_prefetch((const char*)&slot_surface[src + x + 8], _MM_HINT_T0);
-
-                // Load in pixels
-                // p01 = [AA AA] [BB BB] [GG GG] [RR RR] [AA AA] [BB BB] [GG GG] [RR RR]
-                auto p01 = _mm_load_si128((__m128i*)&slot_surface[src + x + 0]);
-                auto p23 = _mm_load_si128((__m128i*)&slot_surface[src + x + 2]);
-                auto p45 = _mm_load_si128((__m128i*)&slot_surface[src + x + 4]);
-                auto p67 = _mm_load_si128((__m128i*)&slot_surface[src + x + 6]);
-
-                // Convert the 16-bit channels into 32-bit (unsigned), as the matrix values are
-                // 32-bit and to avoid overflow.
-                // p01    = [AA2 AA2] [BB2 BB2] [GG2 GG2] [RR2 RR2] [AA1 AA1] [BB1 BB1] [GG1 GG1] [RR1 RR1]
-                // ->
-                // p01_lo = [001 001 AA1 AA1] [001 001 BB1 BB1] [001 001 GG1 GG1] [001 001 RR1 RR1]
-                // p01_hi = [002 002 AA2 AA2] [002 002 BB2 BB2] [002 002 GG2 GG2] [002 002 RR2 RR2]
-                auto p01_lo = _mm_cvtepu16_epi32(p01);
-                auto p01_hi = _mm_cvtepu16_epi32(_mm_srli_si128(p01, 8));
-                auto p23_lo = _mm_cvtepu16_epi32(p23);
-                auto p23_hi = _mm_cvtepu16_epi32(_mm_srli_si128(p23, 8));
-                auto p45_lo = _mm_cvtepu16_epi32(p45);
-                auto p45_hi = _mm_cvtepu16_epi32(_mm_srli_si128(p45, 8));
-                auto p67_lo = _mm_cvtepu16_epi32(p67);
-                auto p67_hi = _mm_cvtepu16_epi32(_mm_srli_si128(p67, 8));
-
-                // Matrix multiply the pixel, doing the colour conversion.
-                auto out0 = MatMul(p01_lo, c0, c1, c2, c3, shift);
-                auto out1 = MatMul(p01_hi, c0, c1, c2, c3, shift);
-                auto out2 = MatMul(p23_lo, c0, c1, c2, c3, shift);
-                auto out3 = MatMul(p23_hi, c0, c1, c2, c3, shift);
-                auto out4 = MatMul(p45_lo, c0, c1, c2, c3, shift);
-                auto out5 = MatMul(p45_hi, c0, c1, c2, c3, shift);
-                auto out6 = MatMul(p67_lo, c0, c1, c2, c3, shift);
-                auto out7 = MatMul(p67_hi, c0, c1, c2, c3, shift);
-
-                // Pack the 32-bit channel pixels back into 16-bit using unsigned saturation
-                // out0  = [001 001 AA1 AA1] [001 001 BB1 BB1] [001 001 GG1 GG1] [001 001 RR1 RR1]
-                // out1  = [002 002 AA2 AA2] [002 002 BB2 BB2] [002 002 GG2 GG2] [002 002 RR2 RR2]
-                // ->
-                // done0 = [AA2 AA2] [BB2 BB2] [GG2 GG2] [RR2 RR2] [AA1 AA1] [BB1 BB1] [GG1 GG1] [RR1 RR1]
-                auto done0 = _mm_packus_epi32(out0, out1);
-                auto done1 = _mm_packus_epi32(out2, out3);
-                auto done2 = _mm_packus_epi32(out4, out5);
-                auto done3 = _mm_packus_epi32(out6, out7);
-
-                // Blend the original alpha back into the pixel, as the matrix multiply gives us a
-                // 3-channel output, not 4.
-                // 0x88 = b10001000, taking RGB from the first argument, A from the second argument.
-                // done0 = [002 002] [BB2 BB2] [GG2 GG2] [RR2 RR2] [001 001] [BB1 BB1] [GG1 GG1] [RR1 RR1]
-                // ->
-                // done0 = [AA2 AA2] [BB2 BB2] [GG2 GG2] [RR2 RR2] [AA1 AA1] [BB1 BB1] [GG1 GG1] [RR1 RR1]
-                done0 = _mm_blend_epi16(done0, p01, 0x88);
-                done1 = _mm_blend_epi16(done1, p23, 0x88);
-                done2 = _mm_blend_epi16(done2, p45, 0x88);
-                done3 = _mm_blend_epi16(done3, p67, 0x88);
-
-                // Clamp the 16-bit channels to the soft-clamp min/max.
-                done0 = _mm_max_epu16(done0, clamp_min);
-                done1 = _mm_max_epu16(done1, clamp_min);
-                done2 = _mm_max_epu16(done2, clamp_min);
-                done3 = _mm_max_epu16(done3, clamp_min);
-
-                done0 = _mm_min_epu16(done0, clamp_max);
-                done1 = _mm_min_epu16(done1, clamp_max);
-                done2 = _mm_min_epu16(done2, clamp_max);
-                done3 = _mm_min_epu16(done3, clamp_max);
-
-                // Store the pixels to the output surface.
-                _mm_store_si128((__m128i*)&output_surface[dst + x + 0], done0);
-                _mm_store_si128((__m128i*)&output_surface[dst + x + 2], done1);
-                _mm_store_si128((__m128i*)&output_surface[dst + x + 4], done2);
-                _mm_store_si128((__m128i*)&output_surface[dst + x + 6], done3);
+        const auto decode_rows = [&](u32 first_row, u32 end_row) {
+            for (u32 y = source_top + first_row; y < source_top + end_row; y++) {
+                const auto src{y * in_surface_width + source_left};
+                const auto dst{y * out_surface_width + rect_left};
+                u32 x = 0;
+                for (; x + 8 <= copy_width; x += 8) {
+                    // clang-format off
+                    // Prefetch the next iteration's memory
+                    _mm_prefetch((const char*)&slot_surface[src + x + 8], _MM_HINT_T0);
+
+                    // Load in pixels
+                    // p01 = [AA AA] [BB BB] [GG GG] [RR RR] [AA AA] [BB BB] [GG GG] [RR RR]
+                    auto p01 = _mm_load_si128((__m128i*)&slot_surface[src + x + 0]);
+                    auto p23 = _mm_load_si128((__m128i*)&slot_surface[src + x + 2]);
+                    auto p45 = _mm_load_si128((__m128i*)&slot_surface[src + x + 4]);
+                    auto p67 = _mm_load_si128((__m128i*)&slot_surface[src + x + 6]);
+
+                    // Convert the 16-bit channels into 32-bit (unsigned), as the matrix values are
+                    // 32-bit and to avoid overflow.
+                    // p01    = [AA2 AA2] [BB2 BB2] [GG2 GG2] [RR2 RR2] [AA1 AA1] [BB1 BB1] [GG1 GG1] [RR1 RR1]
+                    // ->
+                    // p01_lo = [001 001 AA1 AA1] [001 001 BB1 BB1] [001 001 GG1 GG1] [001 001 RR1 RR1]
+                    // p01_hi = [002 002 AA2 AA2] [002 002 BB2 BB2] [002 002 GG2 GG2] [002 002 RR2 RR2]
+                    auto p01_lo = _mm_cvtepu16_epi32(p01);
+                    auto p01_hi = _mm_cvtepu16_epi32(_mm_srli_si128(p01, 8));
+                    auto p23_lo = _mm_cvtepu16_epi32(p23);
+                    auto p23_hi = _mm_cvtepu16_epi32(_mm_srli_si128(p23, 8));
+                    auto p45_lo = _mm_cvtepu16_epi32(p45);
+                    auto p45_hi = _mm_cvtepu16_epi32(_mm_srli_si128(p45, 8));
+                    auto p67_lo = _mm_cvtepu16_epi32(p67);
+                    auto p67_hi = _mm_cvtepu16_epi32(_mm_srli_si128(p67, 8));
+
+                    // Matrix multiply the pixel, doing the colour conversion.
+                    auto out0 = MatMul(p01_lo, c0, c1, c2, c3, shift);
+                    auto out1 = MatMul(p01_hi, c0, c1, c2, c3, shift);
+                    auto out2 = MatMul(p23_lo, c0, c1, c2, c3, shift);
+                    auto out3 = MatMul(p23_hi, c0, c1, c2, c3, shift);
+                    auto out4 = MatMul(p45_lo, c0, c1, c2, c3, shift);
+                    auto out5 = MatMul(p45_hi, c0, c1, c2, c3, shift);
+                    auto out6 = MatMul(p67_lo, c0, c1, c2, c3, shift);
+                    auto out7 = MatMul(p67_hi, c0, c1, c2, c3, shift);
+
+                    // Pack the 32-bit channel pixels back into 16-bit using unsigned saturation
+                    // out0  = [001 001 AA1 AA1] [001 001 BB1 BB1] [001 001 GG1 GG1] [001 001 RR1 RR1]
+                    // out1  = [002 002 AA2 AA2] [002 002 BB2 BB2] [002 002 GG2 GG2] [002 002 RR2 RR2]
+                    // ->
+                    // done0 = [AA2 AA2] [BB2 BB2] [GG2 GG2] [RR2 RR2] [AA1 AA1] [BB1 BB1] [GG1 GG1] [RR1 RR1]
+                    auto done0 = _mm_packus_epi32(out0, out1);
+                    auto done1 = _mm_packus_epi32(out2, out3);
+                    auto done2 = _mm_packus_epi32(out4, out5);
+                    auto done3 = _mm_packus_epi32(out6, out7);
+
+                    // Blend the original alpha back into the pixel, as the matrix multiply gives us a
+                    // 3-channel output, not 4.
+                    // 0x88 = b10001000, taking RGB from the first argument, A from the second argument.
+                    // done0 = [002 002] [BB2 BB2] [GG2 GG2] [RR2 RR2] [001 001] [BB1 BB1] [GG1 GG1] [RR1 RR1]
+                    // ->
+                    // done0 = [AA2 AA2] [BB2 BB2] [GG2 GG2] [RR2 RR2] [AA1 AA1] [BB1 BB1] [GG1 GG1] [RR1 RR1]
+                    done0 = _mm_blend_epi16(done0, p01, 0x88);
+                    done1 = _mm_blend_epi16(done1, p23, 0x88);
+                    done2 = _mm_blend_epi16(done2, p45, 0x88);
+                    done3 = _mm_blend_epi16(done3, p67, 0x88);
+
+                    // Clamp the 16-bit channels to the soft-clamp min/max.
+                    done0 = _mm_max_epu16(done0, clamp_min);
+                    done1 = _mm_max_epu16(done1, clamp_min);
+                    done2 = _mm_max_epu16(done2, clamp_min);
+                    done3 = _mm_max_epu16(done3, clamp_min);
+
+                    done0 = _mm_min_epu16(done0, clamp_max);
+                    done1 = _mm_min_epu16(done1, clamp_max);
+                    done2 = _mm_min_epu16(done2, clamp_max);
+                    done3 = _mm_min_epu16(done3, clamp_max);
+
+                    // Store the pixels to the output surface.
+                    _mm_store_si128((__m128i*)&output_surface[dst + x + 0], done0);
+                    _mm_store_si128((__m128i*)&output_surface[dst + x + 2], done1);
+                    _mm_store_si128((__m128i*)&output_surface[dst + x + 4], done2);
+                    _mm_store_si128((__m128i*)&output_surface[dst + x + 6], done3);
 
+                }
+                // The remaining pixels of the row
+                DecodeLinear(y - source_top, y - source_top + 1, x);
             }
-        }
+        };
         // clang-format on
+        ForEachRowRange(copy_height, copy_width, decode_rows);
 #else
-        DecodeLinear();
+        ForEachRowRange(copy_height, copy_width, [&](u32 first_row, u32 end_row) {
+            DecodeLinear(first_row, end_row, 0);
+        });
 #endif
     }
 }
@@ -816,8 +839,10 @@ void Vic::WriteY8__V8U8_N420(const OutputSurfaceConfig& output_surface_config) {
     surface_width = std::min(surface_width, out_luma_width);
     surface_height = std::min(surface_height, out_luma_height);
 
-    [[maybe_unused]] auto DecodeLinear = [&](std::span<u8> out_luma, std::span<u8> out_chroma) {
-        for (u32 y = 0; y < surface_height; ++y) {
+    // Chroma is only written from even rows, so rows can be decoded in any order
+    [[maybe_unused]] auto DecodeLinear = [&](std::span<u8> out_luma, std::span<u8> out_chroma,
+                                             u32 first_row, u32 end_row) {
+        for (u32 y = first_row; y < end_row; ++y) {
             const auto src_luma = y * surface_stride;
             const auto dst_luma = y * out_luma_stride;
             const auto src_chroma = y * surface_stride;
@@ -827,18 +852,21 @@ void Vic::WriteY8__V8U8_N420(const OutputSurfaceConfig& output_surface_config) {
                     static_cast<u8>(output_surface[src_luma + x + 0].r >> 2);
                 out_luma[dst_luma + x + 1] =
                     static_cast<u8>(output_surface[src_luma + x + 1].r >> 2);
-                out_chroma[dst_chroma + x + 0] =
-                    static_cast<u8>(output_surface[src_chroma + x].g >> 2);
-                out_chroma[dst_chroma + x + 1] =
-                    static_cast<u8>(output_surface[src_chroma + x].b >> 2);
+                if (y % 2 == 0) {
+                    out_chroma[dst_chroma + x + 0] =
+                        static_cast<u8>(output_surface[src_chroma + x].g >> 2);
+                    out_chroma[dst_chroma + x + 1] =
+                        static_cast<u8>(output_surface[src_chroma + x].b >> 2);
+                }
             }
         }
     };
 
-    auto Decode = [&](std::span<u8> out_luma, std::span<u8> out_chroma) {
+    auto DecodeRows = [&](std::span<u8> out_luma, std::span<u8> out_chroma, u32 first_row,
+                          u32 end_row) {
 #if defined(ARCHITECTURE_x86_64)
         if (!has_sse41) {
-            DecodeLinear(out_luma, out_chroma);
+            DecodeLinear(out_luma, out_chroma, first_row, end_row);
             return;
         }
 #endif
@@ -849,7 +877,7 @@ void Vic::WriteY8__V8U8_N420(const OutputSurfaceConfig& output_surface_config) {
 
         const auto sse_aligned_width = Common::AlignDown(surface_width, 16);
 
-        for (u32 y = 0; y < surface_height; ++y) {
+        for (u32 y = first_row; y < end_row; ++y) {
             const auto src = y * surface_stride;
             const auto dst_luma = y * out_luma_stride;
             const auto dst_chroma = (y / 2) * out_chroma_stride;
@@ -977,17 +1005,25 @@ void Vic::WriteY8__V8U8_N420(const OutputSurfaceConfig& output_surface_config) {
             for (; x < surface_width; x += 2) {
                 out_luma[dst_luma + x + 0] = static_cast<u8>(output_surface[src + x + 0].r >> 2);
                 out_luma[dst_luma + x + 1] = static_cast<u8>(output_surface[src + x + 1].r >> 2);
-                out_chroma[dst_chroma + x + 0] =
-                    static_cast<u8>(output_surface[src_chroma + x].g >> 2);
-                out_chroma[dst_chroma + x + 1] =
-                    static_cast<u8>(output_surface[src_chroma + x].b >> 2);
+                if (y % 2 == 0) {
+                    out_chroma[dst_chroma + x + 0] =
+                        static_cast<u8>(output_surface[src_chroma + x].g >> 2);
+                    out_chroma[dst_chroma + x + 1] =
+                        static_cast<u8>(output_surface[src_chroma + x].b >> 2);
+                }
             }
         }
 #else
-        DecodeLinear(out_luma, out_chroma);
+        DecodeLinear(out_luma, out_chroma, first_row, end_row);
 #endif
     };
 
+    auto Decode = [&](std::span<u8> out_luma, std::span<u8> out_chroma) {
+        ForEachRowRange(surface_height, surface_width, [&](u32 first_row, u32 end_row) {
+            DecodeRows(out_luma, out_chroma, first_row, end_row);
+        });
+    };
+
     switch (output_surface_config.out_block_kind) {
     case BLK_KIND::GENERIC_16Bx2: {
         const u32 block_height = static_cast<u32>(output_surface_config.out_block_height);
@@ -1087,8 +1123,9 @@ void Vic::WriteABGR(const OutputSurfaceConfig& output_surface_config) {
     surface_width = std::min(surface_width, out_luma_width);
     surface_height = std::min(surface_height, out_luma_height);
 
-    [[maybe_unused]] auto DecodeLinear = [&](std::span<u8> out_buffer) {
-        for (u32 y = 0; y < surface_height; y++) {
+    [[maybe_unused]] auto DecodeLinear = [&](std::span<u8> out_buffer, u32 first_row,
+                                             u32 end_row) {
+        for (u32 y = first_row; y < end_row; y++) {
             const auto src = y * surface_stride;
             const auto dst = y * out_luma_stride;
             for (u32 x = 0; x < surface_width; x++) {
@@ -1107,10 +1144,10 @@ void Vic::WriteABGR(const OutputSurfaceConfig& output_surface_config) {
         }
     };
 
-    auto Decode = [&](std::span<u8> out_buffer) {
+    auto DecodeRows = [&](std::span<u8> out_buffer, u32 first_row, u32 end_row) {
 #if defined(ARCHITECTURE_x86_64)
         if (!has_sse41) {
-            DecodeLinear(out_buffer);
+            DecodeLinear(out_buffer, first_row, end_row);
             return;
         }
 #endif
@@ -1119,7 +1156,7 @@ void Vic::WriteABGR(const OutputSurfaceConfig& output_surface_config) {
         constexpr size_t SseAlignment = 16;
         const auto sse_aligned_width = Common::AlignDown(surface_width, SseAlignment);
 
-        for (u32 y = 0; y < surface_height; y++) {
+        for (u32 y = first_row; y < end_row; y++) {
             const auto src = y * surface_stride;
             const auto dst = y * out_luma_stride;
             u32 x = 0;
@@ -1199,10 +1236,16 @@ void Vic::WriteABGR(const OutputSurfaceConfig& output_surface_config) {
             }
         }
 #else
-        DecodeLinear(out_buffer);
+        DecodeLinear(out_buffer, first_row, end_row);
 #endif
     };
 
+    auto Decode = [&](std::span<u8> out_buffer) {
+        ForEachRowRange(surface_height, surface_width, [&](u32 first_row, u32 end_row) {
+            DecodeRows(out_buffer, first_row, end_row);
+        });
+    };
+
     switch (output_surface_config.out_block_kind) {
     case BLK_KIND::GENERIC_16Bx2: {
         const u32 block_height = static_cast<u32>(output_surface_config.out_block_height);
@@ -11,6 +11,7 @@
 
 #include "common/common_types.h"
 #include "common/scratch_buffer.h"
+#include "common/thread_worker.h"
 #include "video_core/cdma_pusher.h"
 
 namespace Tegra::Host1x {
@@ -629,6 +630,11 @@ private:
     template <VideoPixelFormat Format>
     void WriteABGR(const OutputSurfaceConfig& output_surface_config);
 
+    /// Invokes func(first_row, end_row) over [0, num_rows), split across threads for large
+    /// frames. Ranges never share a row, func must not write outside of its own rows.
+    template <typename Func>
+    void ForEachRowRange(u32 num_rows, u32 row_width, Func&& func);
+
     s32 id;
     s32 nvdec_id{-1};
     u32 syncpoint;
@@ -643,6 +649,8 @@ private:
     Common::ScratchBuffer<u8> luma_scratch;
     Common::ScratchBuffer<u8> chroma_scratch;
     Common::ScratchBuffer<u8> swizzle_scratch;
+
+    std::unique_ptr<Common::ThreadWorker> workers;
 };
 
 } // namespace Tegra::Host1x
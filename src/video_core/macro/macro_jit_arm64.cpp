@@ -0,0 +1,532 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <vector>
+
+#include <oaknut/code_block.hpp>
+#include <oaknut/oaknut.hpp>
+
+#include "common/assert.h"
+#include "common/logging/log.h"
+#include "common/microprofile.h"
+#include "video_core/engines/maxwell_3d.h"
+#include "video_core/macro/macro_jit_arm64.h"
+
+MICROPROFILE_DEFINE(MacroJitCompile, "GPU", "Compile macro JIT", MP_RGB(173, 255, 47));
+MICROPROFILE_DEFINE(MacroJitExecute, "GPU", "Execute macro JIT", MP_RGB(255, 255, 0));
+
+namespace Tegra {
+namespace {
+using namespace oaknut::util;
+
+// Macro registers 1-7 are kept in W19-W25 for the whole program, register 0 reads as zero
+constexpr int MACRO_REGISTER_BASE = 18;
+constexpr oaknut::XReg STATE = X26;
+constexpr oaknut::XReg PARAMETERS = X27;
+constexpr oaknut::WReg METHOD_ADDRESS = W28;
+
+constexpr oaknut::WReg RESULT = W8;
+constexpr oaknut::XReg RESULT_X = X8;
+constexpr oaknut::WReg SCRATCH0 = W9;
+constexpr oaknut::XReg SCRATCH0_X = X9;
+constexpr oaknut::WReg SCRATCH1 = W10;
+constexpr oaknut::XReg SCRATCH1_X = X10;
+constexpr oaknut::WReg ZERO_A = W11;
+constexpr oaknut::WReg ZERO_B = W12;
+
+// Upper bound of host instructions emitted per macro instruction. An instruction is emitted once in
+// place and at most twice more as the delay slot of a preceding branch or exit.
+constexpr size_t MAX_WORDS_PER_INSTRUCTION = 192;
+constexpr size_t FIXED_CODE_WORDS = 64;
+
+constexpr size_t REG_ARRAY_OFFSET =
+    offsetof(Engines::Maxwell3D, regs) + offsetof(Engines::Maxwell3D::Regs, reg_array);
+
+size_t CodeSize(size_t num_instructions) {
+    return (num_instructions * MAX_WORDS_PER_INSTRUCTION + FIXED_CODE_WORDS) * sizeof(u32);
+}
+
+oaknut::WReg MacroRegister(u32 index) {
+    return oaknut::WReg{MACRO_REGISTER_BASE + static_cast<int>(index)};
+}
+
+void Send(Engines::Maxwell3D* maxwell3d, Macro::MethodAddress method_address, u32 value) {
+    maxwell3d->CallMethod(method_address.address, value, true);
+}
+
+void WarnInvalidParameter(uintptr_t parameter, uintptr_t max_parameter) {
+    LOG_CRITICAL(HW_GPU,
+                 "Macro JIT: invalid parameter access 0x{:x} (0x{:x} is the last parameter)",
+                 parameter, max_parameter - sizeof(u32));
+}
+
+class MacroJITArm64Impl final : public CachedMacro {
+public:
+    explicit MacroJITArm64Impl(Engines::Maxwell3D& maxwell3d_, const std::vector<u32>& code_)
+        : code{code_}, maxwell3d{maxwell3d_}, code_block{CodeSize(code_.size())},
+          c{code_block.ptr()}, labels(code_.size()) {
+        Compile();
+    }
+
+    void Execute(const std::vector<u32>& parameters, u32 method) override;
+
+private:
+    struct JITState {
+        Engines::Maxwell3D* maxwell3d{};
+        const u32* parameters_end{};
+        u32 carry_flag{};
+    };
+    using ProgramType = void (*)(JITState*, const u32*);
+
+    void Compile();
+    void Compile_Prologue();
+    void Compile_Epilogue();
+    void Compile_InvalidParameterHandler();
+
+    void Compile_Instruction(u32 index, bool is_delay_slot);
+    void Compile_ALU(Macro::Opcode opcode);
+    void Compile_AddImmediate(Macro::Opcode opcode);
+    void Compile_ExtractInsert(Macro::Opcode opcode);
+    void Compile_ExtractShiftLeftImmediate(Macro::Opcode opcode);
+    void Compile_ExtractShiftLeftRegister(Macro::Opcode opcode);
+    void Compile_Read(Macro::Opcode opcode);
+    void Compile_Branch(u32 index, Macro::Opcode opcode);
+
+    void Compile_ProcessResult(Macro::ResultOperation operation, u32 reg);
+    void Compile_FetchParameter(oaknut::WReg dst);
+    void Compile_Send(oaknut::WReg value);
+    void Compile_AddConstant(oaknut::WReg dst, oaknut::WReg src, s32 value);
+    void Compile_LoadCarry();
+    void Compile_StoreCarry();
+
+    template <typename Function>
+    void Compile_CallFunction(Function* function) {
+        c.MOV(X16, reinterpret_cast<u64>(function));
+        c.BLR(X16);
+    }
+
+    /// Returns the host register of a macro register, register 0 is materialized in zero_reg
+    oaknut::WReg GetRegister(u32 index, oaknut::WReg zero_reg);
+    void SetRegister(u32 index, oaknut::WReg value);
+
+    const std::vector<u32>& code;
+    Engines::Maxwell3D& maxwell3d;
+
+    oaknut::CodeBlock code_block;
+    oaknut::CodeGenerator c;
+    std::vector<oaknut::Label> labels;
+    oaknut::Label end_of_code;
+    oaknut::Label invalid_parameter;
+
+    bool uses_carry{};
+    ProgramType program{};
+};
+
+void MacroJITArm64Impl::Execute(const std::vector<u32>& parameters, u32 method) {
+    MICROPROFILE_SCOPE(MacroJitExecute);
+    ASSERT_OR_EXECUTE(program != nullptr, { return; });
+    JITState state{
+        .maxwell3d = &maxwell3d,
+        .parameters_end = parameters.data() + parameters.size(),
+    };
+    program(&state, parameters.data());
+}
+
+void MacroJITArm64Impl::Compile() {
+    MICROPROFILE_SCOPE(MacroJitCompile);
+
+    // Carry is only tracked when the program consumes it
+    uses_carry = std::ranges::any_of(code, [](u32 raw) {
+        const Macro::Opcode opcode{raw};
+        return opcode.operation == Macro::Operation::ALU &&
+               (opcode.alu_operation == Macro::ALUOperation::AddWithCarry ||
+                opcode.alu_operation == Macro::ALUOperation::SubtractWithBorrow);
+    });
+
+    code_block.unprotect();
+    Compile_Prologue();
+
+    const u32 op_count = static_cast<u32>(code.size());
+    for (u32 index = 0; index < op_count; ++index) {
+        c.l(labels[index]);
+        Compile_Instruction(index, false);
+    }
+
+    // Running past the end of the program is treated as an exit
+    c.l(end_of_code);
+    Compile_Epilogue();
+    Compile_InvalidParameterHandler();
+
+    ASSERT(static_cast<size_t>(c.offset()) <= CodeSize(code.size()));
+    code_block.protect();
+    code_block.invalidate_all();
+    program = reinterpret_cast<ProgramType>(code_block.ptr());
+}
+
+void MacroJITArm64Impl::Compile_Prologue() {
+    c.STP(X29, X30, SP, PRE_INDEXED, -96);
+    c.MOV(X29, SP);
+    c.STP(X19, X20, SP, 16);
+    c.STP(X21, X22, SP, 32);
+    c.STP(X23, X24, SP, 48);
+    c.STP(X25, X26, SP, 64);
+    c.STP(X27, X28, SP, 80);
+
+    c.MOV(STATE, X0);
+    c.MOV(PARAMETERS, X1);
+    c.MOV(METHOD_ADDRESS, u32{0});
+    for (u32 index = 2; index < Macro::NUM_MACRO_REGISTERS; ++index) {
+        c.MOV(MacroRegister(index), u32{0});
+    }
+    // Register 1 starts with the value of the first parameter
+    Compile_FetchParameter(MacroRegister(1));
+}
+
+void MacroJITArm64Impl::Compile_Epilogue() {
+    c.LDP(X19, X20, SP, 16);
+    c.LDP(X21, X22, SP, 32);
+    c.LDP(X23, X24, SP, 48);
+    c.LDP(X25, X26, SP, 64);
+    c.LDP(X27, X28, SP, 80);
+    c.LDP(X29, X30, SP, POST_INDEXED, 96);
+    c.RET();
+}
+
+void MacroJITArm64Impl::Compile_InvalidParameterHandler() {
+    // Out of line so parameter fetches stay small, the result register is live across the call
+    c.l(invalid_parameter);
+    c.STP(RESULT_X, X30, SP, PRE_INDEXED, -16);
+    c.MOV(X0, PARAMETERS);
+    c.LDR(X1, STATE, offsetof(JITState, parameters_end));
+    Compile_CallFunction(&WarnInvalidParameter);
+    c.LDP(RESULT_X, X30, SP, POST_INDEXED, 16);
+    c.RET();
+}
+
+void MacroJITArm64Impl::Compile_Instruction(u32 index, bool is_delay_slot) {
+    const Macro::Opcode opcode{code[index]};
+    switch (opcode.operation) {
+    case Macro::Operation::ALU:
+        Compile_ALU(opcode);
+        break;
+    case Macro::Operation::AddImmediate:
+        Compile_AddImmediate(opcode);
+        break;
+    case Macro::Operation::ExtractInsert:
+        Compile_ExtractInsert(opcode);
+        break;
+    case Macro::Operation::ExtractShiftLeftImmediate:
+        Compile_ExtractShiftLeftImmediate(opcode);
+        break;
+    case Macro::Operation::ExtractShiftLeftRegister:
+        Compile_ExtractShiftLeftRegister(opcode);
+        break;
+    case Macro::Operation::Read:
+        Compile_Read(opcode);
+        break;
+    case Macro::Operation::Branch:
+        ASSERT_MSG(!is_delay_slot, "Executing a branch in a delay slot is not valid");
+        if (!is_delay_slot) {
+            Compile_Branch(index, opcode);
+        }
+        break;
+    default:
+        UNIMPLEMENTED_MSG("Unimplemented opcode {}", opcode.operation.Value());
+        break;
+    }
+
+    // An instruction with the Exit flag will not actually cause an exit inside a delay slot.
+    if (opcode.is_exit && !is_delay_slot) {
+        // Exit has a delay slot, execute the next instruction
+        if (index + 1 < code.size()) {
+            Compile_Instruction(index + 1, true);
+        }
+        c.B(end_of_code);
+    }
+}
+
+void MacroJITArm64Impl::Compile_ALU(Macro::Opcode opcode) {
+    const auto src_a = GetRegister(opcode.src_a, ZERO_A);
+    const auto src_b = GetRegister(opcode.src_b, ZERO_B);
+
+    switch (opcode.alu_operation) {
+    case Macro::ALUOperation::Add:
+        if (uses_carry) {
+            c.ADDS(RESULT, src_a, src_b);
+            Compile_StoreCarry();
+        } else {
+            c.ADD(RESULT, src_a, src_b);
+        }
+        break;
+    case Macro::ALUOperation::AddWithCarry:
+        Compile_LoadCarry();
+        c.ADCS(RESULT, src_a, src_b);
+        Compile_StoreCarry();
+        break;
+    case Macro::ALUOperation::Subtract:
+        // The macro carry flag is set when there is no borrow, which matches AArch64
+        if (uses_carry) {
+            c.SUBS(RESULT, src_a, src_b);
+            Compile_StoreCarry();
+        } else {
+            c.SUB(RESULT, src_a, src_b);
+        }
+        break;
+    case Macro::ALUOperation::SubtractWithBorrow:
+        Compile_LoadCarry();
+        c.SBCS(RESULT, src_a, src_b);
+        Compile_StoreCarry();
+        break;
+    case Macro::ALUOperation::Xor:
+        c.EOR(RESULT, src_a, src_b);
+        break;
+    case Macro::ALUOperation::Or:
+        c.ORR(RESULT, src_a, src_b);
+        break;
+    case Macro::ALUOperation::And:
+        c.AND(RESULT, src_a, src_b);
+        break;
+    case Macro::ALUOperation::AndNot:
+        c.BIC(RESULT, src_a, src_b);
+        break;
+    case Macro::ALUOperation::Nand:
+        c.AND(RESULT, src_a, src_b);
+        c.MVN(RESULT, RESULT);
+        break;
+    default:
+        UNIMPLEMENTED_MSG("Unimplemented ALU operation {}", opcode.alu_operation.Value());
+        break;
+    }
+    Compile_ProcessResult(opcode.result_operation, opcode.dst);
+}
+
+void MacroJITArm64Impl::Compile_AddImmediate(Macro::Opcode opcode) {
+    // Games tend to use this as an exit instruction placeholder, there is nothing to emit
+    if (opcode.result_operation == Macro::ResultOperation::Move && opcode.dst == 0) {
+        return;
+    }
+    Compile_AddConstant(RESULT, GetRegister(opcode.src_a, ZERO_A), opcode.immediate);
+    Compile_ProcessResult(opcode.result_operation, opcode.dst);
+}
+
+void MacroJITArm64Impl::Compile_ExtractInsert(Macro::Opcode opcode) {
+    const auto dst = GetRegister(opcode.src_a, ZERO_A);
+    const auto src = GetRegister(opcode.src_b, ZERO_B);
+    const u32 size = opcode.bf_size;
+    const u32 src_bit = opcode.bf_src_bit;
+    const u32 dst_bit = opcode.bf_dst_bit;
+
+    c.MOV(RESULT, dst);
+    if (size != 0) {
+        // Masks reaching past bit 31 are truncated, clamp the field widths the same way
+        c.UBFX(SCRATCH0, src, src_bit, std::min(size, 32 - src_bit));
+        c.BFI(RESULT, SCRATCH0, dst_bit, std::min(size, 32 - dst_bit));
+    }
+    Compile_ProcessResult(opcode.result_operation, opcode.dst);
+}
+
+void MacroJITArm64Impl::Compile_ExtractShiftLeftImmediate(Macro::Opcode opcode) {
+    const auto shift = GetRegister(opcode.src_a, ZERO_A);
+    const auto src = GetRegister(opcode.src_b, ZERO_B);
+    const u32 size = opcode.bf_size;
+    const u32 dst_bit = opcode.bf_dst_bit;
+
+    if (size == 0) {
+        c.MOV(RESULT, u32{0});
+    } else {
+        c.LSR(RESULT, src, shift);
+        c.UBFIZ(RESULT, RESULT, dst_bit, std::min(size, 32 - dst_bit));
+    }
+    Compile_ProcessResult(opcode.result_operation, opcode.dst);
+}
+
+void MacroJITArm64Impl::Compile_ExtractShiftLeftRegister(Macro::Opcode opcode) {
+    const auto shift = GetRegister(opcode.src_a, ZERO_A);
+    const auto src = GetRegister(opcode.src_b, ZERO_B);
+    const u32 size = opcode.bf_size;
+    const u32 src_bit = opcode.bf_src_bit;
+
+    if (size == 0) {
+        c.MOV(RESULT, u32{0});
+    } else {
+        c.UBFX(RESULT, src, src_bit, std::min(size, 32 - src_bit));
+        c.LSL(RESULT, RESULT, shift);
+    }
+    Compile_ProcessResult(opcode.result_operation, opcode.dst);
+}
+
+void MacroJITArm64Impl::Compile_Read(Macro::Opcode opcode) {
+    Compile_AddConstant(RESULT, GetRegister(opcode.src_a, ZERO_A), opcode.immediate);
+
+    // Equivalent to Engines::Maxwell3D::GetRegisterValue, out of range reads return zero
+    oaknut::Label in_range;
+    oaknut::Label done;
+    c.CMP(RESULT, static_cast<u32>(Engines::Maxwell3D::Regs::NUM_REGS));
+    c.B(oaknut::Cond::LO, in_range);
+    c.MOV(RESULT, u32{0});
+    c.B(done);
+
+    c.l(in_range);
+    c.LDR(SCRATCH0_X, STATE, offsetof(JITState, maxwell3d));
+    c.MOV(SCRATCH1_X, static_cast<u64>(REG_ARRAY_OFFSET));
+    c.ADD(SCRATCH0_X, SCRATCH0_X, SCRATCH1_X);
+    // Writes to RESULT zero the upper half of RESULT_X, so it can be used as the index
+    c.ADD(SCRATCH0_X, SCRATCH0_X, RESULT_X, LSL, 2);
+    c.LDR(RESULT, SCRATCH0_X);
+    c.l(done);
+
+    Compile_ProcessResult(opcode.result_operation, opcode.dst);
+}
+
+void MacroJITArm64Impl::Compile_Branch(u32 index, Macro::Opcode opcode) {
+    const s64 target = static_cast<s64>(index) + opcode.GetBranchTarget() / 4;
+
+    oaknut::Label not_taken;
+    const auto value = GetRegister(opcode.src_a, ZERO_A);
+    switch (opcode.branch_condition) {
+    case Macro::BranchCondition::Zero:
+        c.CBNZ(value, not_taken);
+        break;
+    case Macro::BranchCondition::NotZero:
+        c.CBZ(value, not_taken);
+        break;
+    }
+
+    // Taken branches without the annul bit execute their delay slot before jumping
+    if (!opcode.branch_annul && index + 1 < code.size()) {
+        Compile_Instruction(index + 1, true);
+    }
+    if (target >= 0 && static_cast<size_t>(target) < code.size()) {
+        c.B(labels[static_cast<size_t>(target)]);
+    } else {
+        LOG_ERROR(HW_GPU, "Macro branch target {} is out of bounds", target);
+        c.B(end_of_code);
+    }
+    c.l(not_taken);
+}
+
+void MacroJITArm64Impl::Compile_ProcessResult(Macro::ResultOperation operation, u32 reg) {
+    const auto fetch_register = reg == 0 ? SCRATCH1 : MacroRegister(reg);
+
+    switch (operation) {
+    case Macro::ResultOperation::IgnoreAndFetch:
+        Compile_FetchParameter(fetch_register);
+        break;
+    case Macro::ResultOperation::Move:
+        SetRegister(reg, RESULT);
+        break;
+    case Macro::ResultOperation::MoveAndSetMethod:
+        SetRegister(reg, RESULT);
+        c.MOV(METHOD_ADDRESS, RESULT);
+        break;
+    case Macro::ResultOperation::FetchAndSend:
+        // Fetch parameter and send result.
+        Compile_FetchParameter(fetch_register);
+        Compile_Send(RESULT);
+        break;
+    case Macro::ResultOperation::MoveAndSend:
+        // Move and send result.
+        SetRegister(reg, RESULT);
+        Compile_Send(RESULT);
+        break;
+    case Macro::ResultOperation::FetchAndSetMethod:
+        // Fetch parameter and use result as Method Address.
+        Compile_FetchParameter(fetch_register);
+        c.MOV(METHOD_ADDRESS, RESULT);
+        break;
+    case Macro::ResultOperation::MoveAndSetMethodFetchAndSend:
+        // Move result and use as Method Address, then fetch and send parameter.
+        SetRegister(reg, RESULT);
+        c.MOV(METHOD_ADDRESS, RESULT);
+        Compile_FetchParameter(SCRATCH1);
+        Compile_Send(SCRATCH1);
+        break;
+    case Macro::ResultOperation::MoveAndSetMethodSend:
+        // Move result and use as Method Address, then send bits 12:17 of result.
+        SetRegister(reg, RESULT);
+        c.MOV(METHOD_ADDRESS, RESULT);
+        c.UBFX(SCRATCH1, RESULT, 12, 6);
+        Compile_Send(SCRATCH1);
+        break;
+    default:
+        UNIMPLEMENTED_MSG("Unimplemented macro operation {}", operation);
+        break;
+    }
+}
+
+void MacroJITArm64Impl::Compile_FetchParameter(oaknut::WReg dst) {
+    oaknut::Label parameter_ok;
+    oaknut::Label done;
+    c.LDR(SCRATCH0_X, STATE, offsetof(JITState, parameters_end));
+    c.CMP(PARAMETERS, SCRATCH0_X);
+    c.B(oaknut::Cond::LO, parameter_ok);
+    c.BL(invalid_parameter);
+    c.MOV(dst, u32{0});
+    c.B(done);
+
+    c.l(parameter_ok);
+    c.LDR(dst, PARAMETERS, POST_INDEXED, sizeof(u32));
+    c.l(done);
+}
+
+void MacroJITArm64Impl::Compile_Send(oaknut::WReg value) {
+    c.MOV(W2, value);
+    c.MOV(W1, METHOD_ADDRESS);
+    c.LDR(X0, STATE, offsetof(JITState, maxwell3d));
+    Compile_CallFunction(&Send);
+
+    // Increment the method address by the method increment, keeping the increment bits
+    c.UBFX(SCRATCH0, METHOD_ADDRESS, 12, 6);
+    c.ADD(SCRATCH0, METHOD_ADDRESS, SCRATCH0);
+    c.BFI(METHOD_ADDRESS, SCRATCH0, 0, 12);
+}
+
+void MacroJITArm64Impl::Compile_AddConstant(oaknut::WReg dst, oaknut::WReg src, s32 value) {
+    if (value >= 0 && value < 4096) {
+        c.ADD(dst, src, static_cast<u32>(value));
+    } else if (value < 0 && value > -4096) {
+        c.SUB(dst, src, static_cast<u32>(-value));
+    } else {
+        c.MOV(SCRATCH0, static_cast<u32>(value));
+        c.ADD(dst, src, SCRATCH0);
+    }
+}
+
+void MacroJITArm64Impl::Compile_LoadCarry() {
+    // Sets C when the stored carry is non-zero
+    c.LDR(SCRATCH0, STATE, offsetof(JITState, carry_flag));
+    c.CMP(SCRATCH0, 1);
+}
+
+void MacroJITArm64Impl::Compile_StoreCarry() {
+    c.CSET(SCRATCH0, oaknut::Cond::CS);
+    c.STR(SCRATCH0, STATE, offsetof(JITState, carry_flag));
+}
+
+oaknut::WReg MacroJITArm64Impl::GetRegister(u32 index, oaknut::WReg zero_reg) {
+    if (index == 0) {
+        // Register 0 is always zero
+        c.MOV(zero_reg, u32{0});
+        return zero_reg;
+    }
+    return MacroRegister(index);
+}
+
+void MacroJITArm64Impl::SetRegister(u32 index, oaknut::WReg value) {
+    // Register 0 is supposed to always return 0. NOP is implemented as a store to the zero
+    // register.
+    if (index == 0) {
+        return;
+    }
+    c.MOV(MacroRegister(index), value);
+}
+} // Anonymous namespace
+
+MacroJITArm64::MacroJITArm64(Engines::Maxwell3D& maxwell3d_)
+    : MacroEngine{maxwell3d_}, maxwell3d{maxwell3d_} {}
+
+std::unique_ptr<CachedMacro> MacroJITArm64::Compile(const std::vector<u32>& code) {
+    return std::make_unique<MacroJITArm64Impl>(maxwell3d, code);
+}
+} // namespace Tegra
@@ -5,13 +5,16 @@
 #include <cstddef>
 #include <fstream>
 #include <memory>
+#include <span>
 #include <thread>
+#include <utility>
 #include <vector>
 
 #include "common/bit_cast.h"
 #include "common/cityhash.h"
 #include "common/fs/fs.h"
 #include "common/fs/path_util.h"
+#include "common/literals.h"
 #include "common/microprofile.h"
 #include "common/thread_worker.h"
 #include "core/core.h"
@@ -20,6 +23,7 @@
 #include "shader_recompiler/frontend/maxwell/control_flow.h"
 #include "shader_recompiler/frontend/maxwell/translate_program.h"
 #include "shader_recompiler/program_header.h"
+#include "shader_recompiler/scratch_arena.h"
 #include "video_core/engines/kepler_compute.h"
 #include "video_core/engines/maxwell_3d.h"
 #include "video_core/memory_manager.h"
@@ -52,10 +56,15 @@ using VideoCommon::ComputeEnvironment;
 using VideoCommon::FileEnvironment;
 using VideoCommon::GenericEnvironment;
 using VideoCommon::GraphicsEnvironment;
+using VideoCommon::PipelineCacheReader;
+using namespace Common::Literals;
 
 constexpr u32 CACHE_VERSION = 11;
 constexpr std::array<char, 8> VULKAN_CACHE_MAGIC_NUMBER{'y', 'u', 'z', 'u', 'v', 'k', 'c', 'h'};
 
+// Limit of the SPIR-V kept around for reuse by identical stages, the oldest stages are dropped
+constexpr size_t MAX_STAGE_CODE_BYTES = 64_MiB;
+
 template <typename Container>
 auto MakeSpan(Container& container) {
     return std::span(container.data(), container.size());
@@ -263,6 +272,52 @@ Shader::RuntimeInfo MakeRuntimeInfo(std::span<const Shader::IR::Program> program
     return info;
 }
 
+/// Hashes everything besides the profile that feeds SPIR-V emission of a translated stage
+u128 MakeStageCodeKey(std::span<const u128> digests, const Shader::RuntimeInfo& info,
+                      const Shader::Backend::Bindings& binding) {
+    std::vector<u64> state;
+    state.reserve(64 + info.previous_stage_legacy_stores_mapping.size() + info.xfb_count * 2);
+    for (const Shader::AttributeType type : info.generic_input_types) {
+        state.push_back(static_cast<u64>(type));
+    }
+    u64 word{};
+    for (size_t bit = 0; bit < info.previous_stage_stores.mask.size(); ++bit) {
+        word |= static_cast<u64>(info.previous_stage_stores.mask[bit]) << (bit % 64);
+        if (bit % 64 == 63) {
+            state.push_back(std::exchange(word, 0));
+        }
+    }
+    for (const auto& [from, to] : info.previous_stage_legacy_stores_mapping) {
+        state.push_back((static_cast<u64>(from) << 32) | static_cast<u64>(to));
+    }
+    state.push_back(info.convert_depth_mode);
+    state.push_back(info.force_early_z);
+    state.push_back(static_cast<u64>(info.tess_primitive));
+    state.push_back(static_cast<u64>(info.tess_spacing));
+    state.push_back(info.tess_clockwise);
+    state.push_back(static_cast<u64>(info.input_topology));
+    state.push_back(info.fixed_state_point_size.has_value());
+    state.push_back(Common::BitCast<u32>(info.fixed_state_point_size.value_or(0.0f)));
+    state.push_back(info.alpha_test_func ? static_cast<u64>(*info.alpha_test_func) + 1 : 0);
+    state.push_back(Common::BitCast<u32>(info.alpha_test_reference));
+    state.push_back(info.y_negate);
+    state.push_back(info.xfb_count);
+    for (u32 index = 0; index < info.xfb_count; ++index) {
+        const Shader::TransformFeedbackVarying& varying{info.xfb_varyings[index]};
+        state.push_back((static_cast<u64>(varying.buffer) << 32) | varying.stride);
+        state.push_back((static_cast<u64>(varying.offset) << 32) | varying.components);
+    }
+    state.push_back((static_cast<u64>(binding.unified) << 32) | binding.uniform_buffer);
+    state.push_back((static_cast<u64>(binding.storage_buffer) << 32) | binding.texture);
+    state.push_back((static_cast<u64>(binding.image) << 32) | binding.texture_scaling_index);
+    state.push_back(binding.image_scaling_index);
+
+    const u128 digest_hash{Common::CityHash128(reinterpret_cast<const char*>(digests.data()),
+                                               digests.size_bytes())};
+    return Common::CityHash128WithSeed(reinterpret_cast<const char*>(state.data()),
+                                       state.size() * sizeof(u64), digest_hash);
+}
+
 size_t GetTotalPipelineWorkers() {
     const size_t max_core_threads =
         std::max<size_t>(static_cast<size_t>(std::thread::hardware_concurrency()), 2ULL) - 1ULL;
@@ -489,9 +544,9 @@ void PipelineCache::LoadDiskResources(u64 title_id, std::stop_token stop_loading
     if (device.IsKhrPipelineExecutablePropertiesEnabled()) {
         state.statistics = std::make_unique<PipelineStatistics>(device);
     }
-    const auto load_compute{[&](std::ifstream& file, FileEnvironment env) {
+    const auto load_compute{[&](PipelineCacheReader& file, FileEnvironment env) {
         ComputePipelineCacheKey key;
-        file.read(reinterpret_cast<char*>(&key), sizeof(key));
+        file.Read(key);
 
         workers.QueueWork([this, key, env_ = std::move(env), &state, &callback]() mutable {
             ShaderPools pools;
@@ -507,9 +562,9 @@ void PipelineCache::LoadDiskResources(u64 title_id, std::stop_token stop_loading
         });
         ++state.total;
     }};
-    const auto load_graphics{[&](std::ifstream& file, std::vector<FileEnvironment> envs) {
+    const auto load_graphics{[&](PipelineCacheReader& file, std::vector<FileEnvironment> envs) {
         GraphicsPipelineCacheKey key;
-        file.read(reinterpret_cast<char*>(&key), sizeof(key));
+        file.Read(key);
 
         if ((key.state.extended_dynamic_state != 0) !=
                 dynamic_features.has_extended_dynamic_state ||
@@ -555,6 +610,15 @@ void PipelineCache::LoadDiskResources(u64 title_id, std::stop_token stop_loading
     lock.unlock();
 
     workers.WaitForRequests(stop_loading);
+    {
+        std::scoped_lock stage_code_lock{stage_code_mutex};
+        LOG_INFO(Render_Vulkan, "Reused SPIR-V for {} stages, {} unique stages emitted",
+                 stage_code_hits, stage_codes.size());
+    }
+    const Shader::ScratchArenaStats arena_stats{Shader::ScratchArena::GlobalStats()};
+    LOG_INFO(Render_Vulkan, "Recompiler scratch: {} allocations, {} KiB reserved, {} KiB peak",
+             arena_stats.allocations, arena_stats.bytes_reserved / 1024,
+             arena_stats.bytes_peak / 1024);
 
     if (use_vulkan_pipeline_cache) {
         SerializeVulkanPipelineCache(vulkan_pipeline_cache_filename, vulkan_pipeline_cache,
@@ -618,6 +682,9 @@ std::unique_ptr<GraphicsPipeline> PipelineCache::CreateGraphicsPipeline(
     // Layer passthrough generation for devices without VK_EXT_shader_viewport_index_layer
     Shader::IR::Program* layer_source_program{};
 
+    // Answers given by the environments while translating, identical digests produce identical IR
+    std::array<u128, Maxwell::MaxShaderProgram> digests{};
+
     for (size_t index = 0; index < Maxwell::MaxShaderProgram; ++index) {
         const bool is_emulated_stage = layer_source_program != nullptr &&
                                        index == static_cast<u32>(Maxwell::ShaderType::Geometry);
@@ -633,17 +700,21 @@ std::unique_ptr<GraphicsPipeline> PipelineCache::CreateGraphicsPipeline(
         Shader::Environment& env{*envs[env_index]};
         ++env_index;
 
+        VideoCommon::RecordingEnvironment recording_env{env};
         const u32 cfg_offset{static_cast<u32>(env.StartAddress() + sizeof(Shader::ProgramHeader))};
-        Shader::Maxwell::Flow::CFG cfg(env, pools.flow_block, cfg_offset, index == 0);
+        Shader::Maxwell::Flow::CFG cfg(recording_env, pools.flow_block, cfg_offset, index == 0);
         if (!uses_vertex_a || index != 1) {
             // Normal path
-            programs[index] = TranslateProgram(pools.inst, pools.block, env, cfg, host_info);
+            programs[index] =
+                TranslateProgram(pools.inst, pools.block, recording_env, cfg, host_info);
         } else {
             // VertexB path when VertexA is present.
             auto& program_va{programs[0]};
-            auto program_vb{TranslateProgram(pools.inst, pools.block, env, cfg, host_info)};
-            programs[index] = MergeDualVertexPrograms(program_va, program_vb, env);
+            auto program_vb{
+                TranslateProgram(pools.inst, pools.block, recording_env, cfg, host_info)};
+            programs[index] = MergeDualVertexPrograms(program_va, program_vb, recording_env);
         }
+        digests[index] = recording_env.Digest();
 
         if (Settings::values.dump_shaders) {
             env.Dump(hash, key.unique_hashes[index]);
@@ -673,7 +744,19 @@ std::unique_ptr<GraphicsPipeline> PipelineCache::CreateGraphicsPipeline(
 
         const auto runtime_info{MakeRuntimeInfo(programs, key, program, previous_stage)};
         ConvertLegacyToGeneric(program, runtime_info);
-        const std::vector<u32> code{EmitSPIRV(profile, runtime_info, program, binding)};
+        std::vector<u32> code;
+        if (key.unique_hashes[index] != 0) {
+            // Merged VertexB programs also depend on the VertexA translation
+            const size_t first_digest{index == 1 && uses_vertex_a ? 0 : index};
+            const std::span stage_digests{digests.data() + first_digest, index - first_digest + 1};
+            const u128 code_key{MakeStageCodeKey(stage_digests, runtime_info, binding)};
+            if (!FindStageCode(code_key, code, binding)) {
+                code = EmitSPIRV(profile, runtime_info, program, binding);
+                StoreStageCode(code_key, code, binding);
+            }
+        } else {
+            code = EmitSPIRV(profile, runtime_info, program, binding);
+        }
         device.SaveShader(code);
         modules[stage_index] = BuildShader(device, code);
         if (device.HasDebuggingToolAttached()) {
@@ -706,6 +789,35 @@ std::unique_ptr<GraphicsPipeline> PipelineCache::CreateGraphicsPipeline(
     return nullptr;
 }
 
+bool PipelineCache::FindStageCode(const u128& code_key, std::vector<u32>& code,
+                                  Shader::Backend::Bindings& binding) {
+    std::scoped_lock lock{stage_code_mutex};
+    const auto it{stage_codes.find(code_key)};
+    if (it == stage_codes.end()) {
+        return false;
+    }
+    code = it->second.code;
+    binding = it->second.binding;
+    ++stage_code_hits;
+    return true;
+}
+
+void PipelineCache::StoreStageCode(const u128& code_key, const std::vector<u32>& code,
+                                   const Shader::Backend::Bindings& binding) {
+    std::scoped_lock lock{stage_code_mutex};
+    if (!stage_codes.try_emplace(code_key, StageCode{code, binding}).second) {
+        return;
+    }
+    stage_code_order.push_back(code_key);
+    stage_code_bytes += code.size() * sizeof(u32);
+    while (stage_code_bytes > MAX_STAGE_CODE_BYTES) {
+        const auto it{stage_codes.find(stage_code_order.front())};
+        stage_code_bytes -= it->second.code.size() * sizeof(u32);
+        stage_codes.erase(it);
+        stage_code_order.pop_front();
+    }
+}
+
 std::unique_ptr<GraphicsPipeline> PipelineCache::CreateGraphicsPipeline() {
     GraphicsEnvironments environments;
     GetGraphicsEnvironments(environments, graphics_key.unique_hashes);
@@ -5,14 +5,17 @@
 
 #include <array>
 #include <cstddef>
+#include <deque>
 #include <filesystem>
 #include <memory>
+#include <mutex>
 #include <type_traits>
 #include <unordered_map>
 #include <vector>
 
 #include "common/common_types.h"
 #include "common/thread_worker.h"
+#include "shader_recompiler/backend/bindings.h"
 #include "shader_recompiler/frontend/ir/basic_block.h"
 #include "shader_recompiler/frontend/ir/value.h"
 #include "shader_recompiler/frontend/maxwell/control_flow.h"
@@ -134,6 +137,13 @@ private:
                                                            PipelineStatistics* statistics,
                                                            bool build_in_parallel);
 
+    /// Looks up SPIR-V previously emitted for an identical stage and its output bindings
+    [[nodiscard]] bool FindStageCode(const u128& code_key, std::vector<u32>& code,
+                                     Shader::Backend::Bindings& binding);
+
+    void StoreStageCode(const u128& code_key, const std::vector<u32>& code,
+                        const Shader::Backend::Bindings& binding);
+
     void SerializeVulkanPipelineCache(const std::filesystem::path& filename,
                                       const vk::PipelineCache& pipeline_cache, u32 cache_version);
 
@@ -159,6 +169,22 @@ private:
 
     ShaderPools main_pools;
 
+    struct StageCode {
+        std::vector<u32> code;
+        Shader::Backend::Bindings binding;
+    };
+    /// Stage code keys are already hashes, fold them instead of hashing them again
+    struct StageCodeKeyHash {
+        size_t operator()(const u128& key) const noexcept {
+            return static_cast<size_t>(key[0] ^ key[1]);
+        }
+    };
+    std::mutex stage_code_mutex;
+    std::unordered_map<u128, StageCode, StageCodeKeyHash> stage_codes;
+    std::deque<u128> stage_code_order; ///< Keys in insertion order, oldest evicted first
+    size_t stage_code_bytes{};
+    size_t stage_code_hits{};
+
     Shader::Profile profile;
     Shader::HostTranslateInfo host_info;
 
@@ -2,6 +2,8 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include <algorithm>
+#include <chrono>
+#include <cstring>
 #include <filesystem>
 #include <fstream>
 #include <memory>
@@ -13,6 +15,7 @@
 #include "common/common_types.h"
 #include "common/div_ceil.h"
 #include "common/fs/fs.h"
+#include "common/fs/mapped_file.h"
 #include "common/fs/path_util.h"
 #include "common/logging/log.h"
 #include "common/polyfill_ranges.h"
@@ -448,65 +451,169 @@ u32 ComputeEnvironment::ReadViewportTransformState() {
     return viewport_transform_state;
 }
 
-void FileEnvironment::Deserialize(std::ifstream& file) {
+RecordingEnvironment::RecordingEnvironment(Shader::Environment& env_) : env{env_} {
+    sph = env.SPH();
+    gp_passthrough_mask = env.GpPassthroughMask();
+    stage = env.ShaderStage();
+    start_address = env.StartAddress();
+    is_proprietary_driver = env.IsProprietaryDriver();
+}
+
+u64 RecordingEnvironment::ReadInstruction(u32 address) {
+    const u64 instruction{env.ReadInstruction(address)};
+    Record(address);
+    Record(instruction);
+    return instruction;
+}
+
+u32 RecordingEnvironment::ReadCbufValue(u32 cbuf_index, u32 cbuf_offset) {
+    const u32 value{env.ReadCbufValue(cbuf_index, cbuf_offset)};
+    Record(MakeCbufKey(cbuf_index, cbuf_offset));
+    Record(value);
+    return value;
+}
+
+Shader::TextureType RecordingEnvironment::ReadTextureType(u32 handle) {
+    const Shader::TextureType type{env.ReadTextureType(handle)};
+    Record(handle);
+    Record(static_cast<u64>(type));
+    return type;
+}
+
+Shader::TexturePixelFormat RecordingEnvironment::ReadTexturePixelFormat(u32 handle) {
+    const Shader::TexturePixelFormat format{env.ReadTexturePixelFormat(handle)};
+    Record(handle);
+    Record(static_cast<u64>(format));
+    return format;
+}
+
+bool RecordingEnvironment::IsTexturePixelFormatInteger(u32 handle) {
+    const bool is_integer{env.IsTexturePixelFormatInteger(handle)};
+    Record(handle);
+    Record(is_integer ? 1 : 0);
+    return is_integer;
+}
+
+u32 RecordingEnvironment::ReadViewportTransformState() {
+    const u32 state{env.ReadViewportTransformState()};
+    Record(state);
+    return state;
+}
+
+u32 RecordingEnvironment::LocalMemorySize() const {
+    const u32 size{env.LocalMemorySize()};
+    Record(size);
+    return size;
+}
+
+u32 RecordingEnvironment::SharedMemorySize() const {
+    const u32 size{env.SharedMemorySize()};
+    Record(size);
+    return size;
+}
+
+u32 RecordingEnvironment::TextureBoundBuffer() const {
+    const u32 bound{env.TextureBoundBuffer()};
+    Record(bound);
+    return bound;
+}
+
+std::array<u32, 3> RecordingEnvironment::WorkgroupSize() const {
+    const std::array<u32, 3> size{env.WorkgroupSize()};
+    Record((static_cast<u64>(size[0]) << 32) | size[1]);
+    Record(size[2]);
+    return size;
+}
+
+bool RecordingEnvironment::HasHLEMacroState() const {
+    const bool has_state{env.HasHLEMacroState()};
+    Record(has_state ? 1 : 0);
+    return has_state;
+}
+
+std::optional<Shader::ReplaceConstant> RecordingEnvironment::GetReplaceConstBuffer(u32 bank,
+                                                                                   u32 offset) {
+    const std::optional<Shader::ReplaceConstant> replacement{
+        env.GetReplaceConstBuffer(bank, offset)};
+    Record(MakeCbufKey(bank, offset));
+    Record(replacement ? static_cast<u64>(*replacement) + 1 : 0);
+    return replacement;
+}
+
+void RecordingEnvironment::Dump(u64 pipeline_hash, u64 shader_hash) {
+    env.Dump(pipeline_hash, shader_hash);
+}
+
+u128 RecordingEnvironment::Digest() const {
+    std::array<u32, 11> state{};
+    state[0] = static_cast<u32>(stage);
+    state[1] = start_address;
+    state[2] = is_proprietary_driver ? 1 : 0;
+    std::ranges::copy(gp_passthrough_mask, state.begin() + 3);
+
+    const u128 header_hash{
+        Common::CityHash128(reinterpret_cast<const char*>(&sph), sizeof(sph))};
+    const u128 state_hash{Common::CityHash128WithSeed(reinterpret_cast<const char*>(state.data()),
+                                                      sizeof(state), header_hash)};
+    return Common::CityHash128WithSeed(reinterpret_cast<const char*>(answers.data()),
+                                       answers.size() * sizeof(u64), state_hash);
+}
+
+void FileEnvironment::Deserialize(PipelineCacheReader& file) {
     u64 code_size{};
     u64 num_texture_types{};
     u64 num_texture_pixel_formats{};
     u64 num_cbuf_values{};
     u64 num_cbuf_replacement_values{};
-    file.read(reinterpret_cast<char*>(&code_size), sizeof(code_size))
-        .read(reinterpret_cast<char*>(&num_texture_types), sizeof(num_texture_types))
-        .read(reinterpret_cast<char*>(&num_texture_pixel_formats),
-              sizeof(num_texture_pixel_formats))
-        .read(reinterpret_cast<char*>(&num_cbuf_values), sizeof(num_cbuf_values))
-        .read(reinterpret_cast<char*>(&num_cbuf_replacement_values),
-              sizeof(num_cbuf_replacement_values))
-        .read(reinterpret_cast<char*>(&local_memory_size), sizeof(local_memory_size))
-        .read(reinterpret_cast<char*>(&texture_bound), sizeof(texture_bound))
-        .read(reinterpret_cast<char*>(&start_address), sizeof(start_address))
-        .read(reinterpret_cast<char*>(&read_lowest), sizeof(read_lowest))
-        .read(reinterpret_cast<char*>(&read_highest), sizeof(read_highest))
-        .read(reinterpret_cast<char*>(&viewport_transform_state), sizeof(viewport_transform_state))
-        .read(reinterpret_cast<char*>(&stage), sizeof(stage));
+    file.Read(code_size)
+        .Read(num_texture_types)
+        .Read(num_texture_pixel_formats)
+        .Read(num_cbuf_values)
+        .Read(num_cbuf_replacement_values)
+        .Read(local_memory_size)
+        .Read(texture_bound)
+        .Read(start_address)
+        .Read(read_lowest)
+        .Read(read_highest)
+        .Read(viewport_transform_state)
+        .Read(stage);
+    if (code_size > file.Remaining()) {
+        throw std::ios_base::failure("Invalid shader code size in pipeline cache");
+    }
     code.resize(Common::DivCeil(code_size, sizeof(u64)));
-    file.read(reinterpret_cast<char*>(code.data()), code_size);
+    file.Read(code.data(), code_size);
     for (size_t i = 0; i < num_texture_types; ++i) {
         u32 key;
         Shader::TextureType type;
-        file.read(reinterpret_cast<char*>(&key), sizeof(key))
-            .read(reinterpret_cast<char*>(&type), sizeof(type));
+        file.Read(key).Read(type);
         texture_types.emplace(key, type);
     }
     for (size_t i = 0; i < num_texture_pixel_formats; ++i) {
         u32 key;
         Shader::TexturePixelFormat format;
-        file.read(reinterpret_cast<char*>(&key), sizeof(key))
-            .read(reinterpret_cast<char*>(&format), sizeof(format));
+        file.Read(key).Read(format);
         texture_pixel_formats.emplace(key, format);
     }
     for (size_t i = 0; i < num_cbuf_values; ++i) {
         u64 key;
         u32 value;
-        file.read(reinterpret_cast<char*>(&key), sizeof(key))
-            .read(reinterpret_cast<char*>(&value), sizeof(value));
+        file.Read(key).Read(value);
         cbuf_values.emplace(key, value);
     }
     for (size_t i = 0; i < num_cbuf_replacement_values; ++i) {
         u64 key;
         Shader::ReplaceConstant value;
-        file.read(reinterpret_cast<char*>(&key), sizeof(key))
-            .read(reinterpret_cast<char*>(&value), sizeof(value));
+        file.Read(key).Read(value);
         cbuf_replacements.emplace(key, value);
     }
     if (stage == Shader::Stage::Compute) {
-        file.read(reinterpret_cast<char*>(&workgroup_size), sizeof(workgroup_size))
-            .read(reinterpret_cast<char*>(&shared_memory_size), sizeof(shared_memory_size));
+        file.Read(workgroup_size).Read(shared_memory_size);
         initial_offset = 0;
     } else {
-        file.read(reinterpret_cast<char*>(&sph), sizeof(sph));
+        file.Read(sph);
         initial_offset = sizeof(sph);
         if (stage == Shader::Stage::Geometry) {
-            file.read(reinterpret_cast<char*>(&gp_passthrough_mask), sizeof(gp_passthrough_mask));
+            file.Read(gp_passthrough_mask);
         }
     }
     is_proprietary_driver = texture_bound == 2;
@@ -614,24 +721,36 @@ void SerializePipeline(std::span<const char> key, std::span<const GenericEnviron
     }
 }
 
+PipelineCacheReader& PipelineCacheReader::Read(void* dest, size_t size) {
+    if (size > Remaining()) {
+        throw std::ios_base::failure("Unexpected end of pipeline cache file");
+    }
+    std::memcpy(dest, data.data() + position, size);
+    position += size;
+    return *this;
+}
+
 void LoadPipelines(
     std::stop_token stop_loading, const std::filesystem::path& filename, u32 expected_cache_version,
-    Common::UniqueFunction<void, std::ifstream&, FileEnvironment> load_compute,
-    Common::UniqueFunction<void, std::ifstream&, std::vector<FileEnvironment>> load_graphics) try {
-    std::ifstream file(filename, std::ios::binary | std::ios::ate);
-    if (!file.is_open()) {
+    Common::UniqueFunction<void, PipelineCacheReader&, FileEnvironment> load_compute,
+    Common::UniqueFunction<void, PipelineCacheReader&, std::vector<FileEnvironment>>
+        load_graphics) try {
+    // Map the whole cache instead of streaming it, entries are handed to the build workers as soon
+    // as they are decoded so parsing is no longer bound by small stream reads.
+    Common::FS::MappedFile mapped_file(filename);
+    if (!mapped_file.IsOpen()) {
         return;
     }
-    file.exceptions(std::ifstream::failbit);
-    const auto end{file.tellg()};
-    file.seekg(0, std::ios::beg);
+    const auto start_time{std::chrono::steady_clock::now()};
+    PipelineCacheReader file{mapped_file.Data()};
 
-    std::array<char, 8> magic_number;
-    u32 cache_version;
-    file.read(magic_number.data(), magic_number.size())
-        .read(reinterpret_cast<char*>(&cache_version), sizeof(cache_version));
+    std::array<char, 8> magic_number{};
+    u32 cache_version{};
+    if (file.Remaining() >= magic_number.size() + sizeof(cache_version)) {
+        file.Read(magic_number).Read(cache_version);
+    }
     if (magic_number != MAGIC_NUMBER || cache_version != expected_cache_version) {
-        file.close();
+        mapped_file.Close();
         if (Common::FS::RemoveFile(filename)) {
             if (magic_number != MAGIC_NUMBER) {
                 LOG_ERROR(Common_Filesystem, "Invalid pipeline cache file");
@@ -646,12 +765,16 @@ void LoadPipelines(
         }
         return;
     }
-    while (file.tellg() != end) {
+    size_t num_entries{};
+    while (!file.AtEnd()) {
         if (stop_loading.stop_requested()) {
             return;
         }
         u32 num_envs{};
-        file.read(reinterpret_cast<char*>(&num_envs), sizeof(num_envs));
+        file.Read(num_envs);
+        if (num_envs == 0 || num_envs > Maxwell::MaxShaderProgram) {
+            throw std::ios_base::failure("Invalid environment count in pipeline cache");
+        }
         std::vector<FileEnvironment> envs(num_envs);
         for (FileEnvironment& env : envs) {
             env.Deserialize(file);
@@ -661,8 +784,18 @@ void LoadPipelines(
         } else {
             load_graphics(file, std::move(envs));
         }
+        ++num_entries;
     }
 
+    const std::chrono::duration<double> elapsed{std::chrono::steady_clock::now() - start_time};
+    const double seconds = std::max(elapsed.count(), 1e-6);
+    const double megabytes = static_cast<double>(file.Position()) / (1024.0 * 1024.0);
+    LOG_INFO(Common_Filesystem,
+             "Loaded {} pipeline cache entries ({:.2f} MiB) in {:.3f}s: {:.0f} entries/s, "
+             "{:.2f} MiB/s",
+             num_entries, megabytes, seconds, static_cast<double>(num_entries) / seconds,
+             megabytes / seconds);
+
 } catch (const std::ios_base::failure& e) {
     LOG_ERROR(Common_Filesystem, "{}", e.what());
     if (!Common::FS::RemoveFile(filename)) {
@@ -154,6 +154,87 @@ private:
     Tegra::Engines::KeplerCompute* kepler_compute{};
 };
 
+/**
+ * Forwards every query to another environment and keeps a digest of the answers.
+ * Two translations that observe the same digest produce identical IR, which lets the backends
+ * reuse code emitted for a previous pipeline sharing the same stage.
+ */
+class RecordingEnvironment final : public Shader::Environment {
+public:
+    explicit RecordingEnvironment(Shader::Environment& env_);
+
+    ~RecordingEnvironment() override = default;
+
+    [[nodiscard]] u64 ReadInstruction(u32 address) override;
+
+    [[nodiscard]] u32 ReadCbufValue(u32 cbuf_index, u32 cbuf_offset) override;
+
+    [[nodiscard]] Shader::TextureType ReadTextureType(u32 handle) override;
+
+    [[nodiscard]] Shader::TexturePixelFormat ReadTexturePixelFormat(u32 handle) override;
+
+    [[nodiscard]] bool IsTexturePixelFormatInteger(u32 handle) override;
+
+    [[nodiscard]] u32 ReadViewportTransformState() override;
+
+    [[nodiscard]] u32 LocalMemorySize() const override;
+
+    [[nodiscard]] u32 SharedMemorySize() const override;
+
+    [[nodiscard]] u32 TextureBoundBuffer() const override;
+
+    [[nodiscard]] std::array<u32, 3> WorkgroupSize() const override;
+
+    [[nodiscard]] bool HasHLEMacroState() const override;
+
+    [[nodiscard]] std::optional<Shader::ReplaceConstant> GetReplaceConstBuffer(u32 bank,
+                                                                               u32 offset) override;
+
+    void Dump(u64 pipeline_hash, u64 shader_hash) override;
+
+    /// Returns a hash of the stage, the program header and every answer given so far
+    [[nodiscard]] u128 Digest() const;
+
+private:
+    void Record(u64 value) const {
+        answers.push_back(value);
+    }
+
+    Shader::Environment& env;
+    mutable std::vector<u64> answers;
+};
+
+/// Sequential reader over the contents of a memory mapped pipeline cache file
+class PipelineCacheReader {
+public:
+    explicit PipelineCacheReader(std::span<const u8> data_) : data{data_} {}
+
+    /// Copies the next size bytes into dest, throws std::ios_base::failure past the end of file
+    PipelineCacheReader& Read(void* dest, size_t size);
+
+    template <typename T>
+    PipelineCacheReader& Read(T& object) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        return Read(&object, sizeof(object));
+    }
+
+    [[nodiscard]] size_t Position() const noexcept {
+        return position;
+    }
+
+    [[nodiscard]] size_t Remaining() const noexcept {
+        return data.size() - position;
+    }
+
+    [[nodiscard]] bool AtEnd() const noexcept {
+        return position == data.size();
+    }
+
+private:
+    std::span<const u8> data;
+    size_t position{};
+};
+
 class FileEnvironment final : public Shader::Environment {
 public:
     FileEnvironment() = default;
@@ -165,7 +246,7 @@ public:
     FileEnvironment& operator=(const FileEnvironment&) = delete;
     FileEnvironment(const FileEnvironment&) = delete;
 
-    void Deserialize(std::ifstream& file);
+    void Deserialize(PipelineCacheReader& file);
 
     [[nodiscard]] u64 ReadInstruction(u32 address) override;
 
@@ -226,7 +307,7 @@ void SerializePipeline(const Key& key, const Envs& envs, const std::filesystem::
 
 void LoadPipelines(
     std::stop_token stop_loading, const std::filesystem::path& filename, u32 expected_cache_version,
-    Common::UniqueFunction<void, std::ifstream&, FileEnvironment> load_compute,
-    Common::UniqueFunction<void, std::ifstream&, std::vector<FileEnvironment>> load_graphics);
+    Common::UniqueFunction<void, PipelineCacheReader&, FileEnvironment> load_compute,
+    Common::UniqueFunction<void, PipelineCacheReader&, std::vector<FileEnvironment>> load_graphics);
 
 } // namespace VideoCommon
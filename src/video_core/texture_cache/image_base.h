@@ -136,7 +136,6 @@ struct ImageMapView {
     VAddr cpu_addr;
     size_t size;
     ImageId image_id;
-    bool picked{};
 };
 
 struct ImageAllocBase {
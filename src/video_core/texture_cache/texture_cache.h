@@ -732,23 +732,18 @@ template <class P>
 std::pair<typename P::ImageView*, bool> TextureCache<P>::TryFindFramebufferImageView(
     const Tegra::FramebufferConfig& config, DAddr cpu_addr) {
     // TODO: Properly implement this
-    const auto it = page_table.find(cpu_addr >> YUZU_PAGEBITS);
-    if (it == page_table.end()) {
-        return {};
-    }
-    const auto& image_map_ids = it->second;
     boost::container::small_vector<ImageId, 4> valid_image_ids;
-    for (const ImageMapId map_id : image_map_ids) {
+    page_table.ForEachOverlapping(cpu_addr, cpu_addr + 1, [&](ImageMapId map_id) {
         const ImageMapView& map = slot_map_views[map_id];
         const ImageBase& image = slot_images[map.image_id];
         if (image.cpu_addr != cpu_addr) {
-            continue;
+            return;
         }
         if (image.image_view_ids.empty()) {
-            continue;
+            return;
         }
         valid_image_ids.push_back(map.image_id);
-    }
+    });
 
     const auto view_format = [&]() {
         switch (config.pixel_format) {
@@ -1090,7 +1085,7 @@ void TextureCache<P>::UploadImageContents(Image& image, StagingBuffer& staging)
         unswizzle_data_buffer.resize_destructive(image.unswizzled_size_bytes);
         auto copies =
             UnswizzleImage(*gpu_memory, gpu_addr, image.info, swizzle_data, unswizzle_data_buffer);
-        ConvertImage(unswizzle_data_buffer, image.info, mapped_span, copies);
+        transcode_cache.ConvertImage(unswizzle_data_buffer, image.info, mapped_span, copies);
         image.UploadMemory(staging, copies);
     } else {
         const auto copies =
@@ -1158,12 +1153,12 @@ ImageId TextureCache<P>::FindImage(const ImageInfo& info, GPUVAddr gpu_addr,
     const bool broken_views =
         runtime.HasBrokenTextureViewFormats() || True(options & RelaxedOptions::ForceBrokenViews);
     const bool native_bgr = runtime.HasNativeBgr();
-    const bool flexible_formats = True(options & RelaxedOptions::Format);
     ImageId image_id{};
     boost::container::small_vector<ImageId, 8> image_ids;
+    // Every candidate is collected, the most recently modified one is picked below
     const auto lambda = [&](ImageId existing_image_id, ImageBase& existing_image) {
         if (True(existing_image.flags & ImageFlagBits::Remapped)) {
-            return false;
+            return;
         }
         if (info.type == ImageType::Linear || existing_image.info.type == ImageType::Linear)
             [[unlikely]] {
@@ -1176,15 +1171,12 @@ ImageId TextureCache<P>::FindImage(const ImageInfo& info, GPUVAddr gpu_addr,
                 IsViewCompatible(existing.format, info.format, broken_views, native_bgr)) {
                 image_id = existing_image_id;
                 image_ids.push_back(existing_image_id);
-                return !flexible_formats && existing.format == info.format;
             }
         } else if (IsSubresource(info, existing_image, gpu_addr, options, broken_views,
                                  native_bgr)) {
             image_id = existing_image_id;
             image_ids.push_back(existing_image_id);
-            return !flexible_formats && existing_image.info.format == info.format;
         }
-        return false;
     };
     ForEachImageInRegion(*cpu_addr, CalculateGuestSizeInBytes(info), lambda);
     if (image_ids.size() <= 1) [[likely]] {
@@ -1296,12 +1288,12 @@ void TextureCache<P>::QueueAsyncDecode(Image& image, ImageId image_id) {
                                  local_unswizzle_data_buffer);
     const size_t out_size = MapSizeBytes(image);
 
-    auto func = [out_size, copies, info = image.info,
+    auto func = [this, out_size, copies, info = image.info,
                  input = std::move(local_unswizzle_data_buffer),
                  async_decode = decode_ptr]() mutable {
         async_decode->decoded_data.resize_destructive(out_size);
         std::span copies_span{copies.data(), copies.size()};
-        ConvertImage(input, info, async_decode->decoded_data, copies_span);
+        transcode_cache.ConvertImage(input, info, async_decode->decoded_data, copies_span);
 
         // TODO: Do we need this lock?
         std::unique_lock lock{async_decode->mutex};
@@ -1685,9 +1677,10 @@ ImageId TextureCache<P>::FindDMAImage(const ImageInfo& info, GPUVAddr gpu_addr)
     }
     ImageId image_id{};
     boost::container::small_vector<ImageId, 8> image_ids;
+    // Every candidate is collected, the most recently modified one is picked below
     const auto lambda = [&](ImageId existing_image_id, ImageBase& existing_image) {
         if (True(existing_image.flags & ImageFlagBits::Remapped)) {
-            return false;
+            return;
         }
         if (info.type == ImageType::Linear || existing_image.info.type == ImageType::Linear)
             [[unlikely]] {
@@ -1699,14 +1692,11 @@ ImageId TextureCache<P>::FindDMAImage(const ImageInfo& info, GPUVAddr gpu_addr)
                 IsViewCompatible(existing.format, info.format, false, true)) {
                 image_id = existing_image_id;
                 image_ids.push_back(existing_image_id);
-                return true;
             }
         } else if (IsSubCopy(info, existing_image, gpu_addr)) {
             image_id = existing_image_id;
             image_ids.push_back(existing_image_id);
-            return true;
         }
-        return false;
     };
     ForEachImageInRegion(*cpu_addr, CalculateGuestSizeInBytes(info), lambda);
     if (image_ids.size() <= 1) [[likely]] {
@@ -1810,148 +1800,54 @@ void TextureCache<P>::ForEachImageInRegion(DAddr cpu_addr, size_t size, Func&& f
     using FuncReturn = typename std::invoke_result<Func, ImageId, Image&>::type;
     static constexpr bool BOOL_BREAK = std::is_same_v<FuncReturn, bool>;
     boost::container::small_vector<ImageId, 32> images;
-    boost::container::small_vector<ImageMapId, 32> maps;
-    ForEachCPUPage(cpu_addr, size, [this, &images, &maps, cpu_addr, size, func](u64 page) {
-        const auto it = page_table.find(page);
-        if (it == page_table.end()) {
+    const auto visit = [this, &images, &func](ImageMapId map_id) {
+        const ImageId image_id = slot_map_views[map_id].image_id;
+        Image& image = slot_images[image_id];
+        // Sparse images may be found through more than one of their map views
+        if (True(image.flags & ImageFlagBits::Picked)) {
             if constexpr (BOOL_BREAK) {
                 return false;
             } else {
                 return;
             }
         }
-        for (const ImageMapId map_id : it->second) {
-            ImageMapView& map = slot_map_views[map_id];
-            if (map.picked) {
-                continue;
-            }
-            if (!map.Overlaps(cpu_addr, size)) {
-                continue;
-            }
-            map.picked = true;
-            maps.push_back(map_id);
-            Image& image = slot_images[map.image_id];
-            if (True(image.flags & ImageFlagBits::Picked)) {
-                continue;
-            }
-            image.flags |= ImageFlagBits::Picked;
-            images.push_back(map.image_id);
-            if constexpr (BOOL_BREAK) {
-                if (func(map.image_id, image)) {
-                    return true;
-                }
-            } else {
-                func(map.image_id, image);
-            }
-        }
-        if constexpr (BOOL_BREAK) {
-            return false;
-        }
-    });
+        image.flags |= ImageFlagBits::Picked;
+        images.push_back(image_id);
+        return func(image_id, image);
+    };
+    page_table.ForEachOverlapping(cpu_addr, cpu_addr + size, visit);
     for (const ImageId image_id : images) {
         slot_images[image_id].flags &= ~ImageFlagBits::Picked;
     }
-    for (const ImageMapId map_id : maps) {
-        slot_map_views[map_id].picked = false;
-    }
 }
 
 template <class P>
 template <typename Func>
 void TextureCache<P>::ForEachImageInRegionGPU(size_t as_id, GPUVAddr gpu_addr, size_t size,
                                               Func&& func) {
-    using FuncReturn = typename std::invoke_result<Func, ImageId, Image&>::type;
-    static constexpr bool BOOL_BREAK = std::is_same_v<FuncReturn, bool>;
-    boost::container::small_vector<ImageId, 8> images;
     auto storage_id = getStorageID(as_id);
     if (!storage_id) {
         return;
     }
     auto& gpu_page_table = gpu_page_table_storage[*storage_id * 2];
-    ForEachGPUPage(gpu_addr, size,
-                   [this, &gpu_page_table, &images, gpu_addr, size, func](u64 page) {
-                       const auto it = gpu_page_table.find(page);
-                       if (it == gpu_page_table.end()) {
-                           if constexpr (BOOL_BREAK) {
-                               return false;
-                           } else {
-                               return;
-                           }
-                       }
-                       for (const ImageId image_id : it->second) {
-                           Image& image = slot_images[image_id];
-                           if (True(image.flags & ImageFlagBits::Picked)) {
-                               continue;
-                           }
-                           if (!image.OverlapsGPU(gpu_addr, size)) {
-                               continue;
-                           }
-                           image.flags |= ImageFlagBits::Picked;
-                           images.push_back(image_id);
-                           if constexpr (BOOL_BREAK) {
-                               if (func(image_id, image)) {
-                                   return true;
-                               }
-                           } else {
-                               func(image_id, image);
-                           }
-                       }
-                       if constexpr (BOOL_BREAK) {
-                           return false;
-                       }
-                   });
-    for (const ImageId image_id : images) {
-        slot_images[image_id].flags &= ~ImageFlagBits::Picked;
-    }
+    gpu_page_table.ForEachOverlapping(gpu_addr, gpu_addr + size, [this, &func](ImageId image_id) {
+        return func(image_id, slot_images[image_id]);
+    });
 }
 
 template <class P>
 template <typename Func>
 void TextureCache<P>::ForEachSparseImageInRegion(size_t as_id, GPUVAddr gpu_addr, size_t size,
                                                  Func&& func) {
-    using FuncReturn = typename std::invoke_result<Func, ImageId, Image&>::type;
-    static constexpr bool BOOL_BREAK = std::is_same_v<FuncReturn, bool>;
-    boost::container::small_vector<ImageId, 8> images;
     auto storage_id = getStorageID(as_id);
     if (!storage_id) {
         return;
     }
     auto& sparse_page_table = gpu_page_table_storage[*storage_id * 2 + 1];
-    ForEachGPUPage(gpu_addr, size,
-                   [this, &sparse_page_table, &images, gpu_addr, size, func](u64 page) {
-                       const auto it = sparse_page_table.find(page);
-                       if (it == sparse_page_table.end()) {
-                           if constexpr (BOOL_BREAK) {
-                               return false;
-                           } else {
-                               return;
-                           }
-                       }
-                       for (const ImageId image_id : it->second) {
-                           Image& image = slot_images[image_id];
-                           if (True(image.flags & ImageFlagBits::Picked)) {
-                               continue;
-                           }
-                           if (!image.OverlapsGPU(gpu_addr, size)) {
-                               continue;
-                           }
-                           image.flags |= ImageFlagBits::Picked;
-                           images.push_back(image_id);
-                           if constexpr (BOOL_BREAK) {
-                               if (func(image_id, image)) {
-                                   return true;
-                               }
-                           } else {
-                               func(image_id, image);
-                           }
-                       }
-                       if constexpr (BOOL_BREAK) {
-                           return false;
-                       }
-                   });
-    for (const ImageId image_id : images) {
-        slot_images[image_id].flags &= ~ImageFlagBits::Picked;
-    }
+    sparse_page_table.ForEachOverlapping(gpu_addr, gpu_addr + size,
+                                         [this, &func](ImageId image_id) {
+                                             return func(image_id, slot_images[image_id]);
+                                         });
 }
 
 template <class P>
@@ -2000,14 +1896,12 @@ void TextureCache<P>::RegisterImage(ImageId image_id) {
     total_used_memory += Common::AlignUp(tentative_size, 1024);
     image.lru_index = lru_cache.Insert(image_id, frame_tick);
 
-    ForEachGPUPage(image.gpu_addr, image.guest_size_bytes, [this, image_id](u64 page) {
-        (*channel_state->gpu_page_table)[page].push_back(image_id);
-    });
+    channel_state->gpu_page_table->Insert(image.gpu_addr, image.gpu_addr + image.guest_size_bytes,
+                                          image_id);
     if (False(image.flags & ImageFlagBits::Sparse)) {
         auto map_id =
             slot_map_views.insert(image.gpu_addr, image.cpu_addr, image.guest_size_bytes, image_id);
-        ForEachCPUPage(image.cpu_addr, image.guest_size_bytes,
-                       [this, map_id](u64 page) { page_table[page].push_back(map_id); });
+        page_table.Insert(image.cpu_addr, image.cpu_addr + image.guest_size_bytes, map_id);
         image.map_view_id = map_id;
         return;
     }
@@ -2015,14 +1909,12 @@ void TextureCache<P>::RegisterImage(ImageId image_id) {
     ForEachSparseSegment(
         image, [this, image_id, &sparse_maps](GPUVAddr gpu_addr, DAddr cpu_addr, size_t size) {
             auto map_id = slot_map_views.insert(gpu_addr, cpu_addr, size, image_id);
-            ForEachCPUPage(cpu_addr, size,
-                           [this, map_id](u64 page) { page_table[page].push_back(map_id); });
+            page_table.Insert(cpu_addr, cpu_addr + size, map_id);
             sparse_maps.push_back(map_id);
         });
     sparse_views.emplace(image_id, std::move(sparse_maps));
-    ForEachGPUPage(image.gpu_addr, image.guest_size_bytes, [this, image_id](u64 page) {
-        (*channel_state->sparse_page_table)[page].push_back(image_id);
-    });
+    channel_state->sparse_page_table->Insert(
+        image.gpu_addr, image.gpu_addr + image.guest_size_bytes, image_id);
 }
 
 template <class P>
@@ -2033,77 +1925,31 @@ void TextureCache<P>::UnregisterImage(ImageId image_id) {
     image.flags &= ~ImageFlagBits::Registered;
     image.flags &= ~ImageFlagBits::BadOverlap;
     lru_cache.Free(image.lru_index);
-    const auto& clear_page_table =
-        [image_id](u64 page,
-                   std::unordered_map<u64, std::vector<ImageId>, Common::IdentityHash<u64>>&
-                       selected_page_table) {
-            const auto page_it = selected_page_table.find(page);
-            if (page_it == selected_page_table.end()) {
-                ASSERT_MSG(false, "Unregistering unregistered page=0x{:x}", page << YUZU_PAGEBITS);
-                return;
-            }
-            std::vector<ImageId>& image_ids = page_it->second;
-            const auto vector_it = std::ranges::find(image_ids, image_id);
-            if (vector_it == image_ids.end()) {
-                ASSERT_MSG(false, "Unregistering unregistered image in page=0x{:x}",
-                           page << YUZU_PAGEBITS);
-                return;
-            }
-            image_ids.erase(vector_it);
-        };
-    ForEachGPUPage(image.gpu_addr, image.guest_size_bytes, [this, &clear_page_table](u64 page) {
-        clear_page_table(page, (*channel_state->gpu_page_table));
-    });
+    if (!channel_state->gpu_page_table->Erase(image.gpu_addr, image_id)) {
+        ASSERT_MSG(false, "Unregistering unregistered image at gpu_addr=0x{:x}", image.gpu_addr);
+    }
     if (False(image.flags & ImageFlagBits::Sparse)) {
         const auto map_id = image.map_view_id;
-        ForEachCPUPage(image.cpu_addr, image.guest_size_bytes, [this, map_id](u64 page) {
-            const auto page_it = page_table.find(page);
-            if (page_it == page_table.end()) {
-                ASSERT_MSG(false, "Unregistering unregistered page=0x{:x}", page << YUZU_PAGEBITS);
-                return;
-            }
-            std::vector<ImageMapId>& image_map_ids = page_it->second;
-            const auto vector_it = std::ranges::find(image_map_ids, map_id);
-            if (vector_it == image_map_ids.end()) {
-                ASSERT_MSG(false, "Unregistering unregistered image in page=0x{:x}",
-                           page << YUZU_PAGEBITS);
-                return;
-            }
-            image_map_ids.erase(vector_it);
-        });
+        if (!page_table.Erase(image.cpu_addr, map_id)) {
+            ASSERT_MSG(false, "Unregistering unregistered image at cpu_addr=0x{:x}",
+                       image.cpu_addr);
+        }
         slot_map_views.erase(map_id);
         return;
     }
-    ForEachGPUPage(image.gpu_addr, image.guest_size_bytes, [this, &clear_page_table](u64 page) {
-        clear_page_table(page, (*channel_state->sparse_page_table));
-    });
+    if (!channel_state->sparse_page_table->Erase(image.gpu_addr, image_id)) {
+        ASSERT_MSG(false, "Unregistering unregistered sparse image at gpu_addr=0x{:x}",
+                   image.gpu_addr);
+    }
     auto it = sparse_views.find(image_id);
     ASSERT(it != sparse_views.end());
     auto& sparse_maps = it->second;
     for (auto& map_view_id : sparse_maps) {
-        const auto& map_range = slot_map_views[map_view_id];
-        const DAddr cpu_addr = map_range.cpu_addr;
-        const std::size_t size = map_range.size;
-        ForEachCPUPage(cpu_addr, size, [this, image_id](u64 page) {
-            const auto page_it = page_table.find(page);
-            if (page_it == page_table.end()) {
-                ASSERT_MSG(false, "Unregistering unregistered page=0x{:x}", page << YUZU_PAGEBITS);
-                return;
-            }
-            std::vector<ImageMapId>& image_map_ids = page_it->second;
-            auto vector_it = image_map_ids.begin();
-            while (vector_it != image_map_ids.end()) {
-                ImageMapView& map = slot_map_views[*vector_it];
-                if (map.image_id != image_id) {
-                    vector_it++;
-                    continue;
-                }
-                if (!map.picked) {
-                    map.picked = true;
-                }
-                vector_it = image_map_ids.erase(vector_it);
-            }
-        });
+        const DAddr cpu_addr = slot_map_views[map_view_id].cpu_addr;
+        if (!page_table.Erase(cpu_addr, map_view_id)) {
+            ASSERT_MSG(false, "Unregistering unregistered sparse map at cpu_addr=0x{:x}",
+                       cpu_addr);
+        }
         slot_map_views.erase(map_view_id);
     }
     sparse_views.erase(it);
@@ -17,6 +17,7 @@
 
 #include "common/common_types.h"
 #include "common/hash.h"
+#include "common/interval_tree.h"
 #include "common/literals.h"
 #include "common/lru_cache.h"
 #include "common/polyfill_ranges.h"
@@ -33,6 +34,7 @@
 #include "video_core/texture_cache/image_info.h"
 #include "video_core/texture_cache/image_view_base.h"
 #include "video_core/texture_cache/render_targets.h"
+#include "video_core/texture_cache/transcode_cache.h"
 #include "video_core/texture_cache/types.h"
 #include "video_core/textures/texture.h"
 
@@ -63,7 +65,8 @@ struct AsyncDecodeContext {
     std::atomic_bool complete;
 };
 
-using TextureCacheGPUMap = std::unordered_map<u64, std::vector<ImageId>, Common::IdentityHash<u64>>;
+/// Images of a GPU address space, indexed by their GPU address range
+using TextureCacheGPUMap = Common::IntervalTree<GPUVAddr, ImageId>;
 
 class TextureCacheChannelInfo : public ChannelInfo {
 public:
@@ -91,9 +94,6 @@ public:
 
 template <class P>
 class TextureCache : public VideoCommon::ChannelSetupCaches<TextureCacheChannelInfo> {
-    /// Address shift for caching images into a hash table
-    static constexpr u64 YUZU_PAGEBITS = 20;
-
     /// Enables debugging features to the texture cache
     static constexpr bool ENABLE_VALIDATION = P::ENABLE_VALIDATION;
     /// Implement blits as copies between framebuffers
@@ -253,37 +253,6 @@ public:
     std::recursive_mutex mutex;
 
 private:
-    /// Iterate over all page indices in a range
-    template <typename Func>
-    static void ForEachCPUPage(DAddr addr, size_t size, Func&& func) {
-        static constexpr bool RETURNS_BOOL = std::is_same_v<std::invoke_result<Func, u64>, bool>;
-        const u64 page_end = (addr + size - 1) >> YUZU_PAGEBITS;
-        for (u64 page = addr >> YUZU_PAGEBITS; page <= page_end; ++page) {
-            if constexpr (RETURNS_BOOL) {
-                if (func(page)) {
-                    break;
-                }
-            } else {
-                func(page);
-            }
-        }
-    }
-
-    template <typename Func>
-    static void ForEachGPUPage(GPUVAddr addr, size_t size, Func&& func) {
-        static constexpr bool RETURNS_BOOL = std::is_same_v<std::invoke_result<Func, u64>, bool>;
-        const u64 page_end = (addr + size - 1) >> YUZU_PAGEBITS;
-        for (u64 page = addr >> YUZU_PAGEBITS; page <= page_end; ++page) {
-            if constexpr (RETURNS_BOOL) {
-                if (func(page)) {
-                    break;
-                }
-            } else {
-                func(page);
-            }
-        }
-    }
-
     void OnGPUASRegister(size_t map_id) final override;
 
     /// Runs the Garbage Collector.
@@ -431,7 +400,8 @@ private:
 
     std::unordered_map<RenderTargets, FramebufferId> framebuffers;
 
-    std::unordered_map<u64, std::vector<ImageMapId>, Common::IdentityHash<u64>> page_table;
+    /// Map views of the registered images, indexed by their CPU address range
+    Common::IntervalTree<DAddr, ImageMapId> page_table;
     std::unordered_map<ImageId, boost::container::small_vector<ImageViewId, 16>> sparse_views;
 
     DAddr virtual_invalid_space{};
@@ -489,6 +459,7 @@ private:
     u64 modification_tick = 0;
     u64 frame_tick = 0;
 
+    TranscodeCache transcode_cache;
     Common::ThreadWorker texture_decode_worker{1, "TextureDecoder"};
     std::vector<std::unique_ptr<AsyncDecodeContext>> async_decodes;
 
@@ -0,0 +1,256 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "common/cityhash.h"
+#include "common/fs/file.h"
+#include "common/fs/fs.h"
+#include "common/fs/mapped_file.h"
+#include "common/fs/path_util.h"
+#include "common/literals.h"
+#include "common/logging/log.h"
+#include "common/settings.h"
+#include "common/zstd_compression.h"
+#include "video_core/texture_cache/transcode_cache.h"
+#include "video_core/texture_cache/util.h"
+
+namespace VideoCommon {
+
+namespace {
+
+using namespace Common::Literals;
+
+constexpr u32 ENTRY_MAGIC = 0x43535459; // "YTSC"
+constexpr u32 ENTRY_VERSION = 1;
+
+// Small conversions are cheaper to redo than to look up on disk
+constexpr size_t MIN_CACHED_INPUT_SIZE = 64_KiB;
+
+// Size limit of the cache directory, eviction trims it down to the low watermark so it doesn't
+// have to run again right after the next store
+constexpr u64 MAX_DISK_USAGE = 2_GiB;
+constexpr u64 EVICTION_TARGET_USAGE = MAX_DISK_USAGE * 3 / 4;
+
+struct EntryHeader {
+    u32 magic;
+    u32 version;
+    u64 output_size;
+    u32 num_copies;
+    u32 reserved;
+};
+static_assert(std::is_trivially_copyable_v<EntryHeader>);
+static_assert(std::is_trivially_copyable_v<BufferImageCopy>);
+
+/// Parameters besides the guest data that change the result of a conversion
+struct EntryKey {
+    u32 format;
+    u32 type;
+    Extent3D size;
+    SubresourceExtent resources;
+    u32 astc_recompression;
+    u32 num_copies;
+};
+static_assert(std::is_trivially_copyable_v<EntryKey>);
+
+u128 HashEntry(std::span<const u8> input, const ImageInfo& info,
+               std::span<const BufferImageCopy> copies) {
+    EntryKey key{};
+    key.format = static_cast<u32>(info.format);
+    key.type = static_cast<u32>(info.type);
+    key.size = info.size;
+    key.resources = info.resources;
+    key.astc_recompression = static_cast<u32>(Settings::values.astc_recompression.GetValue());
+    key.num_copies = static_cast<u32>(copies.size());
+
+    const u128 data_hash =
+        Common::CityHash128(reinterpret_cast<const char*>(input.data()), input.size());
+    const u128 key_hash =
+        Common::CityHash128WithSeed(reinterpret_cast<const char*>(&key), sizeof(key), data_hash);
+    return Common::CityHash128WithSeed(reinterpret_cast<const char*>(copies.data()),
+                                       copies.size_bytes(), key_hash);
+}
+
+} // Anonymous namespace
+
+TranscodeCache::TranscodeCache() {
+    if (!Settings::values.use_disk_texture_cache.GetValue()) {
+        return;
+    }
+    cache_dir = Common::FS::GetYuzuPath(Common::FS::YuzuPath::ShaderDir) / "transcoded";
+    if (!Common::FS::CreateDirs(cache_dir)) {
+        LOG_ERROR(Render, "Failed to create transcoded texture cache directory");
+        cache_dir.clear();
+        return;
+    }
+    writer.emplace(1, "TranscodeCacheWriter");
+    writer->QueueWork([this] { Evict(); });
+}
+
+TranscodeCache::~TranscodeCache() {
+    if (!writer) {
+        return;
+    }
+    writer->WaitForRequests();
+
+    const TranscodeCacheStats stats = GetStats();
+    LOG_INFO(Render,
+             "Transcoded texture cache: {} hits, {} misses, {} KiB loaded, {} KiB stored",
+             stats.hits, stats.misses, stats.bytes_loaded / 1_KiB, stats.bytes_stored / 1_KiB);
+}
+
+void TranscodeCache::ConvertImage(std::span<const u8> input, const ImageInfo& info,
+                                  std::span<u8> output, std::span<BufferImageCopy> copies) {
+    if (!writer || input.size() < MIN_CACHED_INPUT_SIZE) {
+        VideoCommon::ConvertImage(input, info, output, copies);
+        return;
+    }
+    const u128 hash = HashEntry(input, info, copies);
+    const auto path = cache_dir / fmt::format("{:016x}{:016x}", hash[1], hash[0]);
+    if (Load(path, output, copies)) {
+        ++hits;
+        return;
+    }
+    ++misses;
+    VideoCommon::ConvertImage(input, info, output, copies);
+    Store(path, output, copies);
+}
+
+TranscodeCacheStats TranscodeCache::GetStats() const noexcept {
+    return {
+        .hits = hits.load(std::memory_order_relaxed),
+        .misses = misses.load(std::memory_order_relaxed),
+        .bytes_loaded = bytes_loaded.load(std::memory_order_relaxed),
+        .bytes_stored = bytes_stored.load(std::memory_order_relaxed),
+    };
+}
+
+bool TranscodeCache::Load(const std::filesystem::path& path, std::span<u8> output,
+                          std::span<BufferImageCopy> copies) {
+    const Common::FS::MappedFile file{path};
+    const std::span<const u8> data = file.Data();
+    const size_t copies_size = copies.size_bytes();
+    if (data.size() < sizeof(EntryHeader) + copies_size) {
+        return false;
+    }
+    EntryHeader header;
+    std::memcpy(&header, data.data(), sizeof(header));
+    if (header.magic != ENTRY_MAGIC || header.version != ENTRY_VERSION ||
+        header.output_size != output.size() || header.num_copies != copies.size()) {
+        return false;
+    }
+    const std::span<const u8> payload = data.subspan(sizeof(EntryHeader) + copies_size);
+    if (Common::Compression::DecompressDataZSTD(payload, output) != output.size()) {
+        LOG_WARNING(Render, "Discarding corrupted transcoded texture cache entry");
+        return false;
+    }
+    std::memcpy(copies.data(), data.data() + sizeof(EntryHeader), copies_size);
+    bytes_loaded += data.size();
+
+    // Eviction goes by modification time, refresh it so entries in use are kept
+    writer->QueueWork([path] {
+        std::error_code ec;
+        std::filesystem::last_write_time(path, std::filesystem::file_time_type::clock::now(), ec);
+    });
+    return true;
+}
+
+void TranscodeCache::Store(const std::filesystem::path& path, std::span<const u8> output,
+                           std::span<const BufferImageCopy> copies) {
+    // Output usually lives in a staging buffer, take a copy before handing it to the writer
+    std::vector<u8> data(sizeof(EntryHeader) + copies.size_bytes());
+    const EntryHeader header{
+        .magic = ENTRY_MAGIC,
+        .version = ENTRY_VERSION,
+        .output_size = output.size(),
+        .num_copies = static_cast<u32>(copies.size()),
+        .reserved = 0,
+    };
+    std::memcpy(data.data(), &header, sizeof(header));
+    std::memcpy(data.data() + sizeof(header), copies.data(), copies.size_bytes());
+
+    writer->QueueWork([this, path, data = std::move(data),
+                       uncompressed = std::vector<u8>(output.begin(), output.end())]() mutable {
+        const std::vector<u8> compressed =
+            Common::Compression::CompressDataZSTDDefault(uncompressed.data(), uncompressed.size());
+        if (compressed.empty()) {
+            return;
+        }
+        data.insert(data.end(), compressed.begin(), compressed.end());
+
+        // Write to a temporary file first so concurrent readers never see partial entries
+        std::filesystem::path temp_path = path;
+        temp_path += ".tmp";
+        {
+            const Common::FS::IOFile file{temp_path, Common::FS::FileAccessMode::Write};
+            if (!file.IsOpen() || file.WriteSpan(std::span<const u8>{data}) != data.size()) {
+                LOG_ERROR(Render, "Failed to write transcoded texture cache entry");
+                return;
+            }
+        }
+        if (!Common::FS::RenameFile(temp_path, path)) {
+            Common::FS::RemoveFile(temp_path);
+            return;
+        }
+        bytes_stored += data.size();
+        disk_usage += data.size();
+        if (disk_usage > MAX_DISK_USAGE) {
+            Evict();
+        }
+    });
+}
+
+void TranscodeCache::Evict() {
+    struct Entry {
+        std::filesystem::file_time_type last_use;
+        u64 size;
+        std::filesystem::path path;
+    };
+    std::vector<Entry> entries;
+    disk_usage = 0;
+
+    std::error_code ec;
+    std::filesystem::directory_iterator it{cache_dir, ec};
+    for (; !ec && it != std::filesystem::directory_iterator{}; it.increment(ec)) {
+        const std::filesystem::directory_entry& dir_entry = *it;
+        if (!dir_entry.is_regular_file(ec)) {
+            continue;
+        }
+        const u64 size = dir_entry.file_size(ec);
+        const auto last_use = dir_entry.last_write_time(ec);
+        if (ec) {
+            continue;
+        }
+        if (dir_entry.path().extension() == ".tmp") {
+            // Left behind by an interrupted write
+            std::filesystem::remove(dir_entry.path(), ec);
+            continue;
+        }
+        disk_usage += size;
+        entries.push_back({last_use, size, dir_entry.path()});
+    }
+    if (disk_usage <= MAX_DISK_USAGE) {
+        return;
+    }
+
+    std::ranges::sort(entries, {}, &Entry::last_use);
+    size_t num_removed = 0;
+    for (const Entry& entry : entries) {
+        if (disk_usage <= EVICTION_TARGET_USAGE) {
+            break;
+        }
+        if (std::filesystem::remove(entry.path, ec)) {
+            disk_usage -= entry.size;
+            ++num_removed;
+        }
+    }
+    LOG_INFO(Render, "Evicted {} transcoded texture cache entries, {} MiB in use", num_removed,
+             disk_usage / 1_MiB);
+}
+
+} // namespace VideoCommon
@@ -0,0 +1,68 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <atomic>
+#include <filesystem>
+#include <optional>
+#include <span>
+
+#include "common/common_types.h"
+#include "common/thread_worker.h"
+#include "video_core/texture_cache/image_info.h"
+#include "video_core/texture_cache/types.h"
+
+namespace VideoCommon {
+
+struct TranscodeCacheStats {
+    u64 hits;         ///< Conversions served from disk
+    u64 misses;       ///< Conversions performed on the CPU
+    u64 bytes_loaded; ///< Compressed bytes read from disk on hits
+    u64 bytes_stored; ///< Compressed bytes written to disk on misses
+};
+
+/**
+ * Persistent cache for images converted on the CPU (ASTC decoding/recompression and BCn
+ * decoding). Entries are keyed by a hash of the unswizzled guest data together with the image
+ * parameters that affect the conversion, so identical textures are shared between boots and
+ * between titles. Converted data is stored compressed with Zstandard, memory mapped on lookup and
+ * written back from a background thread. The directory is bounded in size, the least recently
+ * used entries are deleted when it grows past the limit.
+ */
+class TranscodeCache {
+public:
+    explicit TranscodeCache();
+    ~TranscodeCache();
+
+    TranscodeCache(const TranscodeCache&) = delete;
+    TranscodeCache& operator=(const TranscodeCache&) = delete;
+
+    /// Converts input the same way ConvertImage does, reusing a cached conversion when available
+    void ConvertImage(std::span<const u8> input, const ImageInfo& info, std::span<u8> output,
+                      std::span<BufferImageCopy> copies);
+
+    /// Returns the hit, miss and byte counters since the cache was created
+    [[nodiscard]] TranscodeCacheStats GetStats() const noexcept;
+
+private:
+    [[nodiscard]] bool Load(const std::filesystem::path& path, std::span<u8> output,
+                            std::span<BufferImageCopy> copies);
+
+    void Store(const std::filesystem::path& path, std::span<const u8> output,
+               std::span<const BufferImageCopy> copies);
+
+    /// Deletes the least recently used entries until the cache fits, runs on the writer thread
+    void Evict();
+
+    std::filesystem::path cache_dir;
+    std::optional<Common::ThreadWorker> writer;
+    u64 disk_usage{}; ///< Bytes used by the entries on disk, only accessed by the writer thread
+
+    std::atomic<u64> hits{};
+    std::atomic<u64> misses{};
+    std::atomic<u64> bytes_loaded{};
+    std::atomic<u64> bytes_stored{};
+};
+
+} // namespace VideoCommon
@@ -11,6 +11,19 @@
 #include <span>
 #include <vector>
 
+#if defined(ARCHITECTURE_x86_64)
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <emmintrin.h>
+#endif
+#elif defined(ARCHITECTURE_arm64)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wimplicit-int-conversion"
+#include <sse2neon.h>
+#pragma GCC diagnostic pop
+#endif
+
 #include <boost/container/static_vector.hpp>
 
 #include "common/alignment.h"
@@ -43,20 +56,29 @@ public:
     }
 
     constexpr u32 ReadBits(std::size_t nBits) {
+        // Consume as many bits as possible from the current byte on each step instead of
+        // extracting them one at a time. Bits past the end of the stream read as zero.
         u32 ret = 0;
-        for (std::size_t i = 0; i < nBits; ++i) {
-            ret |= (ReadBit() & 1) << i;
+        std::size_t shift = 0;
+        while (shift < nBits && bits_read < total_bits * 8) {
+            const std::size_t count =
+                std::min({8 - next_bit, nBits - shift, total_bits * 8 - bits_read});
+            const u32 mask = (1U << count) - 1;
+            ret |= ((static_cast<u32>(*cur_byte) >> next_bit) & mask) << shift;
+            shift += count;
+            next_bit += count;
+            bits_read += count;
+            if (next_bit >= 8) {
+                next_bit -= 8;
+                ++cur_byte;
+            }
         }
         return ret;
     }
 
     template <std::size_t nBits>
     constexpr u32 ReadBits() {
-        u32 ret = 0;
-        for (std::size_t i = 0; i < nBits; ++i) {
-            ret |= (ReadBit() & 1) << i;
-        }
-        return ret;
+        return ReadBits(nBits);
     }
 
 private:
@@ -385,12 +407,9 @@ struct TexelWeightParams {
     }
 };
 
-static TexelWeightParams DecodeBlockInfo(InputBitStream& strm) {
+static constexpr TexelWeightParams DecodeBlockMode(u16 modeBits) {
     TexelWeightParams params;
 
-    // Read the entire block mode all at once
-    u16 modeBits = static_cast<u16>(strm.ReadBits<11>());
-
     // Does this match the void extent block mode?
     if ((modeBits & 0x01FF) == 0x1FC) {
         if (modeBits & 0x200) {
@@ -399,8 +418,9 @@ static TexelWeightParams DecodeBlockInfo(InputBitStream& strm) {
             params.m_bVoidExtentLDR = true;
         }
 
-        // Next two bits must be one.
-        if (!(modeBits & 0x400) || !strm.ReadBit()) {
+        // Next two bits must be one. The second one lives outside of the block mode and is
+        // checked by DecodeBlockInfo.
+        if (!(modeBits & 0x400)) {
             params.m_bError = true;
         }
 
@@ -584,6 +604,30 @@ static TexelWeightParams DecodeBlockInfo(InputBitStream& strm) {
     return params;
 }
 
+static constexpr std::array<TexelWeightParams, 2048> MakeBlockModeTable() {
+    std::array<TexelWeightParams, 2048> table{};
+    for (std::size_t mode = 0; mode < table.size(); ++mode) {
+        table[mode] = DecodeBlockMode(static_cast<u16>(mode));
+    }
+    return table;
+}
+
+// Block modes are 11 bits wide, so every possible layout is decoded once up front
+static constexpr std::array<TexelWeightParams, 2048> BLOCK_MODE_TABLE = MakeBlockModeTable();
+
+static TexelWeightParams DecodeBlockInfo(InputBitStream& strm) {
+    // Read the entire block mode all at once
+    TexelWeightParams params = BLOCK_MODE_TABLE[strm.ReadBits<11>()];
+
+    if ((params.m_bVoidExtentLDR || params.m_bVoidExtentHDR) && !params.m_bError) {
+        if (!strm.ReadBit()) {
+            params.m_bError = true;
+        }
+    }
+
+    return params;
+}
+
 // Replicates low num_bits such that [(to_bit - 1):(to_bit - 1 - from_bit)]
 // is the same as [(num_bits - 1):0] and repeats all the way down.
 template <typename IntType>
@@ -1419,6 +1463,94 @@ static void FillError(std::span<u32> outBuf, u32 blockWidth, u32 blockHeight) {
     }
 }
 
+// Interpolates between the two endpoints of each texel's partition and packs the result as
+// R8G8B8A8. Endpoints are expanded to 16 bits by replication, so the interpolated value is
+// C = 257 * (e0 * (64 - w) + e1 * w) + 32 >> 6 and the final byte is (255 * C + 32768) >> 16,
+// which matches rounding 255 * C / 65536 to nearest. The SIMD path evaluates all four components
+// of a texel at once with a single pairwise multiply-add.
+// dualPlaneComponent is the component (in A, R, G, B order) that reads from the second weight
+// plane, or 4 when the block only has one plane.
+static void InterpolateTexels(std::span<u32, 12 * 12> outBuf, const Pixel (&endpoints)[4][2],
+                              const u32 (&weights)[2][144], u32 partitionIndex, u32 nPartitions,
+                              u32 dualPlaneComponent, u32 blockWidth, u32 blockHeight) {
+    const bool smallBlock = (blockHeight * blockWidth) < 32;
+    const auto texel_partition = [&](u32 i, u32 j) -> u32 {
+        if (nPartitions == 1) {
+            return 0;
+        }
+        const u32 partition = Select2DPartition(partitionIndex, i, j, nPartitions, smallBlock);
+        assert(partition < nPartitions);
+        return partition;
+    };
+    // Output byte order is R, G, B, A while Pixel stores A, R, G, B
+    static constexpr std::array<u32, 4> component_order{1, 2, 3, 0};
+
+#if defined(ARCHITECTURE_x86_64) || defined(ARCHITECTURE_arm64)
+    // Endpoint pairs interleaved as 16-bit lanes: [e0.R e1.R e0.G e1.G e0.B e1.B e0.A e1.A]
+    __m128i endpoint_pairs[4];
+    for (u32 p = 0; p < nPartitions; ++p) {
+        alignas(16) std::array<s16, 8> lanes;
+        for (u32 c = 0; c < 4; ++c) {
+            lanes[c * 2 + 0] = endpoints[p][0].Component(component_order[c]);
+            lanes[c * 2 + 1] = endpoints[p][1].Component(component_order[c]);
+        }
+        endpoint_pairs[p] = _mm_load_si128(reinterpret_cast<const __m128i*>(lanes.data()));
+    }
+    const __m128i sixty_four = _mm_set1_epi32(64);
+    const __m128i round_6 = _mm_set1_epi32(32);
+    const __m128i round_16 = _mm_set1_epi32(32768);
+
+    for (u32 j = 0; j < blockHeight; j++) {
+        for (u32 i = 0; i < blockWidth; i++) {
+            const u32 texel = j * blockWidth + i;
+            const u32 partition = texel_partition(i, j);
+
+            // Lanes hold w in the high half and 64 - w in the low half of each 32-bit element
+            const s32 w0 = static_cast<s32>(weights[0][texel]);
+            const s32 w1 = static_cast<s32>(weights[1][texel]);
+            const auto plane_weight = [&](u32 c) {
+                return component_order[c] == dualPlaneComponent ? w1 : w0;
+            };
+            const __m128i w = _mm_set_epi32(plane_weight(3), plane_weight(2), plane_weight(1),
+                                            plane_weight(0));
+            const __m128i factors =
+                _mm_or_si128(_mm_slli_epi32(w, 16), _mm_sub_epi32(sixty_four, w));
+
+            // e0 * (64 - w) + e1 * w, then expand to 16 bits and reduce back to 8 bits
+            const __m128i sum = _mm_madd_epi16(endpoint_pairs[partition], factors);
+            const __m128i expanded = _mm_add_epi32(_mm_slli_epi32(sum, 8), sum);
+            const __m128i c16 = _mm_srli_epi32(_mm_add_epi32(expanded, round_6), 6);
+            const __m128i scaled = _mm_sub_epi32(_mm_slli_epi32(c16, 8), c16);
+            const __m128i c8 = _mm_srli_epi32(_mm_add_epi32(scaled, round_16), 16);
+
+            const __m128i packed16 = _mm_packs_epi32(c8, c8);
+            const __m128i packed8 = _mm_packus_epi16(packed16, packed16);
+            outBuf[texel] = static_cast<u32>(_mm_cvtsi128_si32(packed8));
+        }
+    }
+#else
+    for (u32 j = 0; j < blockHeight; j++) {
+        for (u32 i = 0; i < blockWidth; i++) {
+            const u32 texel = j * blockWidth + i;
+            const u32 partition = texel_partition(i, j);
+
+            u32 packed = 0;
+            for (u32 c = 0; c < 4; c++) {
+                const u32 component = component_order[c];
+                const u32 e0 = static_cast<u32>(endpoints[partition][0].Component(component));
+                const u32 e1 = static_cast<u32>(endpoints[partition][1].Component(component));
+                const u32 plane = component == dualPlaneComponent ? 1 : 0;
+                const u32 weight = weights[plane][texel];
+
+                const u32 C = (257 * (e0 * (64 - weight) + e1 * weight) + 32) >> 6;
+                packed |= ((255 * C + 32768) >> 16) << (c * 8);
+            }
+            outBuf[texel] = packed;
+        }
+    }
+#endif
+}
+
 static void DecompressBlock(std::span<const u8, 16> inBuf, const u32 blockWidth,
                             const u32 blockHeight, std::span<u32, 12 * 12> outBuf) {
     InputBitStream strm(inBuf);
@@ -1619,36 +1751,9 @@ static void DecompressBlock(std::span<const u8, 16> inBuf, const u32 blockWidth,
 
     // Now that we have endpoints and weights, we can interpolate and generate
     // the proper decoding...
-    for (u32 j = 0; j < blockHeight; j++)
-        for (u32 i = 0; i < blockWidth; i++) {
-            u32 partition = Select2DPartition(partitionIndex, i, j, nPartitions,
-                                              (blockHeight * blockWidth) < 32);
-            assert(partition < nPartitions);
-
-            Pixel p;
-            for (u32 c = 0; c < 4; c++) {
-                u32 C0 = endpoints[partition][0].Component(c);
-                C0 = ReplicateByteTo16(C0);
-                u32 C1 = endpoints[partition][1].Component(c);
-                C1 = ReplicateByteTo16(C1);
-
-                u32 plane = 0;
-                if (weightParams.m_bDualPlane && (((planeIdx + 1) & 3) == c)) {
-                    plane = 1;
-                }
-
-                u32 weight = weights[plane][j * blockWidth + i];
-                u32 C = (C0 * (64 - weight) + C1 * weight + 32) / 64;
-                if (C == 65535) {
-                    p.Component(c) = 255;
-                } else {
-                    double Cf = static_cast<double>(C);
-                    p.Component(c) = static_cast<u16>(255.0 * (Cf / 65536.0) + 0.5);
-                }
-            }
-
-            outBuf[j * blockWidth + i] = p.Pack();
-        }
+    InterpolateTexels(outBuf, endpoints, weights, partitionIndex, nPartitions,
+                      weightParams.m_bDualPlane ? ((planeIdx + 1) & 3) : 4, blockWidth,
+                      blockHeight);
 }
 
 void Decompress(std::span<const uint8_t> data, uint32_t width, uint32_t height, uint32_t depth,
@@ -1658,6 +1763,7 @@ void Decompress(std::span<const uint8_t> data, uint32_t width, uint32_t height,
 
     Common::ThreadWorker& workers{GetThreadWorkers()};
 
+    // Slices write to disjoint parts of the output, so all of them are queued before waiting
     for (u32 z = 0; z < depth; ++z) {
         const u32 depth_offset = z * height * width * 4;
         for (u32 y_index = 0; y_index < rows; ++y_index) {
@@ -1686,8 +1792,8 @@ void Decompress(std::span<const uint8_t> data, uint32_t width, uint32_t height,
             };
             workers.QueueWork(std::move(decompress_stride));
         }
-        workers.WaitForRequests();
     }
+    workers.WaitForRequests();
 }
 
 } // namespace Tegra::Texture::ASTC
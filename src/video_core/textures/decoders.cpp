@@ -1,7 +1,9 @@
 // SPDX-FileCopyrightText: Copyright 2018 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
 #include <array>
+#include <bit>
 #include <cmath>
 #include <cstring>
 #include <span>
@@ -10,11 +12,18 @@
 #include "common/assert.h"
 #include "common/bit_util.h"
 #include "common/div_ceil.h"
+#include "common/literals.h"
 #include "video_core/gpu.h"
 #include "video_core/textures/decoders.h"
+#include "video_core/textures/workers.h"
 
 namespace Tegra::Texture {
 namespace {
+using namespace Common::Literals;
+
+// Minimum size of a 3D or layered image before its slices are swizzled in parallel
+constexpr u64 PARALLEL_SWIZZLE_THRESHOLD = 4_MiB;
+
 template <u32 mask>
 constexpr u32 pdep(u32 value) {
     u32 result = 0;
@@ -33,6 +42,56 @@ void incrpdep(u32& value) {
     value = ((value | ~mask) + swizzled_incr) & mask;
 }
 
+/**
+ * Copies the bytes [x_begin, x_end) of a single line between linear and block linear memory.
+ * Inside a GOB, every aligned run of 16 bytes in X is stored contiguously, so when pixels never
+ * straddle those runs (power of two sizes) the line is copied one run at a time instead of one
+ * pixel at a time. Other pixel sizes keep the per-pixel walk.
+ */
+template <bool TO_LINEAR, u32 BYTES_PER_PIXEL>
+void SwizzleLine(u8* output, const u8* input, u32 base_swizzled_offset, u32 swizzled_y,
+                 u32 x_shift, u32 x_begin, u32 x_end, u32 unswizzled_offset) {
+    if constexpr (std::has_single_bit(BYTES_PER_PIXEL)) {
+        static constexpr u32 RUN_SIZE = 16;
+        const auto copy = [&](u32 x, u32 swizzled_x, u32 size) {
+            const u32 offset_x = (x >> GOB_SIZE_X_SHIFT) << x_shift;
+            const u32 swizzled_offset = base_swizzled_offset + offset_x + (swizzled_x | swizzled_y);
+            const u32 linear_offset = unswizzled_offset + (x - x_begin);
+
+            u8* const dst = &output[TO_LINEAR ? swizzled_offset : linear_offset];
+            const u8* const src = &input[TO_LINEAR ? linear_offset : swizzled_offset];
+            std::memcpy(dst, src, size);
+        };
+        // Copy up to the first run boundary, then walk whole runs with the incremental pdep
+        u32 x = x_begin;
+        const u32 head_end = std::min(Common::AlignUp(x_begin, RUN_SIZE), x_end);
+        if (x < head_end) {
+            copy(x, pdep<SWIZZLE_X_BITS>(x), head_end - x);
+            x = head_end;
+        }
+        u32 swizzled_x = pdep<SWIZZLE_X_BITS>(x);
+        for (; x + RUN_SIZE <= x_end;
+             x += RUN_SIZE, incrpdep<SWIZZLE_X_BITS, RUN_SIZE>(swizzled_x)) {
+            copy(x, swizzled_x, RUN_SIZE);
+        }
+        if (x < x_end) {
+            copy(x, swizzled_x, x_end - x);
+        }
+    } else {
+        u32 swizzled_x = pdep<SWIZZLE_X_BITS>(x_begin);
+        for (u32 x = x_begin; x < x_end;
+             x += BYTES_PER_PIXEL, incrpdep<SWIZZLE_X_BITS, BYTES_PER_PIXEL>(swizzled_x)) {
+            const u32 offset_x = (x >> GOB_SIZE_X_SHIFT) << x_shift;
+            const u32 swizzled_offset = base_swizzled_offset + offset_x + (swizzled_x | swizzled_y);
+            const u32 linear_offset = unswizzled_offset + (x - x_begin);
+
+            u8* const dst = &output[TO_LINEAR ? swizzled_offset : linear_offset];
+            const u8* const src = &input[TO_LINEAR ? linear_offset : swizzled_offset];
+            std::memcpy(dst, src, BYTES_PER_PIXEL);
+        }
+    }
+}
+
 template <bool TO_LINEAR, u32 BYTES_PER_PIXEL>
 void SwizzleImpl(std::span<u8> output, std::span<const u8> input, u32 width, u32 height, u32 depth,
                  u32 block_height, u32 block_depth, u32 stride) {
@@ -55,7 +114,10 @@ void SwizzleImpl(std::span<u8> output, std::span<const u8> input, u32 width, u32
     const u32 block_depth_mask = (1U << block_depth) - 1;
     const u32 x_shift = GOB_SIZE_SHIFT + block_height + block_depth;
 
-    for (u32 slice = 0; slice < depth; ++slice) {
+    const u32 x_begin = origin_x * BYTES_PER_PIXEL;
+    const u32 x_end = x_begin + width * BYTES_PER_PIXEL;
+
+    const auto swizzle_slice = [=](u32 slice) {
         const u32 z = slice + origin_z;
         const u32 offset_z = (z >> block_depth) * slice_size +
                              ((z & block_depth_mask) << (GOB_SIZE_SHIFT + block_height));
@@ -67,24 +129,25 @@ void SwizzleImpl(std::span<u8> output, std::span<const u8> input, u32 width, u32
             const u32 offset_y = (block_y >> block_height) * block_size +
                                  ((block_y & block_height_mask) << GOB_SIZE_SHIFT);
 
-            u32 swizzled_x = pdep<SWIZZLE_X_BITS>(origin_x * BYTES_PER_PIXEL);
-            for (u32 column = 0; column < width;
-                 ++column, incrpdep<SWIZZLE_X_BITS, BYTES_PER_PIXEL>(swizzled_x)) {
-                const u32 x = (column + origin_x) * BYTES_PER_PIXEL;
-                const u32 offset_x = (x >> GOB_SIZE_X_SHIFT) << x_shift;
-
-                const u32 base_swizzled_offset = offset_z + offset_y + offset_x;
-                const u32 swizzled_offset = base_swizzled_offset + (swizzled_x | swizzled_y);
-
-                const u32 unswizzled_offset =
-                    slice * pitch * height + line * pitch + column * BYTES_PER_PIXEL;
-
-                u8* const dst = &output[TO_LINEAR ? swizzled_offset : unswizzled_offset];
-                const u8* const src = &input[TO_LINEAR ? unswizzled_offset : swizzled_offset];
-
-                std::memcpy(dst, src, BYTES_PER_PIXEL);
-            }
+            SwizzleLine<TO_LINEAR, BYTES_PER_PIXEL>(
+                output.data(), input.data(), offset_z + offset_y, swizzled_y, x_shift, x_begin,
+                x_end, slice * pitch * height + line * pitch);
+        }
+    };
+
+    // Slices never overlap in either layout, so large 3D and layered images are split across the
+    // transcode workers one slice at a time.
+    const u64 total_size = u64{pitch} * height * depth;
+    if (depth > 1 && total_size >= PARALLEL_SWIZZLE_THRESHOLD) {
+        Common::ThreadWorker& workers{GetThreadWorkers()};
+        for (u32 slice = 0; slice < depth; ++slice) {
+            workers.QueueWork([swizzle_slice, slice] { swizzle_slice(slice); });
         }
+        workers.WaitForRequests();
+        return;
+    }
+    for (u32 slice = 0; slice < depth; ++slice) {
+        swizzle_slice(slice);
     }
 }
 
@@ -110,6 +173,9 @@ void SwizzleSubrectImpl(std::span<u8> output, std::span<const u8> input, u32 wid
     const u32 block_depth_mask = (1U << block_depth) - 1;
     const u32 x_shift = GOB_SIZE_SHIFT + block_height + block_depth;
 
+    const u32 x_begin = origin_x * BYTES_PER_PIXEL;
+    const u32 x_end = x_begin + extent_x * BYTES_PER_PIXEL;
+
     u32 unprocessed_lines = num_lines;
     u32 extent_y = std::min(num_lines, height - origin_y);
 
@@ -126,27 +192,138 @@ void SwizzleSubrectImpl(std::span<u8> output, std::span<const u8> input, u32 wid
             const u32 offset_y = (block_y >> block_height) * block_size +
                                  ((block_y & block_height_mask) << GOB_SIZE_SHIFT);
 
-            u32 swizzled_x = pdep<SWIZZLE_X_BITS>(origin_x * BYTES_PER_PIXEL);
-            for (u32 column = 0; column < extent_x;
-                 ++column, incrpdep<SWIZZLE_X_BITS, BYTES_PER_PIXEL>(swizzled_x)) {
-                const u32 x = (column + origin_x) * BYTES_PER_PIXEL;
-                const u32 offset_x = (x >> GOB_SIZE_X_SHIFT) << x_shift;
+            SwizzleLine<TO_LINEAR, BYTES_PER_PIXEL>(
+                output.data(), input.data(), offset_z + offset_y, swizzled_y, x_shift, x_begin,
+                x_end, slice * pitch * height + line * pitch);
+        }
+        unprocessed_lines -= lines_in_y;
+        if (unprocessed_lines == 0) {
+            return;
+        }
+    }
+}
+
+/// Same as pdep<SWIZZLE_X_BITS>(x % GOB_SIZE_X) with the bit loop unrolled by hand.
+constexpr u32 SwizzleX(u32 x) {
+    return (x & 0xF) | ((x & 0x10) << 1) | ((x & 0x20) << 3);
+}
+static_assert([] {
+    for (u32 x = 0; x < GOB_SIZE_X; ++x) {
+        if (SwizzleX(x) != pdep<SWIZZLE_X_BITS>(x)) {
+            return false;
+        }
+    }
+    return true;
+}());
+
+/// Addressing of the first slice of a block linear surface.
+struct BlockLinearLayout {
+    explicit BlockLinearLayout(u32 width_in_bytes, u32 block_height_, u32 block_depth)
+        : block_height{block_height_}, block_height_mask{(1U << block_height_) - 1},
+          x_shift{GOB_SIZE_SHIFT + block_height_ + block_depth},
+          block_size{Common::DivCeilLog2(width_in_bytes, GOB_SIZE_X_SHIFT) << x_shift} {}
+
+    /// Returns the offset of line y, excluding its X component.
+    u32 LineOffset(u32 y) const {
+        const u32 block_y = y >> GOB_SIZE_Y_SHIFT;
+        return (block_y >> block_height) * block_size +
+               ((block_y & block_height_mask) << GOB_SIZE_SHIFT) + pdep<SWIZZLE_Y_BITS>(y);
+    }
+
+    /// Returns the offset of the byte x of a line.
+    u32 Offset(u32 line_offset, u32 x) const {
+        return line_offset + ((x >> GOB_SIZE_X_SHIFT) << x_shift) + SwizzleX(x);
+    }
 
-                const u32 base_swizzled_offset = offset_z + offset_y + offset_x;
-                const u32 swizzled_offset = base_swizzled_offset + (swizzled_x | swizzled_y);
+    /// Returns how many GOBs are stored back to back in Y from the GOB aligned line y.
+    u32 ContiguousGOBs(u32 y) const {
+        return (1U << block_height) - ((y >> GOB_SIZE_Y_SHIFT) & block_height_mask);
+    }
 
-                const u32 unswizzled_offset =
-                    slice * pitch * height + line * pitch + column * BYTES_PER_PIXEL;
+    u32 block_height;
+    u32 block_height_mask;
+    u32 x_shift;
+    u32 block_size;
+};
+
+/// Invokes func(swizzled_offset, index, size) for each aligned run of 16 bytes of a line.
+template <typename Func>
+void ForEachRun(BlockLinearLayout layout, u32 line_offset, u32 x, u32 num_bytes,
+                Func&& func) {
+    static constexpr u32 RUN_SIZE = 16;
+    if (num_bytes == 0) {
+        return;
+    }
+    // Copy up to the first run boundary, then walk whole runs with the incremental pdep
+    const u32 head = std::min(RUN_SIZE - (x & (RUN_SIZE - 1)), num_bytes);
+    func(layout.Offset(line_offset, x), 0, head);
+    u32 swizzled_x = SwizzleX(x + head);
+    for (u32 index = head; index < num_bytes;
+         index += RUN_SIZE, incrpdep<SWIZZLE_X_BITS, RUN_SIZE>(swizzled_x)) {
+        const u32 offset_x = ((x + index) >> GOB_SIZE_X_SHIFT) << layout.x_shift;
+        func(line_offset + offset_x + swizzled_x, index, std::min(RUN_SIZE, num_bytes - index));
+    }
+}
 
-                u8* const dst = &output[TO_LINEAR ? swizzled_offset : unswizzled_offset];
-                const u8* const src = &input[TO_LINEAR ? unswizzled_offset : swizzled_offset];
+void CopyRun(u8* output, const u8* input, u32 size) {
+    if (size == 16) {
+        std::memcpy(output, input, 16);
+    } else {
+        std::memcpy(output, input, size);
+    }
+}
 
-                std::memcpy(dst, src, BYTES_PER_PIXEL);
-            }
+/// Copies num_lines lines of num_bytes bytes between two block linear surfaces.
+void CopySwizzledLines(u8* output, const u8* input, BlockLinearLayout dst,
+                       BlockLinearLayout src, u32 dst_x, u32 dst_y, u32 src_x, u32 src_y,
+                       u32 num_bytes, u32 num_lines) {
+    static constexpr u32 RUN_SIZE = 16;
+    static constexpr u32 PIECE_SIZE = 256;
+    const bool is_run_aligned = ((dst_x ^ src_x) & (RUN_SIZE - 1)) == 0;
+    const u32 skew = src_x & (RUN_SIZE - 1);
+    std::array<u8, PIECE_SIZE + RUN_SIZE> staging;
+    for (u32 line = 0; line < num_lines; ++line) {
+        const u32 dst_line = dst.LineOffset(dst_y + line);
+        const u32 src_line = src.LineOffset(src_y + line);
+        if (is_run_aligned) {
+            // Runs line up on both sides and are copied directly
+            ForEachRun(src, src_line, src_x, num_bytes, [&](u32 src_offset, u32 index, u32 size) {
+                CopyRun(output + dst.Offset(dst_line, dst_x + index), input + src_offset, size);
+            });
+            continue;
         }
-        unprocessed_lines -= lines_in_y;
-        if (unprocessed_lines == 0) {
-            return;
+        // Otherwise every run would be split in two. Gather whole source runs into a small
+        // buffer instead, so both sides are still copied one run at a time.
+        for (u32 x = 0; x < num_bytes; x += PIECE_SIZE) {
+            const u32 piece = std::min(PIECE_SIZE, num_bytes - x);
+            const u32 gather_begin = src_x + x - skew;
+            const u32 gather_size = Common::AlignUpLog2(skew + piece, 4);
+            ForEachRun(src, src_line, gather_begin, gather_size,
+                       [&](u32 offset, u32 index, u32) {
+                           std::memcpy(staging.data() + index, input + offset, RUN_SIZE);
+                       });
+            ForEachRun(dst, dst_line, dst_x + x, piece, [&](u32 offset, u32 index, u32 size) {
+                CopyRun(output + offset, staging.data() + skew + index, size);
+            });
+        }
+    }
+}
+
+/**
+ * Copies num_lines lines of num_pixels pixels between two block linear surfaces one pixel at a
+ * time. Pixels that are not a power of two in size straddle 16 byte runs, and the swizzles store
+ * them whole at the address of their first byte, so they can not be copied by runs.
+ */
+void CopySwizzledPixels(u8* output, const u8* input, BlockLinearLayout dst,
+                        BlockLinearLayout src, u32 dst_x, u32 dst_y, u32 src_x, u32 src_y,
+                        u32 bytes_per_pixel, u32 num_pixels, u32 num_lines) {
+    const u32 num_bytes = num_pixels * bytes_per_pixel;
+    for (u32 line = 0; line < num_lines; ++line) {
+        const u32 dst_line = dst.LineOffset(dst_y + line);
+        const u32 src_line = src.LineOffset(src_y + line);
+        for (u32 x = 0; x < num_bytes; x += bytes_per_pixel) {
+            std::memcpy(output + dst.Offset(dst_line, dst_x + x),
+                        input + src.Offset(src_line, src_x + x), bytes_per_pixel);
         }
     }
 }
@@ -246,6 +423,68 @@ void UnswizzleSubrect(std::span<u8> output, std::span<const u8> input, u32 bytes
     }
 }
 
+void CopySwizzledSubrect(std::span<u8> output, std::span<const u8> input, u32 bytes_per_pixel,
+                         u32 dst_width, u32 dst_origin_x, u32 dst_origin_y, u32 dst_block_height,
+                         u32 dst_block_depth, u32 src_width, u32 src_origin_x, u32 src_origin_y,
+                         u32 src_block_height, u32 src_block_depth, u32 extent_x, u32 extent_y) {
+    const BlockLinearLayout dst{dst_width * bytes_per_pixel, dst_block_height, dst_block_depth};
+    const BlockLinearLayout src{src_width * bytes_per_pixel, src_block_height, src_block_depth};
+    const u32 dst_x = dst_origin_x * bytes_per_pixel;
+    const u32 src_x = src_origin_x * bytes_per_pixel;
+    const u32 num_bytes = extent_x * bytes_per_pixel;
+    u8* const out = output.data();
+    const u8* const in = input.data();
+    if (!std::has_single_bit(bytes_per_pixel)) {
+        CopySwizzledPixels(out, in, dst, src, dst_x, dst_origin_y, src_x, src_origin_y,
+                           bytes_per_pixel, extent_x, extent_y);
+        return;
+    }
+
+    // Every GOB has the same internal layout, so when both rectangles start at the same position
+    // within a GOB the GOBs they fully cover are copied whole, together with the GOBs that follow
+    // them in Y within the same block on both sides.
+    const bool is_gob_aligned = ((dst_x ^ src_x) & (GOB_SIZE_X - 1)) == 0 &&
+                                ((dst_origin_y ^ src_origin_y) & (GOB_SIZE_Y - 1)) == 0;
+    const u32 first_gob_x = Common::AlignUpLog2(src_x, GOB_SIZE_X_SHIFT);
+    const u32 end_gob_x = Common::AlignDown(src_x + num_bytes, GOB_SIZE_X);
+    const u32 first_gob_y = Common::AlignUpLog2(src_origin_y, GOB_SIZE_Y_SHIFT);
+    const u32 end_gob_y = Common::AlignDown(src_origin_y + extent_y, GOB_SIZE_Y);
+    if (!is_gob_aligned || first_gob_x >= end_gob_x || first_gob_y >= end_gob_y) {
+        CopySwizzledLines(out, in, dst, src, dst_x, dst_origin_y, src_x, src_origin_y, num_bytes,
+                          extent_y);
+        return;
+    }
+    const u32 gob_x_begin = first_gob_x - src_x;
+    const u32 gob_x_end = end_gob_x - src_x;
+    const u32 gob_y_begin = first_gob_y - src_origin_y;
+    const u32 gob_y_end = end_gob_y - src_origin_y;
+
+    // Partial GOBs around the edges
+    CopySwizzledLines(out, in, dst, src, dst_x, dst_origin_y, src_x, src_origin_y, num_bytes,
+                      gob_y_begin);
+    CopySwizzledLines(out, in, dst, src, dst_x, dst_origin_y + gob_y_end, src_x,
+                      src_origin_y + gob_y_end, num_bytes, extent_y - gob_y_end);
+    const u32 gob_lines = gob_y_end - gob_y_begin;
+    CopySwizzledLines(out, in, dst, src, dst_x, dst_origin_y + gob_y_begin, src_x,
+                      src_origin_y + gob_y_begin, gob_x_begin, gob_lines);
+    CopySwizzledLines(out, in, dst, src, dst_x + gob_x_end, dst_origin_y + gob_y_begin,
+                      src_x + gob_x_end, src_origin_y + gob_y_begin, num_bytes - gob_x_end,
+                      gob_lines);
+
+    for (u32 y = gob_y_begin; y < gob_y_end;) {
+        const u32 num_gobs = std::min({dst.ContiguousGOBs(dst_origin_y + y),
+                                       src.ContiguousGOBs(src_origin_y + y),
+                                       (gob_y_end - y) >> GOB_SIZE_Y_SHIFT});
+        const u32 dst_line = dst.LineOffset(dst_origin_y + y);
+        const u32 src_line = src.LineOffset(src_origin_y + y);
+        for (u32 x = gob_x_begin; x < gob_x_end; x += GOB_SIZE_X) {
+            std::memcpy(out + dst.Offset(dst_line, dst_x + x), in + src.Offset(src_line, src_x + x),
+                        num_gobs << GOB_SIZE_SHIFT);
+        }
+        y += num_gobs << GOB_SIZE_Y_SHIFT;
+    }
+}
+
 std::size_t CalculateSize(bool tiled, u32 bytes_per_pixel, u32 width, u32 height, u32 depth,
                           u32 block_height, u32 block_depth) {
     if (tiled) {
@@ -23,6 +23,7 @@
 #include "core/file_sys/registered_cache.h"
 #include "core/file_sys/submission_package.h"
 #include "core/loader/loader.h"
+#include "frontend_common/game_scanner.h"
 #include "yuzu/compatibility_list.h"
 #include "yuzu/game_list.h"
 #include "yuzu/game_list_p.h"
@@ -139,11 +140,6 @@ void GetMetadataFromControlNCA(const FileSys::PatchManager& patch_manager, const
         });
 }
 
-bool HasSupportedFileExtension(const std::string& file_name) {
-    const QFileInfo file = QFileInfo(QString::fromStdString(file_name));
-    return GameList::supported_file_extensions.contains(file.suffix(), Qt::CaseInsensitive);
-}
-
 bool IsExtractedNCAMain(const std::string& file_name) {
     return QFileInfo(QString::fromStdString(file_name)).fileName() == QStringLiteral("main");
 }
@@ -160,10 +156,9 @@ QString FormatGameName(const std::string& physical_name) {
 }
 
 QString FormatPatchNameVersions(const FileSys::PatchManager& patch_manager,
-                                Loader::AppLoader& loader, bool updatable = true) {
+                                Loader::FileType file_type, const FileSys::VirtualFile& update_raw,
+                                bool updatable = true) {
     QString out;
-    FileSys::VirtualFile update_raw;
-    loader.ReadUpdateRaw(update_raw);
     for (const auto& patch : patch_manager.GetPatches(update_raw)) {
         const bool is_update = patch.name == "Update";
         if (!updatable && is_update) {
@@ -180,7 +175,7 @@ QString FormatPatchNameVersions(const FileSys::PatchManager& patch_manager,
 
             // Display container name for packed updates
             if (is_update && ver == "PACKED") {
-                ver = Loader::GetFileTypeString(loader.GetFileType());
+                ver = Loader::GetFileTypeString(file_type);
             }
 
             out.append(QStringLiteral("%1 (%2)\n").arg(type, QString::fromStdString(ver)));
@@ -191,12 +186,12 @@ QString FormatPatchNameVersions(const FileSys::PatchManager& patch_manager,
     return out;
 }
 
-QList<QStandardItem*> MakeGameListEntry(const std::string& path, const std::string& name,
-                                        const std::size_t size, const std::vector<u8>& icon,
-                                        Loader::AppLoader& loader, u64 program_id,
-                                        const CompatibilityList& compatibility_list,
-                                        const PlayTime::PlayTimeManager& play_time_manager,
-                                        const FileSys::PatchManager& patch) {
+QList<QStandardItem*> MakeGameListEntry(
+    const std::string& path, const std::string& name, const std::size_t size,
+    const std::vector<u8>& icon, Loader::FileType file_type, bool is_romfs_updatable,
+    const std::function<FileSys::VirtualFile()>& read_update_raw, u64 program_id,
+    const CompatibilityList& compatibility_list,
+    const PlayTime::PlayTimeManager& play_time_manager, const FileSys::PatchManager& patch) {
     const auto it = FindMatchingCompatibilityEntry(compatibility_list, program_id);
 
     // The game list uses this as compatibility number for untested games
@@ -205,7 +200,6 @@ QList<QStandardItem*> MakeGameListEntry(const std::string& path, const std::stri
         compatibility = it->second.first;
     }
 
-    const auto file_type = loader.GetFileType();
     const auto file_type_string = QString::fromStdString(Loader::GetFileTypeString(file_type));
 
     QList<QStandardItem*> list{
@@ -218,8 +212,10 @@ QList<QStandardItem*> MakeGameListEntry(const std::string& path, const std::stri
     };
 
     const auto patch_versions = GetGameListCachedObject(
-        fmt::format("{:016X}", patch.GetTitleID()), "pv.txt", [&patch, &loader] {
-            return FormatPatchNameVersions(patch, loader, loader.IsRomFSUpdatable());
+        fmt::format("{:016X}", patch.GetTitleID()), "pv.txt",
+        [&patch, file_type, is_romfs_updatable, &read_update_raw] {
+            return FormatPatchNameVersions(patch, file_type, read_update_raw(),
+                                           is_romfs_updatable);
         });
     list.insert(2, new GameListItem(patch_versions));
 
@@ -234,8 +230,9 @@ GameListWorker::GameListWorker(FileSys::VirtualFilesystem vfs_,
                                const PlayTime::PlayTimeManager& play_time_manager_,
                                Core::System& system_)
     : vfs{std::move(vfs_)}, provider{provider_}, game_dirs{game_dirs_},
-      compatibility_list{compatibility_list_}, play_time_manager{play_time_manager_}, system{
-                                                                                          system_} {
+      compatibility_list{compatibility_list_}, play_time_manager{play_time_manager_},
+      system{system_}, scanner{std::make_unique<GameScanner>(
+                           system, vfs, UISettings::values.cache_game_list.GetValue())} {
     // We want the game list to manage our lifetime.
     setAutoDelete(false);
 }
@@ -243,6 +240,7 @@ GameListWorker::GameListWorker(FileSys::VirtualFilesystem vfs_,
 GameListWorker::~GameListWorker() {
     this->disconnect();
     stop_requested.store(true);
+    scanner->RequestStop();
     processing_completed.Wait();
 }
 
@@ -328,119 +326,93 @@ void GameListWorker::AddTitlesToGameList(GameListDir* parent_dir) {
             GetMetadataFromControlNCA(patch, *control, icon, name);
         }
 
-        auto entry = MakeGameListEntry(file->GetFullPath(), name, file->GetSize(), icon, *loader,
-                                       program_id, compatibility_list, play_time_manager, patch);
+        const auto read_update_raw = [&loader] {
+            FileSys::VirtualFile update_raw;
+            loader->ReadUpdateRaw(update_raw);
+            return update_raw;
+        };
+        auto entry = MakeGameListEntry(file->GetFullPath(), name, file->GetSize(), icon,
+                                       loader->GetFileType(), loader->IsRomFSUpdatable(),
+                                       read_update_raw, program_id, compatibility_list,
+                                       play_time_manager, patch);
         RecordEvent([=](GameList* game_list) { game_list->AddEntry(entry, parent_dir); });
     }
 }
 
 void GameListWorker::ScanFileSystem(ScanTarget target, const std::string& dir_path, bool deep_scan,
                                     GameListDir* parent_dir) {
-    const auto callback = [this, target, parent_dir](const std::filesystem::path& path) -> bool {
-        if (stop_requested) {
-            // Breaks the callback loop.
-            return false;
-        }
+    std::vector<std::string> dirs;
+    const auto files = scanner->CollectFiles(
+        dir_path, deep_scan, target == ScanTarget::PopulateGameList ? &dirs : nullptr);
 
-        const auto physical_name = Common::FS::PathToUTF8String(path);
-        const auto is_dir = Common::FS::IsDir(path);
-
-        if (!is_dir &&
-            (HasSupportedFileExtension(physical_name) || IsExtractedNCAMain(physical_name))) {
+    if (target == ScanTarget::FillManualContentProvider) {
+        std::mutex provider_mutex;
+        scanner->ForEachFile(files, [this, &provider_mutex](const std::string& physical_name) {
             const auto file = vfs->OpenFile(physical_name, FileSys::OpenMode::Read);
             if (!file) {
-                return true;
+                return;
             }
 
-            auto loader = Loader::GetLoader(system, file);
+            const auto loader = Loader::GetLoader(system, file);
             if (!loader) {
-                return true;
+                return;
             }
 
             const auto file_type = loader->GetFileType();
-            if (file_type == Loader::FileType::Unknown || file_type == Loader::FileType::Error) {
-                return true;
+            u64 program_id = 0;
+            if (loader->ReadProgramId(program_id) != Loader::ResultStatus::Success) {
+                return;
             }
 
-            u64 program_id = 0;
-            const auto res2 = loader->ReadProgramId(program_id);
-
-            if (target == ScanTarget::FillManualContentProvider) {
-                if (res2 == Loader::ResultStatus::Success && file_type == Loader::FileType::NCA) {
-                    provider->AddEntry(FileSys::TitleType::Application,
-                                       FileSys::GetCRTypeFromNCAType(FileSys::NCA{file}.GetType()),
-                                       program_id, file);
-                } else if (res2 == Loader::ResultStatus::Success &&
-                           (file_type == Loader::FileType::XCI ||
-                            file_type == Loader::FileType::NSP)) {
-                    const auto nsp = file_type == Loader::FileType::NSP
-                                         ? std::make_shared<FileSys::NSP>(file)
-                                         : FileSys::XCI{file}.GetSecurePartitionNSP();
-                    for (const auto& title : nsp->GetNCAs()) {
-                        for (const auto& entry : title.second) {
-                            provider->AddEntry(entry.first.first, entry.first.second, title.first,
-                                               entry.second->GetBaseFile());
-                        }
+            if (file_type == Loader::FileType::NCA) {
+                const auto type = FileSys::GetCRTypeFromNCAType(FileSys::NCA{file}.GetType());
+                std::scoped_lock lk{provider_mutex};
+                provider->AddEntry(FileSys::TitleType::Application, type, program_id, file);
+            } else if (file_type == Loader::FileType::XCI || file_type == Loader::FileType::NSP) {
+                const auto nsp = file_type == Loader::FileType::NSP
+                                     ? std::make_shared<FileSys::NSP>(file)
+                                     : FileSys::XCI{file}.GetSecurePartitionNSP();
+                std::scoped_lock lk{provider_mutex};
+                for (const auto& title : nsp->GetNCAs()) {
+                    for (const auto& entry : title.second) {
+                        provider->AddEntry(entry.first.first, entry.first.second, title.first,
+                                           entry.second->GetBaseFile());
                     }
                 }
-            } else {
-                std::vector<u64> program_ids;
-                loader->ReadProgramIds(program_ids);
-
-                if (res2 == Loader::ResultStatus::Success && program_ids.size() > 1 &&
-                    (file_type == Loader::FileType::XCI || file_type == Loader::FileType::NSP)) {
-                    for (const auto id : program_ids) {
-                        loader = Loader::GetLoader(system, file, id);
-                        if (!loader) {
-                            continue;
-                        }
-
-                        std::vector<u8> icon;
-                        [[maybe_unused]] const auto res1 = loader->ReadIcon(icon);
-
-                        std::string name = " ";
-                        [[maybe_unused]] const auto res3 = loader->ReadTitle(name);
-
-                        const FileSys::PatchManager patch{id, system.GetFileSystemController(),
-                                                          system.GetContentProvider()};
-
-                        auto entry = MakeGameListEntry(
-                            physical_name, name, Common::FS::GetSize(physical_name), icon, *loader,
-                            id, compatibility_list, play_time_manager, patch);
-
-                        RecordEvent(
-                            [=](GameList* game_list) { game_list->AddEntry(entry, parent_dir); });
+            }
+        });
+    } else {
+        scanner->ScanFiles(files, [this, parent_dir](const ScannedFile& scanned) {
+            for (const auto& title : scanned.titles) {
+                // Only containers that bundle an update have to be opened again.
+                const auto read_update_raw = [this, &scanned, &title] {
+                    FileSys::VirtualFile update_raw;
+                    if (!title.has_packed_update) {
+                        return update_raw;
                     }
-                } else {
-                    std::vector<u8> icon;
-                    [[maybe_unused]] const auto res1 = loader->ReadIcon(icon);
-
-                    std::string name = " ";
-                    [[maybe_unused]] const auto res3 = loader->ReadTitle(name);
+                    const auto file = vfs->OpenFile(scanned.path, FileSys::OpenMode::Read);
+                    if (const auto loader = Loader::GetLoader(system, file, title.program_id)) {
+                        loader->ReadUpdateRaw(update_raw);
+                    }
+                    return update_raw;
+                };
 
-                    const FileSys::PatchManager patch{program_id, system.GetFileSystemController(),
-                                                      system.GetContentProvider()};
+                const FileSys::PatchManager patch{title.program_id,
+                                                  system.GetFileSystemController(),
+                                                  system.GetContentProvider()};
 
-                    auto entry = MakeGameListEntry(
-                        physical_name, name, Common::FS::GetSize(physical_name), icon, *loader,
-                        program_id, compatibility_list, play_time_manager, patch);
+                auto entry = MakeGameListEntry(scanned.path, title.name, scanned.size, title.icon,
+                                               scanned.file_type, title.is_romfs_updatable,
+                                               read_update_raw, title.program_id,
+                                               compatibility_list, play_time_manager, patch);
 
-                    RecordEvent(
-                        [=](GameList* game_list) { game_list->AddEntry(entry, parent_dir); });
-                }
+                RecordEvent([=](GameList* game_list) { game_list->AddEntry(entry, parent_dir); });
             }
-        } else if (is_dir) {
-            watch_list.append(QString::fromStdString(physical_name));
-        }
-
-        return true;
-    };
+        });
+    }
 
-    if (deep_scan) {
-        Common::FS::IterateDirEntriesRecursively(dir_path, callback,
-                                                 Common::FS::DirEntryFilter::All);
-    } else {
-        Common::FS::IterateDirEntries(dir_path, callback, Common::FS::DirEntryFilter::File);
+    for (const auto& dir : dirs) {
+        watch_list.append(QString::fromStdString(dir));
     }
 }
 
@@ -480,6 +452,8 @@ void GameListWorker::run() {
         }
     }
 
+    scanner->SaveIndex();
+
     RecordEvent([this](GameList* game_list) { game_list->DonePopulating(watch_list); });
     processing_completed.Set();
 }
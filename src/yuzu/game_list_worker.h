@@ -22,6 +22,7 @@ class System;
 }
 
 class GameList;
+class GameScanner;
 class QStandardItem;
 
 namespace FileSys {
@@ -91,4 +92,5 @@ private:
     Common::Event processing_completed;
 
     Core::System& system;
+    std::unique_ptr<GameScanner> scanner;
 };
@@ -396,6 +396,10 @@ speed_limit =
 # 0: Off, 1 (default): On
 use_disk_shader_cache =
 
+# Whether to store textures converted on the CPU (ASTC, BCn) in a disk cache
+# 0 (default): Off, 1: On
+use_disk_texture_cache =
+
 # Which gpu accuracy level to use
 # 0: Normal, 1 (default): High, 2: Extreme (Very slow)
 gpu_accuracy =
@@ -455,6 +459,14 @@ gamecard_current_game =
 # If 'gamecard_current_game' is 1 this setting is irrelevant
 gamecard_path =
 
+# Memory maps large game files that are read-only on disk instead of reading them with read-ahead
+# 0 (default): Off, 1: On
+map_read_only_files =
+
+# Size in MiB of the cache of decrypted game data blocks shared by all open contents
+# 0: Off, 1 - 1024: Cache size in MiB. 64 (default)
+decrypted_block_cache_size =
+
 [System]
 # Whether the system is docked
 # 1 (default): Yes, 0: No
@@ -509,6 +521,9 @@ dump_nso=false
 enable_fs_access_log=false
 # Enables verbose reporting services
 reporting_services =
+# Records a latency histogram of every HLE service command and logs it when the service is destroyed
+# false: Disabled (default), true: Enabled
+record_service_latency =
 # Determines whether or not yuzu will report to the game that the emulated console is in Kiosk Mode
 # false: Retail/Normal Mode (default), true: Kiosk Mode
 quest_flag =
@@ -520,6 +535,9 @@ use_debug_asserts =
 use_auto_stub =
 # Enables/Disables the macro JIT compiler
 disable_macro_jit=false
+# Records the GPU command stream to the dump directory, it can be replayed with yuzu-cmd --replay-gpu
+# false: Disabled (default), true: Enabled
+dump_gpu_commands =
 # Determines whether to enable the GDB stub and wait for the debugger to attach before running.
 # false: Disabled (default), true: Enabled
 use_gdbstub=false
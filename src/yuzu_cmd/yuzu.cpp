@@ -1,6 +1,7 @@
 // SPDX-FileCopyrightText: 2014 Citra Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <array>
 #include <chrono>
 #include <iostream>
 #include <memory>
@@ -31,9 +32,12 @@
 #include "core/loader/loader.h"
 #include "core/telemetry_session.h"
 #include "frontend_common/config.h"
+#include "frontend_common/game_scanner.h"
 #include "input_common/main.h"
 #include "network/network.h"
 #include "sdl_config.h"
+#include "video_core/command_replay.h"
+#include "video_core/gpu.h"
 #include "video_core/renderer_base.h"
 #include "yuzu_cmd/emu_window/emu_window_sdl2.h"
 #include "yuzu_cmd/emu_window/emu_window_sdl2_gl.h"
@@ -75,13 +79,61 @@ static void PrintHelp(const char* argv0) {
                  "-f, --fullscreen      Start in fullscreen mode\n"
                  "-g, --game            File path of the game to load\n"
                  "-h, --help            Display this help and exit\n"
+                 "-l, --list-games      Scan the specified directory for games, list them and exit\n"
                  "-m, --multiplayer=nick:password@address:port"
                  " Nickname, password, address and port for multiplayer\n"
                  "-p, --program         Pass following string as arguments to executable\n"
+                 "-r, --replay-gpu      Replay a GPU command capture on the null renderer and exit\n"
                  "-u, --user            Select a specific user profile from 0 to 7\n"
                  "-v, --version         Output version information and exit\n";
 }
 
+static int ReplayGPU(Core::System& system, EmuWindow_SDL2& emu_window, const std::string& path) {
+    if (system.LoadGPUOnly(emu_window) != Core::SystemResultStatus::Success) {
+        LOG_CRITICAL(Frontend, "Failed to initialize VideoCore!");
+        return -1;
+    }
+    system.GPU().Start();
+
+    const auto results = Tegra::ReplayCommandCapture(system, path);
+    system.ShutdownMainProcess();
+    if (!results) {
+        return -1;
+    }
+
+    using FloatSeconds = std::chrono::duration<double>;
+    using FloatMilliseconds = std::chrono::duration<double, std::milli>;
+    const double seconds = std::chrono::duration_cast<FloatSeconds>(results->time).count();
+    fmt::print("{} command lists, {} words, {} methods in {:.3f} s ({:.0f} methods/s)\n",
+               results->num_lists, results->num_words, results->num_methods, seconds,
+               seconds > 0.0 ? static_cast<double>(results->num_methods) / seconds : 0.0);
+
+    static constexpr std::array<const char*, Tegra::DispatchStatistics::NUM_ENGINES> engine_names{
+        "KeplerCompute", "Maxwell3D", "Fermi2D", "MaxwellDMA", "KeplerMemory", "Puller",
+    };
+    for (size_t engine = 0; engine < engine_names.size(); ++engine) {
+        fmt::print("  {:<14} {:>12} methods {:>10.3f} ms\n", engine_names[engine],
+                   results->engines.methods[engine],
+                   std::chrono::duration_cast<FloatMilliseconds>(results->engines.time[engine])
+                       .count());
+    }
+    return 0;
+}
+
+static int ListGames(Core::System& system, const std::string& path) {
+    GameScanner scanner{system, system.GetFilesystem(), true};
+    const auto files = scanner.CollectFiles(path, true);
+
+    scanner.ScanFiles(files, [](const ScannedFile& scanned) {
+        for (const auto& title : scanned.titles) {
+            fmt::print("{:016X}  {:<4}  {}  ({})\n", title.program_id,
+                       Loader::GetFileTypeString(scanned.file_type), title.name, scanned.path);
+        }
+    });
+    scanner.SaveIndex();
+    return 0;
+}
+
 static void PrintVersion() {
     std::cout << "yuzu " << Common::g_scm_branch << " " << Common::g_scm_desc << std::endl;
 }
@@ -208,6 +260,8 @@ int main(int argc, char** argv) {
     }
 #endif
     std::string filepath;
+    std::string replay_path;
+    std::string list_path;
     std::optional<std::string> config_path;
     std::string program_args;
     std::optional<int> selected_user;
@@ -225,8 +279,10 @@ int main(int argc, char** argv) {
         {"fullscreen", no_argument, 0, 'f'},
         {"help", no_argument, 0, 'h'},
         {"game", required_argument, 0, 'g'},
+        {"list-games", required_argument, 0, 'l'},
         {"multiplayer", required_argument, 0, 'm'},
         {"program", optional_argument, 0, 'p'},
+        {"replay-gpu", required_argument, 0, 'r'},
         {"user", required_argument, 0, 'u'},
         {"version", no_argument, 0, 'v'},
         {0, 0, 0, 0},
@@ -234,7 +290,7 @@ int main(int argc, char** argv) {
     };
 
     while (optind < argc) {
-        int arg = getopt_long(argc, argv, "g:fhvp::c:u:", long_options, &option_index);
+        int arg = getopt_long(argc, argv, "g:fhl:vp::c:u:r:", long_options, &option_index);
         if (arg != -1) {
             switch (static_cast<char>(arg)) {
             case 'c':
@@ -252,6 +308,9 @@ int main(int argc, char** argv) {
                 filepath = str_arg;
                 break;
             }
+            case 'l':
+                list_path = optarg;
+                break;
             case 'm': {
                 use_multiplayer = true;
                 const std::string str_arg(optarg);
@@ -289,6 +348,9 @@ int main(int argc, char** argv) {
                 program_args = argv[optind];
                 ++optind;
                 break;
+            case 'r':
+                replay_path = optarg;
+                break;
             case 'u':
                 selected_user = atoi(optarg);
                 break;
@@ -322,6 +384,13 @@ int main(int argc, char** argv) {
         Settings::values.current_user = std::clamp(*selected_user, 0, 7);
     }
 
+    if (!replay_path.empty()) {
+        // Replays measure the GPU front-end only, keep host rendering and threading out of it
+        Settings::values.renderer_backend = Settings::RendererBackend::Null;
+        Settings::values.use_asynchronous_gpu_emulation = false;
+        Settings::values.dump_gpu_commands = false;
+    }
+
 #ifdef _WIN32
     LocalFree(argv_w);
 #endif
@@ -333,7 +402,7 @@ int main(int argc, char** argv) {
 
     Common::ConfigureNvidiaEnvironmentFlags();
 
-    if (filepath.empty()) {
+    if (filepath.empty() && replay_path.empty() && list_path.empty()) {
         LOG_CRITICAL(Frontend, "Failed to load ROM: No ROM specified");
         return -1;
     }
@@ -346,6 +415,14 @@ int main(int argc, char** argv) {
     // Apply the command line arguments
     system.ApplySettings();
 
+    system.SetContentProvider(std::make_unique<FileSys::ContentProviderUnion>());
+    system.SetFilesystem(std::make_shared<FileSys::RealVfsFilesystem>());
+    system.GetFileSystemController().CreateFactories(*system.GetFilesystem());
+
+    if (!list_path.empty()) {
+        return ListGames(system, list_path);
+    }
+
     std::unique_ptr<EmuWindow_SDL2> emu_window;
     switch (Settings::values.renderer_backend.GetValue()) {
     case Settings::RendererBackend::OpenGL:
@@ -364,9 +441,10 @@ int main(int argc, char** argv) {
     system.CoreTiming().SetTimerResolutionNs(Common::Windows::GetCurrentTimerResolution());
 #endif
 
-    system.SetContentProvider(std::make_unique<FileSys::ContentProviderUnion>());
-    system.SetFilesystem(std::make_shared<FileSys::RealVfsFilesystem>());
-    system.GetFileSystemController().CreateFactories(*system.GetFilesystem());
+    if (!replay_path.empty()) {
+        return ReplayGPU(system, *emu_window, replay_path);
+    }
+
     system.GetUserChannel().clear();
 
     Service::AM::FrontendAppletParameters load_parameters{